@@ -24,6 +24,9 @@
 #include <config.h>
 #endif
 
+#include <cctype>
+#include <cmath>
+
 #include <o2scl/convert_units.h>
 
 using namespace std;
@@ -35,6 +38,7 @@ convert_units::convert_units() {
   units_cmd_string="units";
   err_on_fail=true;
   combine_two_conv=true;
+  natural_units=false;
 }
 
 double convert_units::convert(std::string from, std::string to,
@@ -60,6 +64,10 @@ double convert_units::convert(std::string from, std::string to,
 int convert_units::convert_ret(std::string from, std::string to, double val,
 			       double &converted) {
 
+  // Keep the original strings for the native parser, since
+  // whitespace denotes multiplication
+  std::string from_expr=from, to_expr=to;
+  
   // Remove whitespace
   remove_whitespace(from);
   remove_whitespace(to);
@@ -80,6 +88,20 @@ int convert_units::convert_ret(std::string from, std::string to, double val,
     return 0;
   }
 
+  // Try the native parser
+  int nret=convert_native(from_expr,to_expr,val,converted);
+  if (nret==0) {
+    if (verbose>0) {
+      std::cout << "convert_units::convert(): "
+		<< "Used native conversion." << std::endl;
+    }
+    return 0;
+  }
+  if (verbose>0) {
+    std::cout << "convert_units::convert(): "
+	      << "Native conversion failed (" << nret << ")." << std::endl;
+  }
+
   if (combine_two_conv) {
     
     // Look for combined conversions
@@ -274,6 +296,533 @@ int convert_units::convert_ret(std::string from, std::string to, double val,
   return exc_enotfound;
 }
 
+/// Add a unit to the table used by the native parser
+static void add_unit(std::map<std::string,convert_units::der_unit> &tab,
+		     std::string name, double val, double m, double kg,
+		     double s, double K=0.0, double A=0.0, double mol=0.0,
+		     double cd=0.0) {
+  convert_units::der_unit d;
+  d.val=val;
+  d.dim[0]=m;
+  d.dim[1]=kg;
+  d.dim[2]=s;
+  d.dim[3]=K;
+  d.dim[4]=A;
+  d.dim[5]=mol;
+  d.dim[6]=cd;
+  tab.insert(make_pair(name,d));
+  return;
+}
+
+/// Construct the table of units used by the native parser
+static std::map<std::string,convert_units::der_unit> make_unit_table() {
+
+  std::map<std::string,convert_units::der_unit> t;
+
+  using namespace o2scl_mks;
+
+  // Computed here rather than taken from o2scl_const so that
+  // the table does not depend on the order of static initialization
+  double pi=acos(-1.0);
+  double hbar=plancks_constant_h/2.0/pi;
+  
+  // SI base units
+  add_unit(t,"m",1.0,1,0,0);
+  add_unit(t,"meter",1.0,1,0,0);
+  add_unit(t,"metre",1.0,1,0,0);
+  add_unit(t,"kg",1.0,0,1,0);
+  add_unit(t,"kilogram",1.0,0,1,0);
+  add_unit(t,"g",1.0e-3,0,1,0);
+  add_unit(t,"gram",1.0e-3,0,1,0);
+  add_unit(t,"s",1.0,0,0,1);
+  add_unit(t,"sec",1.0,0,0,1);
+  add_unit(t,"second",1.0,0,0,1);
+  add_unit(t,"K",1.0,0,0,0,1);
+  add_unit(t,"kelvin",1.0,0,0,0,1);
+  add_unit(t,"A",1.0,0,0,0,0,1);
+  add_unit(t,"amp",1.0,0,0,0,0,1);
+  add_unit(t,"ampere",1.0,0,0,0,0,1);
+  add_unit(t,"mol",1.0,0,0,0,0,0,1);
+  add_unit(t,"mole",1.0,0,0,0,0,0,1);
+  add_unit(t,"cd",1.0,0,0,0,0,0,0,1);
+  add_unit(t,"candela",1.0,0,0,0,0,0,0,1);
+
+  // Angles are dimensionless
+  add_unit(t,"radian",1.0,0,0,0);
+  add_unit(t,"sr",1.0,0,0,0);
+  add_unit(t,"steradian",1.0,0,0,0);
+  add_unit(t,"deg",pi/180.0,0,0,0);
+  add_unit(t,"degree",pi/180.0,0,0,0);
+
+  // Derived SI units
+  add_unit(t,"N",1.0,1,1,-2);
+  add_unit(t,"newton",1.0,1,1,-2);
+  add_unit(t,"Pa",1.0,-1,1,-2);
+  add_unit(t,"pascal",1.0,-1,1,-2);
+  add_unit(t,"J",1.0,2,1,-2);
+  add_unit(t,"joule",1.0,2,1,-2);
+  add_unit(t,"W",1.0,2,1,-3);
+  add_unit(t,"watt",1.0,2,1,-3);
+  add_unit(t,"C",1.0,0,0,1,0,1);
+  add_unit(t,"coulomb",1.0,0,0,1,0,1);
+  add_unit(t,"V",1.0,2,1,-3,0,-1);
+  add_unit(t,"volt",1.0,2,1,-3,0,-1);
+  add_unit(t,"ohm",1.0,2,1,-3,0,-2);
+  add_unit(t,"S",1.0,-2,-1,3,0,2);
+  add_unit(t,"siemens",1.0,-2,-1,3,0,2);
+  add_unit(t,"F",1.0,-2,-1,4,0,2);
+  add_unit(t,"farad",1.0,-2,-1,4,0,2);
+  add_unit(t,"Wb",1.0,2,1,-2,0,-1);
+  add_unit(t,"weber",1.0,2,1,-2,0,-1);
+  add_unit(t,"H",1.0,2,1,-2,0,-2);
+  add_unit(t,"henry",1.0,2,1,-2,0,-2);
+  add_unit(t,"T",1.0,0,1,-2,0,-1);
+  add_unit(t,"tesla",1.0,0,1,-2,0,-1);
+  add_unit(t,"Hz",1.0,0,0,-1);
+  add_unit(t,"hertz",1.0,0,0,-1);
+  add_unit(t,"lm",1.0,0,0,0,0,0,0,1);
+  add_unit(t,"lumen",lumen,0,0,0,0,0,0,1);
+  add_unit(t,"lx",1.0,-2,0,0,0,0,0,1);
+  add_unit(t,"lux",lux,-2,0,0,0,0,0,1);
+
+  // Time
+  add_unit(t,"min",minute,0,0,1);
+  add_unit(t,"minute",minute,0,0,1);
+  add_unit(t,"hr",hour,0,0,1);
+  add_unit(t,"hour",hour,0,0,1);
+  add_unit(t,"day",day,0,0,1);
+  add_unit(t,"week",week,0,0,1);
+  add_unit(t,"yr",365.25*day,0,0,1);
+  add_unit(t,"year",365.25*day,0,0,1);
+
+  // Length
+  add_unit(t,"in",inch,1,0,0);
+  add_unit(t,"inch",inch,1,0,0);
+  add_unit(t,"ft",foot,1,0,0);
+  add_unit(t,"foot",foot,1,0,0);
+  add_unit(t,"feet",foot,1,0,0);
+  add_unit(t,"yd",yard,1,0,0);
+  add_unit(t,"yard",yard,1,0,0);
+  add_unit(t,"mi",mile,1,0,0);
+  add_unit(t,"mile",mile,1,0,0);
+  add_unit(t,"nautical_mile",nautical_mile,1,0,0);
+  add_unit(t,"fathom",fathom,1,0,0);
+  add_unit(t,"mil",mil,1,0,0);
+  add_unit(t,"point",point,1,0,0);
+  add_unit(t,"texpoint",texpoint,1,0,0);
+  add_unit(t,"micron",micron,1,0,0);
+  add_unit(t,"angstrom",angstrom,1,0,0);
+  add_unit(t,"au",astronomical_unit,1,0,0);
+  add_unit(t,"AU",astronomical_unit,1,0,0);
+  add_unit(t,"astronomical_unit",astronomical_unit,1,0,0);
+  add_unit(t,"ly",light_year,1,0,0);
+  add_unit(t,"lyr",light_year,1,0,0);
+  add_unit(t,"light_year",light_year,1,0,0);
+  add_unit(t,"pc",parsec,1,0,0);
+  add_unit(t,"parsec",parsec,1,0,0);
+  add_unit(t,"bohr_radius",bohr_radius,1,0,0);
+  add_unit(t,"schwarzchild_radius",schwarzchild_radius,1,0,0);
+  add_unit(t,"Rschwarz",schwarzchild_radius,1,0,0);
+
+  // Area and volume
+  add_unit(t,"hectare",hectare,2,0,0);
+  add_unit(t,"acre",acre,2,0,0);
+  add_unit(t,"barn",barn,2,0,0);
+  add_unit(t,"L",liter,3,0,0);
+  add_unit(t,"liter",liter,3,0,0);
+  add_unit(t,"litre",liter,3,0,0);
+  add_unit(t,"us_gallon",us_gallon,3,0,0);
+  add_unit(t,"gallon",us_gallon,3,0,0);
+  add_unit(t,"quart",quart,3,0,0);
+  add_unit(t,"pint",pint,3,0,0);
+  add_unit(t,"cup",cup,3,0,0);
+  add_unit(t,"fluid_ounce",fluid_ounce,3,0,0);
+  add_unit(t,"tablespoon",tablespoon,3,0,0);
+  add_unit(t,"teaspoon",teaspoon,3,0,0);
+  add_unit(t,"canadian_gallon",canadian_gallon,3,0,0);
+  add_unit(t,"uk_gallon",uk_gallon,3,0,0);
+
+  // Speed
+  add_unit(t,"mph",miles_per_hour,1,0,-1);
+  add_unit(t,"miles_per_hour",miles_per_hour,1,0,-1);
+  add_unit(t,"kph",kilometers_per_hour,1,0,-1);
+  add_unit(t,"kilometers_per_hour",kilometers_per_hour,1,0,-1);
+  add_unit(t,"knot",knot,1,0,-1);
+
+  // Mass
+  add_unit(t,"lb",pound_mass,0,1,0);
+  add_unit(t,"pound_mass",pound_mass,0,1,0);
+  add_unit(t,"oz",ounce_mass,0,1,0);
+  add_unit(t,"ounce_mass",ounce_mass,0,1,0);
+  add_unit(t,"ton",ton,0,1,0);
+  add_unit(t,"metric_ton",metric_ton,0,1,0);
+  add_unit(t,"tonne",metric_ton,0,1,0);
+  add_unit(t,"uk_ton",uk_ton,0,1,0);
+  add_unit(t,"troy_ounce",troy_ounce,0,1,0);
+  add_unit(t,"carat",carat,0,1,0);
+  add_unit(t,"amu",unified_atomic_mass,0,1,0);
+  add_unit(t,"unified_atomic_mass",unified_atomic_mass,0,1,0);
+  add_unit(t,"Msun",solar_mass,0,1,0);
+  add_unit(t,"solar_mass",solar_mass,0,1,0);
+  add_unit(t,"mass_electron",mass_electron,0,1,0);
+  add_unit(t,"mass_muon",mass_muon,0,1,0);
+  add_unit(t,"mass_proton",mass_proton,0,1,0);
+  add_unit(t,"mass_neutron",mass_neutron,0,1,0);
+
+  // Force, energy, power, and pressure
+  add_unit(t,"dyne",dyne,1,1,-2);
+  add_unit(t,"dyn",dyne,1,1,-2);
+  add_unit(t,"gram_force",gram_force,1,1,-2);
+  add_unit(t,"lbf",pound_force,1,1,-2);
+  add_unit(t,"pound_force",pound_force,1,1,-2);
+  add_unit(t,"kilopound_force",kilopound_force,1,1,-2);
+  add_unit(t,"poundal",poundal,1,1,-2);
+  add_unit(t,"erg",erg,2,1,-2);
+  add_unit(t,"eV",electron_volt,2,1,-2);
+  add_unit(t,"electron_volt",electron_volt,2,1,-2);
+  add_unit(t,"cal",calorie,2,1,-2);
+  add_unit(t,"calorie",calorie,2,1,-2);
+  add_unit(t,"btu",btu,2,1,-2);
+  add_unit(t,"therm",therm,2,1,-2);
+  add_unit(t,"rydberg",rydberg,2,1,-2);
+  add_unit(t,"hp",horsepower,2,1,-3);
+  add_unit(t,"horsepower",horsepower,2,1,-3);
+  add_unit(t,"bar",bar,-1,1,-2);
+  add_unit(t,"atm",std_atmosphere,-1,1,-2);
+  add_unit(t,"std_atmosphere",std_atmosphere,-1,1,-2);
+  add_unit(t,"torr",torr,-1,1,-2);
+  add_unit(t,"meter_of_mercury",meter_of_mercury,-1,1,-2);
+  add_unit(t,"inch_of_mercury",inch_of_mercury,-1,1,-2);
+  add_unit(t,"inch_of_water",inch_of_water,-1,1,-2);
+  add_unit(t,"psi",psi,-1,1,-2);
+  add_unit(t,"poise",poise,-1,1,-1);
+  add_unit(t,"stokes",stokes,2,0,-1);
+
+  // Electromagnetism, radioactivity, and light
+  add_unit(t,"gauss",gauss,0,1,-2,0,-1);
+  add_unit(t,"faraday",faraday,0,0,1,0,1,-1);
+  add_unit(t,"electron_charge",electron_charge,0,0,1,0,1);
+  add_unit(t,"bohr_magneton",bohr_magneton,2,0,0,0,1);
+  add_unit(t,"nuclear_magneton",nuclear_magneton,2,0,0,0,1);
+  add_unit(t,"vacuum_permittivity",vacuum_permittivity,-3,-1,4,0,2);
+  add_unit(t,"vacuum_permeability",vacuum_permeability,1,1,-2,0,-2);
+  add_unit(t,"Ci",curie,0,0,-1);
+  add_unit(t,"curie",curie,0,0,-1);
+  add_unit(t,"roentgen",roentgen,0,-1,1,0,1);
+  add_unit(t,"stilb",stilb,-2,0,0,0,0,0,1);
+  add_unit(t,"phot",phot,-2,0,0,0,0,0,1);
+  add_unit(t,"footcandle",footcandle,-2,0,0,0,0,0,1);
+  add_unit(t,"lambert",lambert,-2,0,0,0,0,0,1);
+  add_unit(t,"footlambert",footlambert,-2,0,0,0,0,0,1);
+
+  // Physical constants
+  add_unit(t,"c",speed_of_light,1,0,-1);
+  add_unit(t,"speed_of_light",speed_of_light,1,0,-1);
+  add_unit(t,"G",gravitational_constant,3,-1,-2);
+  add_unit(t,"gravitational_constant",gravitational_constant,3,-1,-2);
+  add_unit(t,"h",plancks_constant_h,2,1,-1);
+  add_unit(t,"plancks_constant_h",plancks_constant_h,2,1,-1);
+  add_unit(t,"hbar",hbar,2,1,-1);
+  add_unit(t,"plancks_constant_hbar",hbar,2,1,-1);
+  add_unit(t,"kB",boltzmann,2,1,-2,-1);
+  add_unit(t,"boltzmann",boltzmann,2,1,-2,-1);
+  add_unit(t,"grav_accel",grav_accel,1,0,-2);
+  add_unit(t,"molar_gas",molar_gas,2,1,-2,-1,0,-1);
+  add_unit(t,"standard_gas_volume",standard_gas_volume,3,0,0,0,0,-1);
+  add_unit(t,"avogadro",o2scl_const::avogadro,0,0,0,0,0,-1);
+  add_unit(t,"stefan_boltzmann_constant",stefan_boltzmann_constant,
+	   0,1,-3,-4);
+  add_unit(t,"thomson_cross_section",thomson_cross_section,2,0,0);
+  
+  return t;
+}
+
+/// A unit prefix
+typedef struct {
+  /// The prefix
+  const char *name;
+  /// The corresponding factor
+  double val;
+} unit_prefix;
+
+/// SI prefixes, full names before abbreviations
+static const unit_prefix prefix_list[]={
+  {"yotta",o2scl_const::yotta},{"zetta",o2scl_const::zetta},
+  {"exa",o2scl_const::exa},{"peta",o2scl_const::peta},
+  {"tera",o2scl_const::tera},{"giga",o2scl_const::giga},
+  {"mega",o2scl_const::mega},{"kilo",o2scl_const::kilo},
+  {"hecto",1.0e2},{"deka",1.0e1},{"deca",1.0e1},
+  {"deci",1.0e-1},{"centi",1.0e-2},
+  {"milli",o2scl_const::milli},{"micro",o2scl_const::micro},
+  {"nano",o2scl_const::nano},{"pico",o2scl_const::pico},
+  {"femto",o2scl_const::femto},{"atto",o2scl_const::atto},
+  {"zepto",o2scl_const::zepto},{"yocto",o2scl_const::yocto},
+  {"da",1.0e1},
+  {"Y",o2scl_const::yotta},{"Z",o2scl_const::zetta},
+  {"E",o2scl_const::exa},{"P",o2scl_const::peta},
+  {"T",o2scl_const::tera},{"G",o2scl_const::giga},
+  {"M",o2scl_const::mega},{"k",o2scl_const::kilo},
+  {"h",1.0e2},{"d",1.0e-1},{"c",1.0e-2},
+  {"m",o2scl_const::milli},{"u",o2scl_const::micro},
+  {"n",o2scl_const::nano},{"p",o2scl_const::pico},
+  {"f",o2scl_const::femto},{"a",o2scl_const::atto},
+  {"z",o2scl_const::zepto},{"y",o2scl_const::yocto}
+};
+
+const convert_units::unit_table_t &convert_units::unit_table() {
+  static const unit_table_t tab=make_unit_table();
+  return tab;
+}
+
+int convert_units::lookup_unit(const std::string &name, der_unit &d) const {
+
+  const unit_table_t &tab=unit_table();
+
+  // Exact match
+  unit_table_t::const_iterator it=tab.find(name);
+  if (it!=tab.end()) {
+    d=it->second;
+    return 0;
+  }
+
+  // A prefix followed by a unit name
+  size_t np=sizeof(prefix_list)/sizeof(unit_prefix);
+  for(size_t i=0;i<np;i++) {
+    std::string pre=prefix_list[i].name;
+    if (name.length()>pre.length() && name.compare(0,pre.length(),pre)==0) {
+      it=tab.find(name.substr(pre.length()));
+      if (it!=tab.end()) {
+	d=it->second;
+	d.val*=prefix_list[i].val;
+	return 0;
+      }
+    }
+  }
+
+  size_t len=name.length();
+  
+  // A unit followed by a single-digit exponent, e.g. "cm3"
+  if (len>1 && name[len-1]>='2' && name[len-1]<='9' &&
+      !isdigit(name[len-2])) {
+    if (lookup_unit(name.substr(0,len-1),d)==0) {
+      double p=name[len-1]-'0';
+      d.val=pow(d.val,p);
+      for(size_t k=0;k<7;k++) d.dim[k]*=p;
+      return 0;
+    }
+  }
+
+  // Plurals
+  if (len>3 && name[len-1]=='s') {
+    if (lookup_unit(name.substr(0,len-1),d)==0) return 0;
+    if (len>4 && name[len-2]=='e' &&
+	lookup_unit(name.substr(0,len-2),d)==0) return 0;
+  }
+  
+  return exc_enotfound;
+}
+
+int convert_units::parse_primary(const std::string &s, size_t &ix,
+				 der_unit &d) const {
+
+  while (ix<s.length() && isspace(s[ix])) ix++;
+  if (ix>=s.length()) return exc_efailed;
+
+  char c=s[ix];
+
+  // Parenthesized expression
+  if (c=='(') {
+    ix++;
+    int ret=parse_expr(s,ix,d);
+    if (ret!=0) return ret;
+    while (ix<s.length() && isspace(s[ix])) ix++;
+    if (ix>=s.length() || s[ix]!=')') return exc_efailed;
+    ix++;
+    return 0;
+  }
+
+  // Number
+  if (isdigit(c) || c=='.') {
+    const char *start=s.c_str()+ix;
+    char *end;
+    double x=strtod(start,&end);
+    if (end==start) return exc_efailed;
+    ix+=end-start;
+    d.val=x;
+    for(size_t k=0;k<7;k++) d.dim[k]=0.0;
+    return 0;
+  }
+
+  // Unit name
+  if (isalpha(c) || c=='_') {
+    size_t i0=ix;
+    while (ix<s.length() && (isalnum(s[ix]) || s[ix]=='_')) ix++;
+    return lookup_unit(s.substr(i0,ix-i0),d);
+  }
+
+  return exc_efailed;
+}
+
+int convert_units::parse_factor(const std::string &s, size_t &ix,
+				der_unit &d) const {
+
+  int ret=parse_primary(s,ix,d);
+  if (ret!=0) return ret;
+  
+  while (ix<s.length() && isspace(s[ix])) ix++;
+  if (ix>=s.length()) return 0;
+  
+  if (s[ix]=='^') {
+    ix++;
+  } else if (s[ix]=='*' && ix+1<s.length() && s[ix+1]=='*') {
+    ix+=2;
+  } else {
+    return 0;
+  }
+  while (ix<s.length() && isspace(s[ix])) ix++;
+
+  // Exponents can be a signed number or a ratio of two numbers
+  // in parentheses
+  bool paren=false;
+  if (ix<s.length() && s[ix]=='(') {
+    paren=true;
+    ix++;
+  }
+  const char *start=s.c_str()+ix;
+  char *end;
+  double p=strtod(start,&end);
+  if (end==start) return exc_efailed;
+  ix+=end-start;
+  if (paren) {
+    while (ix<s.length() && isspace(s[ix])) ix++;
+    if (ix<s.length() && s[ix]=='/') {
+      ix++;
+      start=s.c_str()+ix;
+      double q=strtod(start,&end);
+      if (end==start || q==0.0) return exc_efailed;
+      ix+=end-start;
+      p/=q;
+    }
+    while (ix<s.length() && isspace(s[ix])) ix++;
+    if (ix>=s.length() || s[ix]!=')') return exc_efailed;
+    ix++;
+  }
+
+  d.val=pow(d.val,p);
+  for(size_t k=0;k<7;k++) d.dim[k]*=p;
+  return 0;
+}
+
+int convert_units::parse_product(const std::string &s, size_t &ix,
+				 der_unit &d) const {
+
+  int ret=parse_factor(s,ix,d);
+  if (ret!=0) return ret;
+
+  while (true) {
+    while (ix<s.length() && isspace(s[ix])) ix++;
+    if (ix>=s.length()) return 0;
+    char c=s[ix];
+    if (!isalnum(c) && c!='_' && c!='.' && c!='(') return 0;
+    der_unit d2;
+    ret=parse_factor(s,ix,d2);
+    if (ret!=0) return ret;
+    d.val*=d2.val;
+    for(size_t k=0;k<7;k++) d.dim[k]+=d2.dim[k];
+  }
+
+  return 0;
+}
+
+int convert_units::parse_expr(const std::string &s, size_t &ix,
+			      der_unit &d) const {
+
+  while (ix<s.length() && isspace(s[ix])) ix++;
+
+  // Allow a leading slash, e.g. "/s" for "1/s"
+  int ret;
+  if (ix<s.length() && s[ix]=='/') {
+    d.val=1.0;
+    for(size_t k=0;k<7;k++) d.dim[k]=0.0;
+  } else {
+    ret=parse_product(s,ix,d);
+    if (ret!=0) return ret;
+  }
+
+  while (true) {
+    while (ix<s.length() && isspace(s[ix])) ix++;
+    if (ix>=s.length() || (s[ix]!='*' && s[ix]!='/')) return 0;
+    bool divide=(s[ix]=='/');
+    ix++;
+    der_unit d2;
+    ret=parse_product(s,ix,d2);
+    if (ret!=0) return ret;
+    if (divide) {
+      d.val/=d2.val;
+      for(size_t k=0;k<7;k++) d.dim[k]-=d2.dim[k];
+    } else {
+      d.val*=d2.val;
+      for(size_t k=0;k<7;k++) d.dim[k]+=d2.dim[k];
+    }
+  }
+
+  return 0;
+}
+
+int convert_units::parse_unit(std::string s, der_unit &d) const {
+  size_t ix=0;
+  int ret=parse_expr(s,ix,d);
+  if (ret!=0) return ret;
+  while (ix<s.length() && isspace(s[ix])) ix++;
+  if (ix!=s.length()) return exc_efailed;
+  return 0;
+}
+
+int convert_units::convert_native(std::string from, std::string to,
+				  double val, double &converted) const {
+
+  der_unit df, dt;
+  int ret=parse_unit(from,df);
+  if (ret!=0) return ret;
+  ret=parse_unit(to,dt);
+  if (ret!=0) return ret;
+
+  double diff[7];
+  bool same=true;
+  for(size_t k=0;k<7;k++) {
+    diff[k]=df.dim[k]-dt.dim[k];
+    if (fabs(diff[k])>1.0e-10) same=false;
+  }
+  if (same) {
+    converted=val*df.val/dt.val;
+    return 0;
+  }
+
+  if (natural_units) {
+
+    // Find the powers a, b, and e so that the two units differ by
+    // c^a hbar^b kB^e. The current, amount, and luminous
+    // intensity must match.
+    if (fabs(diff[4])>1.0e-10 || fabs(diff[5])>1.0e-10 ||
+	fabs(diff[6])>1.0e-10) {
+      return exc_einval;
+    }
+    double e=-diff[3];
+    double b=diff[1]-e;
+    double a=diff[0]-2.0*b-2.0*e;
+    if (fabs(-a-b-2.0*e-diff[2])>1.0e-10) return exc_einval;
+
+    const der_unit &c=unit_table().find("c")->second;
+    const der_unit &hbar=unit_table().find("hbar")->second;
+    const der_unit &kB=unit_table().find("kB")->second;
+    converted=val*df.val/dt.val/pow(c.val,a)/pow(hbar.val,b)/
+      pow(kB.val,e);
+    return 0;
+  }
+  
+  return exc_einval;
+}
+
 void convert_units::remove_cache(std::string from, std::string to) {
 
   // Remove whitespace
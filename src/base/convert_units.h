@@ -47,14 +47,32 @@ namespace o2scl {
       automatically combine two conversion factors to create a new
       unit conversion (but it cannot combine more than two).
 
-      Conversions are performed by the \ref convert() function and the
-      conversion factors must be specified beforehand using the \ref
-      insert_cache() function.
-
-      If the GNU units command is not in the local path, the user may
-      modify \ref units_cmd_string to specify the full pathname. One
-      can also modify \ref units_cmd_string to specify a different
-      <tt>units.dat</tt> file.
+      Conversions are performed by the \ref convert() function. The
+      class first looks for the conversion (or its inverse) in the
+      cache, which can be modified using \ref insert_cache(). If it is
+      not found there, the two unit expressions are parsed by \ref
+      parse_unit() and, if they have the same dimension, the
+      conversion factor is computed directly. This native parser
+      knows the SI base units, the SI prefixes, and the units and
+      constants in \ref o2scl_mks . Unit expressions are written as in
+      GNU units, e.g. <tt>"kg m / s^2"</tt>, <tt>"1/fm^4"</tt>, or
+      <tt>"Msun/km^3"</tt>. Multiplication by juxtaposition binds more
+      tightly than <tt>*</tt> and <tt>/</tt>, so <tt>"m^3 / kg s^2"</tt>
+      is \f$ \mathrm{m}^3 / (\mathrm{kg}~\mathrm{s}^2) \f$ .
+      Conversions computed this way are not stored in the cache, so
+      that the native conversion does not modify the object and
+      can be used simultaneously from several threads. If \ref
+      natural_units is true, then the native parser also allows
+      conversions which differ in dimension by powers of \f$ c \f$, 
+      \f$ \hbar \f$, and \f$ k_B \f$.
+
+      If the native parser does not recognize one of the units
+      and \ref use_gnu_units is true, the conversion is
+      computed by the GNU units command and then stored in the
+      cache. If the GNU units command is not in the local path, the
+      user may modify \ref units_cmd_string to specify the full
+      pathname. One can also modify \ref units_cmd_string to specify
+      a different <tt>units.dat</tt> file.
 
       \future A remove_cache() and in_cache() function to test
       to see if a conversion is currently in the cache. 
@@ -81,9 +99,6 @@ namespace o2scl {
       Alternatively, one can ensure that no combination is necessary
       by manually adding the desired combination conversion to the
       cache after it is first computed.
-
-      \future Ideally, a real C++ API for the GNU units command
-      would be better.
   */
   class convert_units {
 
@@ -107,6 +122,49 @@ namespace o2scl {
     /// The iterator type
     typedef std::map<std::string,unit_t,std::greater<std::string> >::iterator miter;
       
+#endif
+
+  public:
+
+    /** \brief A unit expressed in terms of the SI base units
+     */
+    typedef struct {
+      /// The value in SI units
+      double val;
+      /// The powers of m, kg, s, K, A, mol, and cd (in that order)
+      double dim[7];
+    } der_unit;
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The type for the table of known units
+    typedef std::map<std::string,der_unit> unit_table_t;
+
+    /** \brief Return the table of units known to the native parser
+
+        The table is constructed on the first call (after all of the
+        physical constants have been initialized) and is shared by
+        all objects of this type.
+    */
+    static const unit_table_t &unit_table();
+
+    /// Look up a unit name, including SI prefixes
+    int lookup_unit(const std::string &name, der_unit &d) const;
+
+    /// Parse a sum of products and quotients in \c s beginning at \c ix
+    int parse_expr(const std::string &s, size_t &ix, der_unit &d) const;
+
+    /// Parse a product of factors separated by whitespace
+    int parse_product(const std::string &s, size_t &ix, der_unit &d) const;
+
+    /// Parse a single factor with an optional exponent
+    int parse_factor(const std::string &s, size_t &ix, der_unit &d) const;
+
+    /// Parse a number, a unit name, or a parenthesized expression
+    int parse_primary(const std::string &s, size_t &ix, der_unit &d) const;
+
 #endif
 
   public:
@@ -130,6 +188,12 @@ namespace o2scl {
     /// Command string to call units (default "units")
     std::string units_cmd_string;
 
+    /** \brief If true, allow the native parser to use \f$ c \f$, 
+	\f$ \hbar \f$, and \f$ k_B \f$ to convert between units of
+	different dimension (default false)
+    */
+    bool natural_units;
+
     convert_units();
 
     virtual ~convert_units() {}
@@ -145,6 +209,27 @@ namespace o2scl {
     virtual int convert_ret(std::string from, std::string to, double val,
 			    double &converted);
 
+    /** \brief Parse the unit expression \c s into its value
+	and dimension in SI units
+
+	This function returns \ref exc_enotfound if a unit is unknown
+	and \ref exc_efailed if the expression cannot be parsed. It
+	does not call the error handler.
+    */
+    int parse_unit(std::string s, der_unit &d) const;
+
+    /** \brief Convert \c val from \c from to \c to using only
+	the native parser
+
+	This function does not use or modify the cache and does not
+	call the error handler. It returns \ref exc_enotfound if one
+	of the units is unknown, \ref exc_efailed if one of the
+	expressions cannot be parsed, and \ref exc_einval if the two
+	units have incompatible dimensions.
+    */
+    int convert_native(std::string from, std::string to, double val,
+		       double &converted) const;
+
     /// Manually insert a unit conversion into the cache
     void insert_cache(std::string from, std::string to, double conv);
 
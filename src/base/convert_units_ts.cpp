@@ -131,6 +131,57 @@ int main(void) {
     t.test_rel(res,1.0/(12.0*2.540),1.0e-10,"1");
   }
 
+  // Native parser
+  {
+    convert_units cu;
+    cu.use_gnu_units=false;
+    
+    t.test_rel(cu.convert("ft","cm",1.0),12.0*2.54,1.0e-14,"native 1");
+    t.test_rel(cu.convert("kg m / s^2","dyne",1.0),1.0e5,1.0e-14,
+	       "native 2");
+    t.test_rel(cu.convert("Pa","erg/cm^3",1.0),10.0,1.0e-14,"native 3");
+    t.test_rel(cu.convert("MeV/fm^3","erg/cm^3",1.0),
+	       o2scl_cgs::electron_volt*1.0e45,1.0e-14,"native 4");
+    t.test_rel(cu.convert("km^2","m2",1.0),1.0e6,1.0e-14,"native 5");
+    t.test_rel(cu.convert("1/fm^3","cm^(-3)",1.0),1.0e39,1.0e-14,
+	       "native 6");
+    t.test_rel(cu.convert("kilometers","meters",2.0),2.0e3,1.0e-14,
+	       "native 7");
+    t.test_rel(cu.convert("GeV","keV",1.0),1.0e6,1.0e-14,"native 8");
+
+    // Check the dimensions of a compound expression
+    convert_units::der_unit du;
+    int ret=cu.parse_unit("m^3 / kg s^2",du);
+    t.test_gen(ret==0,"parse 1");
+    t.test_gen(du.dim[0]==3.0 && du.dim[1]==-1.0 && du.dim[2]==-2.0,
+	       "parse 2");
+    ret=cu.parse_unit("(kg m^2/s^2)/K",du);
+    t.test_gen(ret==0 && du.dim[3]==-1.0 && du.dim[1]==1.0,"parse 3");
+    
+    // Failures do not call the error handler in convert_native()
+    double res;
+    t.test_gen(cu.convert_native("m","kg",1.0,res)==exc_einval,
+	       "native fail 1");
+    t.test_gen(cu.convert_native("m","notaunit",1.0,res)==exc_enotfound,
+	       "native fail 2");
+    t.test_gen(cu.convert_native("m^","m",1.0,res)==exc_efailed,
+	       "native fail 3");
+
+    // Natural units
+    cu.natural_units=true;
+    t.test_rel(cu.convert("kg","1/fm",1.0),
+	       1.0e-15/o2scl_mks::plancks_constant_hbar*
+	       o2scl_mks::speed_of_light,1.0e-14,"natural 1");
+    t.test_rel(cu.convert("1/fm","MeV",1.0),197.3269718,1.0e-8,
+	       "natural 2");
+    t.test_rel(cu.convert("K","eV",1.0),o2scl_mks::boltzmann/
+	       o2scl_mks::electron_volt,1.0e-14,"natural 3");
+    t.test_rel(cu.convert("MeV/fm^3","Msun/km^3",1.0),
+	       o2scl_mks::electron_volt*1.0e51/o2scl_mks::speed_of_light/
+	       o2scl_mks::speed_of_light/o2scl_mks::solar_mass*1.0e9,
+	       1.0e-14,"natural 4");
+  }
+
   t.report();
   return 0;
 }
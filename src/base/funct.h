@@ -43,6 +43,14 @@ namespace o2scl {
   /// One-dimensional function typedef
   typedef std::function<double(double)> funct;
 
+  /** \brief Batched one-dimensional function typedef
+
+      A function of this type evaluates the function at \c n
+      points given in the first array and stores the results in the
+      second array. It should return zero on success.
+  */
+  typedef std::function<int(size_t,const double *,double *)> funct_batch;
+
   /** \brief One-dimensional function from a string
       
       For example,
@@ -142,6 +142,116 @@ namespace o2scl {
       
       return (b-a)*(ai+bterm+cterm+dterm);
     }
+
+    /** \brief Find the intervals containing the \c n points in 
+	\c x0 and store them in \c index
+
+	Starting from the interval given in \c cache, this walks
+	through at most \ref walk_max neighboring intervals before
+	falling back on the binary search in \ref svx. For sorted or
+	nearly sorted points, the cost per point is thus independent
+	of the size of the vector. The index of the last interval is
+	stored in \c cache on exit so that the walk can be continued
+	by the next block.
+    */
+    void find_block(size_t n, const double *x0, size_t *index,
+		    size_t &cache) const {
+      
+      const vec_t &x=*(this->px);
+      size_t c=cache;
+      if (c+2>sz) c=0;
+      
+      if (x[0]<x[sz-1]) {
+	for(size_t i=0;i<n;i++) {
+	  double xi=x0[i];
+	  size_t steps=0;
+	  while (c+2<sz && xi>=x[c+1] && steps<walk_max) {
+	    c++;
+	    steps++;
+	  }
+	  while (c>0 && xi<x[c] && steps<walk_max) {
+	    c--;
+	    steps++;
+	  }
+	  if (steps==walk_max) c=svx.find_inc_const(xi,c);
+	  index[i]=c;
+	}
+      } else {
+	for(size_t i=0;i<n;i++) {
+	  double xi=x0[i];
+	  size_t steps=0;
+	  while (c+2<sz && xi<=x[c+1] && steps<walk_max) {
+	    c++;
+	    steps++;
+	  }
+	  while (c>0 && xi>x[c] && steps<walk_max) {
+	    c--;
+	    steps++;
+	  }
+	  if (steps==walk_max) c=svx.find_dec_const(xi,c);
+	  index[i]=c;
+	}
+      }
+      
+      cache=c;
+      return;
+    }
+
+    /** \brief Evaluate the function (\c nderiv=0), or its first
+	(\c nderiv=1) or second (\c nderiv=2) derivative at the \c n
+	points in \c x0 given the intervals in \c index
+
+	The children with a searchable abcissa overload this function
+	with a kernel which only depends on the precomputed interval
+	coefficients. The default version ignores \c index and calls
+	eval(), deriv(), or deriv2() for each point.
+    */
+    virtual void eval_index(size_t n, const double *x0, const size_t *index,
+			    double *y0, size_t nderiv) const {
+      if (nderiv==0) {
+	for(size_t i=0;i<n;i++) y0[i]=eval(x0[i]);
+      } else if (nderiv==1) {
+	for(size_t i=0;i<n;i++) y0[i]=deriv(x0[i]);
+      } else {
+	for(size_t i=0;i<n;i++) y0[i]=deriv2(x0[i]);
+      }
+      return;
+    }
+
+    /** \brief Evaluate a block of points by finding the intervals
+	with \ref find_block() and then calling \ref eval_index()
+
+	This is used by the children to implement \ref eval_block().
+    */
+    void eval_block_search(size_t n, const double *x0, double *y0,
+			   size_t nderiv, size_t &cache) const {
+      size_t index[block_size];
+      for(size_t j=0;j<n;j+=block_size) {
+	size_t m=n-j;
+	if (m>block_size) m=block_size;
+	find_block(m,x0+j,index,cache);
+	eval_index(m,x0+j,index,y0+j,nderiv);
+      }
+      return;
+    }
+
+    /** \brief Copy the points to a contiguous buffer and call
+	\ref eval_block() for each block
+    */
+    template<class vec3_t, class vec4_t>
+      void eval_many_nderiv(size_t n, const vec3_t &x0, vec4_t &y0,
+			    size_t nderiv) const {
+      double xb[block_size], yb[block_size];
+      size_t cache=0;
+      for(size_t j=0;j<n;j+=block_size) {
+	size_t m=n-j;
+	if (m>block_size) m=block_size;
+	for(size_t k=0;k<m;k++) xb[k]=x0[j+k];
+	eval_block(m,xb,yb,nderiv,cache);
+	for(size_t k=0;k<m;k++) y0[j+k]=yb[k];
+      }
+      return;
+    }
     
 #endif
     
@@ -185,6 +295,80 @@ namespace o2scl {
 
     /// Return the type
     virtual const char *type() const=0;
+
+    /// \name Evaluation at several points
+    //@{
+    /** \brief The number of points processed at a time by 
+	the functions which evaluate several points (64)
+    */
+    static const size_t block_size=64;
+
+    /** \brief The maximum number of neighboring intervals 
+	searched before using a binary search (8)
+    */
+    static const size_t walk_max=8;
+
+    /** \brief Evaluate the function (\c nderiv=0), or its first
+	(\c nderiv=1) or second (\c nderiv=2) derivative at the \c n
+	points in the C-style array \c x0, storing the results 
+	in \c y0
+
+	The search for the interval containing each point starts from
+	the interval given in \c cache, which is updated on exit.
+	This is the low-level function used by \ref eval_many(), 
+	\ref deriv_many(), and \ref deriv2_many(). The default
+	version calls eval(), deriv(), or deriv2() for each point.
+    */
+    virtual void eval_block(size_t n, const double *x0, double *y0,
+			    size_t nderiv, size_t &cache) const {
+      eval_index(n,x0,0,y0,nderiv);
+      return;
+    }
+    
+    /** \brief Give the values of the function at the \c n 
+	points in \c x0 and store them in \c y0
+	
+	The interval search is continued from one point to the next,
+	so this is fastest when the points in \c x0 are sorted or
+	nearly sorted, but the points may be in any order.
+    */
+    template<class vec3_t, class vec4_t>
+      void eval_many(size_t n, const vec3_t &x0, vec4_t &y0) const {
+      eval_many_nderiv(n,x0,y0,0);
+      return;
+    }
+
+    /** \brief Give the values of the derivative at the \c n 
+	points in \c x0 and store them in \c y0
+    */
+    template<class vec3_t, class vec4_t>
+      void deriv_many(size_t n, const vec3_t &x0, vec4_t &y0) const {
+      eval_many_nderiv(n,x0,y0,1);
+      return;
+    }
+
+    /** \brief Give the values of the second derivative at the \c n 
+	points in \c x0 and store them in \c y0
+    */
+    template<class vec3_t, class vec4_t>
+      void deriv2_many(size_t n, const vec3_t &x0, vec4_t &y0) const {
+      eval_many_nderiv(n,x0,y0,2);
+      return;
+    }
+
+    /** \brief Give the values of the integrals from 
+	<tt>a[i]</tt> to <tt>b[i]</tt> for the \c n intervals
+	and store them in \c res
+    */
+    template<class vec3_t, class vec4_t, class vec5_t>
+      void integ_many(size_t n, const vec3_t &a, const vec4_t &b,
+		      vec5_t &res) const {
+      for(size_t i=0;i<n;i++) {
+	res[i]=integ(a[i],b[i]);
+      }
+      return;
+    }
+    //@}
  
 #ifndef DOXYGEN_INTERNAL
 
@@ -325,8 +509,40 @@ namespace o2scl {
     /// Return the type, \c "interp_linear".
     virtual const char *type() const { return "interp_linear"; }
 
+    /** \brief Evaluate the function or its derivatives at a 
+	block of points (see \ref interp_base::eval_block())
+    */
+    virtual void eval_block(size_t n, const double *x0, double *y0,
+			    size_t nderiv, size_t &cache) const {
+      this->eval_block_search(n,x0,y0,nderiv,cache);
+      return;
+    }
+
 #ifndef DOXYGEN_INTERNAL
 
+  protected:
+
+    /// Evaluate a block of points with known intervals
+    virtual void eval_index(size_t n, const double *x0, const size_t *index,
+			    double *y0, size_t nderiv) const {
+      const vec_t &x=*(this->px);
+      const vec2_t &y=*(this->py);
+      if (nderiv==0) {
+	for(size_t i=0;i<n;i++) {
+	  size_t j=index[i];
+	  y0[i]=y[j]+(x0[i]-x[j])/(x[j+1]-x[j])*(y[j+1]-y[j]);
+	}
+      } else if (nderiv==1) {
+	for(size_t i=0;i<n;i++) {
+	  size_t j=index[i];
+	  y0[i]=(y[j+1]-y[j])/(x[j+1]-x[j]);
+	}
+      } else {
+	for(size_t i=0;i<n;i++) y0[i]=0.0;
+      }
+      return;
+    }
+
   private:
 
     interp_linear<vec_t,vec2_t>(const interp_linear<vec_t,vec2_t> &);
@@ -586,8 +802,41 @@ namespace o2scl {
     /// Return the type, \c "interp_cspline".
     virtual const char *type() const { return "interp_cspline"; }
 
+    /** \brief Evaluate the function or its derivatives at a 
+	block of points (see \ref interp_base::eval_block())
+    */
+    virtual void eval_block(size_t n, const double *x0, double *y0,
+			    size_t nderiv, size_t &cache) const {
+      this->eval_block_search(n,x0,y0,nderiv,cache);
+      return;
+    }
+
 #ifndef DOXYGEN_INTERNAL
 
+  protected:
+
+    /// Evaluate a block of points with known intervals
+    virtual void eval_index(size_t n, const double *x0, const size_t *index,
+			    double *y0, size_t nderiv) const {
+      const vec_t &x=*(this->px);
+      const vec2_t &y=*(this->py);
+      for(size_t i=0;i<n;i++) {
+	size_t j=index[i];
+	double dx=x[j+1]-x[j];
+	double delx=x0[i]-x[j];
+	double b_i, c_i, d_i;
+	coeff_calc(c,y[j+1]-y[j],dx,j,b_i,c_i,d_i);
+	if (nderiv==0) {
+	  y0[i]=y[j]+delx*(b_i+delx*(c_i+delx*d_i));
+	} else if (nderiv==1) {
+	  y0[i]=b_i+delx*(2.0*c_i+3.0*d_i*delx);
+	} else {
+	  y0[i]=2.0*c_i+6.0*d_i*delx;
+	}
+      }
+      return;
+    }
+
   private:
   
   interp_cspline<vec_t,vec2_t>(const interp_cspline<vec_t,vec2_t> &);
@@ -960,8 +1209,46 @@ namespace o2scl {
     /// Return the type, \c "interp_akima".
     virtual const char *type() const { return "interp_akima"; }
 
+    /** \brief Evaluate the function or its derivatives at a 
+	block of points (see \ref interp_base::eval_block())
+    */
+    virtual void eval_block(size_t n, const double *x0, double *y0,
+			    size_t nderiv, size_t &cache) const {
+      this->eval_block_search(n,x0,y0,nderiv,cache);
+      return;
+    }
+
 #ifndef DOXYGEN_INTERNAL
 
+  protected:
+
+    /// Evaluate a block of points with known intervals
+    virtual void eval_index(size_t n, const double *x0, const size_t *index,
+			    double *y0, size_t nderiv) const {
+      const vec_t &x=*(this->px);
+      const vec2_t &y=*(this->py);
+      if (nderiv==0) {
+	for(size_t i=0;i<n;i++) {
+	  size_t j=index[i];
+	  double delx=x0[i]-x[j];
+	  y0[i]=y[j]+delx*(b[j]+delx*(c[j]+d[j]*delx));
+	}
+      } else if (nderiv==1) {
+	for(size_t i=0;i<n;i++) {
+	  size_t j=index[i];
+	  double delx=x0[i]-x[j];
+	  y0[i]=b[j]+delx*(2.0*c[j]+3.0*d[j]*delx);
+	}
+      } else {
+	for(size_t i=0;i<n;i++) {
+	  size_t j=index[i];
+	  double delx=x0[i]-x[j];
+	  y0[i]=2.0*c[j]+6.0*d[j]*delx;
+	}
+      }
+      return;
+    }
+
   private:
 
     interp_akima<vec_t,vec2_t>(const interp_akima<vec_t,vec2_t> &);
@@ -1279,8 +1566,45 @@ namespace o2scl {
     /// Return the type, \c "interp_steffen".
     virtual const char *type() const { return "interp_steffen"; }
 
+    /** \brief Evaluate the function or its derivatives at a 
+	block of points (see \ref interp_base::eval_block())
+    */
+    virtual void eval_block(size_t n, const double *x0, double *y0,
+			    size_t nderiv, size_t &cache) const {
+      this->eval_block_search(n,x0,y0,nderiv,cache);
+      return;
+    }
+
 #ifndef DOXYGEN_INTERNAL
 
+  protected:
+
+    /// Evaluate a block of points with known intervals
+    virtual void eval_index(size_t n, const double *x0, const size_t *index,
+			    double *y0, size_t nderiv) const {
+      const vec_t &x=*(this->px);
+      if (nderiv==0) {
+	for(size_t i=0;i<n;i++) {
+	  size_t j=index[i];
+	  double delx=x0[i]-x[j];
+	  y0[i]=d[j]+delx*(c[j]+delx*(b[j]+delx*a[j]));
+	}
+      } else if (nderiv==1) {
+	for(size_t i=0;i<n;i++) {
+	  size_t j=index[i];
+	  double delx=x0[i]-x[j];
+	  y0[i]=c[j]+delx*(2.0*b[j]+delx*3.0*a[j]);
+	}
+      } else {
+	for(size_t i=0;i<n;i++) {
+	  size_t j=index[i];
+	  double delx=x0[i]-x[j];
+	  y0[i]=2.0*b[j]+delx*6.0*a[j];
+	}
+      }
+      return;
+    }
+
   private:
   
   interp_steffen<vec_t,vec2_t>(const interp_steffen<vec_t,vec2_t> &);
@@ -1549,8 +1873,44 @@ namespace o2scl {
     /// Return the type, \c "interp_monotonic".
     virtual const char *type() const { return "interp_monotonic"; }
 
+    /** \brief Evaluate the function or its derivatives at a 
+	block of points (see \ref interp_base::eval_block())
+    */
+    virtual void eval_block(size_t n, const double *x0, double *y0,
+			    size_t nderiv, size_t &cache) const {
+      this->eval_block_search(n,x0,y0,nderiv,cache);
+      return;
+    }
+
 #ifndef DOXYGEN_INTERNAL
 
+  protected:
+
+    /// Evaluate a block of points with known intervals
+    virtual void eval_index(size_t n, const double *x0, const size_t *index,
+			    double *y0, size_t nderiv) const {
+      const vec_t &x=*(this->px);
+      const vec2_t &y=*(this->py);
+      for(size_t i=0;i<n;i++) {
+	size_t j=index[i];
+	double h=x[j+1]-x[j];
+	double t=(x0[i]-x[j])/h;
+	double t2=t*t;
+	if (nderiv==0) {
+	  double t3=t2*t;
+	  y0[i]=y[j]*(2.0*t3-3.0*t2+1.0)+h*m[j]*(t3-2.0*t2+t)+
+	    y[j+1]*(-2.0*t3+3.0*t2)+h*m[j+1]*(t3-t2);
+	} else if (nderiv==1) {
+	  y0[i]=(y[j]*(6.0*t2-6.0*t)+h*m[j]*(3.0*t2-4.0*t+1.0)+
+		 y[j+1]*(-6.0*t2+6.0*t)+h*m[j+1]*(3.0*t2-2.0*t))/h;
+	} else {
+	  y0[i]=(y[j]*(12.0*t-6.0)+h*m[j]*(6.0*t-4.0)+
+		 y[j+1]*(-12.0*t+6.0)+h*m[j+1]*(6.0*t-2.0))/h/h;
+	}
+      }
+      return;
+    }
+
   private:
 
     interp_monotonic<vec_t,vec2_t>(const interp_monotonic<vec_t,vec2_t> &);
@@ -1864,6 +2224,19 @@ namespace o2scl {
     return itp->integ(x1,x2);
   }		      
   
+  /** \brief Evaluate the function or its derivatives at a 
+      block of points (see \ref interp_base::eval_block())
+  */
+  virtual void eval_block(size_t n, const double *x0, double *y0,
+			  size_t nderiv, size_t &cache) const {
+    if (itp==0) {
+      O2SCL_ERR("No vector set in interp_vec::eval_block().",
+		exc_einval);
+    }
+    itp->eval_block(n,x0,y0,nderiv,cache);
+    return;
+  }
+  
   /// Return the type, "interp_vec"
   virtual const char *type() const {
     return "interp_vec";
@@ -700,6 +700,80 @@ int main(void) {
     if (debug) cout.precision(6);
   }
 
+  // ---------------------------------------------------------------
+  // Test evaluation at several points at once
+
+  {
+    static const size_t N=40;
+    ubvector vx(N), vy(N), rvx(N), rvy(N);
+
+    // Sorted points, a point outside the data, and a few random
+    // points which require a binary search
+    static const size_t M=300;
+    ubvector x0(M), x1(M), y0(M), d0(M), dd0(M), i0(M);
+    for(size_t i=0;i<M;i++) {
+      if (i<250) {
+	x0[i]=-0.1+((double)i)*0.04;
+      } else {
+	x0[i]=fmod(((double)i)*7.3,9.5);
+      }
+    }
+    // Upper limits for the integrals, in a different order
+    for(size_t i=0;i<M;i++) {
+      x1[i]=x0[(i*37+11)%M];
+    }
+
+    size_t types[6]={itp_linear,itp_cspline,itp_cspline_peri,itp_akima,
+		     itp_monotonic,itp_steffen};
+    for(size_t q=0;q<2;q++) {
+
+      // Two different functions
+      for(size_t i=0;i<N;i++) {
+	vx[i]=((double)i)/4.0;
+	if (q==0) {
+	  vy[i]=sin(vx[i])+vx[i]/2.0;
+	} else {
+	  vy[i]=exp(-vx[i]/3.0)*cos(2.0*vx[i]);
+	}
+	rvx[N-1-i]=vx[i];
+	rvy[N-1-i]=vy[i];
+      }
+
+      for(size_t k=0;k<6;k++) {
+	for(size_t rev=0;rev<2;rev++) {
+	  interp_vec<> iv, iv2;
+	  if (rev==0) {
+	    iv.set(N,vx,vy,types[k]);
+	    iv2.set(N,vx,vy,types[k]);
+	  } else {
+	    iv.set(N,rvx,rvy,types[k]);
+	    iv2.set(N,rvx,rvy,types[k]);
+	  }
+	  iv.eval_many(M,x0,y0);
+	  iv.deriv_many(M,x0,d0);
+	  iv.deriv2_many(M,x0,dd0);
+	  iv.integ_many(M,x0,x1,i0);
+	  
+	  // Compare with separate calls to a second object
+	  bool match=true;
+	  size_t n_nonzero=0;
+	  for(size_t i=0;i<M;i++) {
+	    double ie=iv2.integ(x0[i],x1[i]);
+	    if (fabs(y0[i]-iv2.eval(x0[i]))>1.0e-12*(fabs(y0[i])+1.0) ||
+		fabs(d0[i]-iv2.deriv(x0[i]))>1.0e-12*(fabs(d0[i])+1.0) ||
+		fabs(dd0[i]-iv2.deriv2(x0[i]))>1.0e-12*(fabs(dd0[i])+1.0) ||
+		fabs(i0[i]-ie)>1.0e-12*(fabs(ie)+1.0)) {
+	      match=false;
+	    }
+	    if (i0[i]!=0.0) n_nonzero++;
+	  }
+	  t.test_gen(match,"eval_many");
+	  t.test_gen(n_nonzero>M/2,"integ_many nonzero");
+	}
+      }
+    }
+  }
+
   t.report();
 
   return 0;
@@ -55,6 +55,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <cmath>
+#include <vector>
 
 #include <o2scl/shunting_yard.h>
 
@@ -483,6 +484,243 @@ double calculator::eval(std::map<std::string, double>* vars) {
   return calculate(this->RPN, vars);
 }
 
+void calculator::eval_vec
+(size_t n, const std::map<std::string, const double *> &arrays,
+ const std::map<std::string, double> &scalars, double *res) const {
+
+  enum {vec_num, vec_arr, vec_sin, vec_cos, vec_tan, vec_sqrt, vec_log,
+	vec_exp, vec_abs, vec_log10, vec_asin, vec_acos, vec_atan,
+	vec_sinh, vec_cosh, vec_tanh, vec_asinh, vec_acosh, vec_atanh,
+	vec_binary, vec_add, vec_mul, vec_sub, vec_div, vec_shl, vec_pow,
+	vec_shr, vec_mod, vec_lt, vec_gt, vec_le, vec_ge, vec_eq, vec_ne,
+	vec_and, vec_or};
+
+  // Decode the RPN queue into a list of instructions
+  std::vector<int> codes;
+  std::vector<double> nums;
+  std::vector<const double *> ptrs;
+  size_t depth=0, max_depth=0;
+  
+  TokenQueue_t rpn=this->RPN;
+  while (!rpn.empty()) {
+    TokenBase* base=rpn.front();
+    rpn.pop();
+    int code=vec_num;
+    double num=0.0;
+    const double *ptr=0;
+    if (base->type==OP) {
+      std::string str=static_cast<Token<std::string>*>(base)->val;
+      code=-1;
+      if (str=="sin") code=vec_sin;
+      else if (str=="cos") code=vec_cos;
+      else if (str=="tan") code=vec_tan;
+      else if (str=="sqrt") code=vec_sqrt;
+      else if (str=="log") code=vec_log;
+      else if (str=="exp") code=vec_exp;
+      else if (str=="abs") code=vec_abs;
+      else if (str=="log10") code=vec_log10;
+      else if (str=="asin") code=vec_asin;
+      else if (str=="acos") code=vec_acos;
+      else if (str=="atan") code=vec_atan;
+      else if (str=="sinh") code=vec_sinh;
+      else if (str=="cosh") code=vec_cosh;
+      else if (str=="tanh") code=vec_tanh;
+      else if (str=="asinh") code=vec_asinh;
+      else if (str=="acosh") code=vec_acosh;
+      else if (str=="atanh") code=vec_atanh;
+      else if (str=="+") code=vec_add;
+      else if (str=="*") code=vec_mul;
+      else if (str=="-") code=vec_sub;
+      else if (str=="/") code=vec_div;
+      else if (str=="<<") code=vec_shl;
+      else if (str=="^") code=vec_pow;
+      else if (str==">>") code=vec_shr;
+      else if (str=="%") code=vec_mod;
+      else if (str=="<") code=vec_lt;
+      else if (str==">") code=vec_gt;
+      else if (str=="<=") code=vec_le;
+      else if (str==">=") code=vec_ge;
+      else if (str=="==") code=vec_eq;
+      else if (str=="!=") code=vec_ne;
+      else if (str=="&&") code=vec_and;
+      else if (str=="||") code=vec_or;
+      if (code<0) {
+	throw std::domain_error("Unknown operator: '" + str + "'.");
+      }
+      size_t nargs=(code>vec_binary) ? 2 : 1;
+      if (depth<nargs) {
+	throw std::domain_error("Invalid equation.");
+      }
+      depth-=nargs-1;
+    } else if (base->type==NUM) {
+      num=static_cast<Token<double>*>(base)->val;
+      depth++;
+    } else if (base->type==VAR) {
+      std::string key=static_cast<Token<std::string>*>(base)->val;
+      std::map<std::string, const double *>::const_iterator ait=
+	arrays.find(key);
+      if (ait!=arrays.end()) {
+	code=vec_arr;
+	ptr=ait->second;
+      } else {
+	std::map<std::string, double>::const_iterator sit=scalars.find(key);
+	if (sit==scalars.end()) {
+	  throw std::domain_error("Unable to find the variable '" +
+				  key + "'.");
+	}
+	num=sit->second;
+      }
+      depth++;
+    } else {
+      throw std::domain_error("Invalid token.");
+    }
+    if (depth>max_depth) max_depth=depth;
+    codes.push_back(code);
+    nums.push_back(num);
+    ptrs.push_back(ptr);
+  }
+  if (depth==0) {
+    throw std::domain_error("Invalid equation.");
+  }
+
+  // Evaluate the instructions for blocks of points, using
+  // one row of the stack for each stack entry
+  const size_t B=128;
+  std::vector<double> stack(max_depth*B);
+  
+  for(size_t start=0;start<n;start+=B) {
+    size_t m=n-start;
+    if (m>B) m=B;
+    size_t d=0;
+    for(size_t ic=0;ic<codes.size();ic++) {
+      int code=codes[ic];
+      if (code==vec_num) {
+	double *top=&stack[d*B];
+	for(size_t k=0;k<m;k++) top[k]=nums[ic];
+	d++;
+      } else if (code==vec_arr) {
+	double *top=&stack[d*B];
+	const double *src=ptrs[ic]+start;
+	for(size_t k=0;k<m;k++) top[k]=src[k];
+	d++;
+      } else if (code<vec_binary) {
+	double *top=&stack[(d-1)*B];
+	switch (code) {
+	case vec_sin:
+	  for(size_t k=0;k<m;k++) top[k]=sin(top[k]);
+	  break;
+	case vec_cos:
+	  for(size_t k=0;k<m;k++) top[k]=cos(top[k]);
+	  break;
+	case vec_tan:
+	  for(size_t k=0;k<m;k++) top[k]=tan(top[k]);
+	  break;
+	case vec_sqrt:
+	  for(size_t k=0;k<m;k++) top[k]=sqrt(top[k]);
+	  break;
+	case vec_log:
+	  for(size_t k=0;k<m;k++) top[k]=log(top[k]);
+	  break;
+	case vec_exp:
+	  for(size_t k=0;k<m;k++) top[k]=exp(top[k]);
+	  break;
+	case vec_abs:
+	  for(size_t k=0;k<m;k++) top[k]=fabs(top[k]);
+	  break;
+	case vec_log10:
+	  for(size_t k=0;k<m;k++) top[k]=log10(top[k]);
+	  break;
+	case vec_asin:
+	  for(size_t k=0;k<m;k++) top[k]=asin(top[k]);
+	  break;
+	case vec_acos:
+	  for(size_t k=0;k<m;k++) top[k]=acos(top[k]);
+	  break;
+	case vec_atan:
+	  for(size_t k=0;k<m;k++) top[k]=atan(top[k]);
+	  break;
+	case vec_sinh:
+	  for(size_t k=0;k<m;k++) top[k]=sinh(top[k]);
+	  break;
+	case vec_cosh:
+	  for(size_t k=0;k<m;k++) top[k]=cosh(top[k]);
+	  break;
+	case vec_tanh:
+	  for(size_t k=0;k<m;k++) top[k]=tanh(top[k]);
+	  break;
+	case vec_asinh:
+	  for(size_t k=0;k<m;k++) top[k]=asinh(top[k]);
+	  break;
+	case vec_acosh:
+	  for(size_t k=0;k<m;k++) top[k]=acosh(top[k]);
+	  break;
+	case vec_atanh:
+	  for(size_t k=0;k<m;k++) top[k]=atanh(top[k]);
+	  break;
+	}
+      } else {
+	double *a=&stack[(d-2)*B];
+	const double *b=&stack[(d-1)*B];
+	switch (code) {
+	case vec_add:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]+b[k];
+	  break;
+	case vec_mul:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]*b[k];
+	  break;
+	case vec_sub:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]-b[k];
+	  break;
+	case vec_div:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]/b[k];
+	  break;
+	case vec_shl:
+	  for(size_t k=0;k<m;k++) a[k]=(int) a[k] << (int) b[k];
+	  break;
+	case vec_pow:
+	  for(size_t k=0;k<m;k++) a[k]=pow(a[k],b[k]);
+	  break;
+	case vec_shr:
+	  for(size_t k=0;k<m;k++) a[k]=(int) a[k] >> (int) b[k];
+	  break;
+	case vec_mod:
+	  for(size_t k=0;k<m;k++) a[k]=(int) a[k] % (int) b[k];
+	  break;
+	case vec_lt:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]<b[k];
+	  break;
+	case vec_gt:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]>b[k];
+	  break;
+	case vec_le:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]<=b[k];
+	  break;
+	case vec_ge:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]>=b[k];
+	  break;
+	case vec_eq:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]==b[k];
+	  break;
+	case vec_ne:
+	  for(size_t k=0;k<m;k++) a[k]=a[k]!=b[k];
+	  break;
+	case vec_and:
+	  for(size_t k=0;k<m;k++) a[k]=(int) a[k] && (int) b[k];
+	  break;
+	case vec_or:
+	  for(size_t k=0;k<m;k++) a[k]=(int) a[k] || (int) b[k];
+	  break;
+	}
+	d--;
+      }
+    }
+    const double *top=&stack[(d-1)*B];
+    for(size_t k=0;k<m;k++) res[start+k]=top[k];
+  }
+  
+  return;
+}
+
 std::string calculator::RPN_to_string() {
   std::stringstream ss;
   TokenQueue_t rpn = this->RPN;
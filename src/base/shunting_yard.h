@@ -192,6 +192,22 @@ namespace o2scl {
 	variables specified in \c vars
      */
     double eval(std::map<std::string, double> *vars=0);
+
+    /** \brief Evaluate the previously compiled expression for
+	\c n points, storing the results in \c res
+
+	Variables are looked up first in \c arrays, in which case
+	the value for point \c i is element \c i of the corresponding
+	array, and then in \c scalars. The expression is decoded only
+	once and then evaluated for blocks of points, which is much
+	faster than calling \ref eval() for each point. This function
+	does not modify the object, so several threads may call it
+	simultaneously.
+    */
+    void eval_vec(size_t n,
+		  const std::map<std::string, const double *> &arrays,
+		  const std::map<std::string, double> &scalars,
+		  double *res) const;
     
     /** \brief Convert the RPN expression to a string
 
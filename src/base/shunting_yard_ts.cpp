@@ -149,6 +149,35 @@ int main(void) {
   cout << calc.RPN_to_string() << endl;
   t.test_rel(calc.eval(0),0.5,1.0e-14,"calc34");
 
+  // Test eval_vec() against eval()
+  {
+    double xa[300], ya[300], za[300];
+    for(size_t i=0;i<300;i++) {
+      xa[i]=((double)i)/100.0-1.0;
+      ya[i]=cos(((double)i));
+    }
+    std::map<std::string,const double *> arrays;
+    arrays["x"]=xa;
+    arrays["y"]=ya;
+    std::map<std::string,double> scalars, vars;
+    scalars["a"]=2.5;
+    vars["a"]=2.5;
+    
+    const char *exprs[4]={"-x*a+sin(y)^2-(x<y)",
+			  "sqrt(abs(x))+exp(-y*y)/a",
+			  "(x>0 && y>0)+atan(x+y)-log10(a)",
+			  "3"};
+    for(size_t k=0;k<4;k++) {
+      calc.compile(exprs[k],0);
+      calc.eval_vec(300,arrays,scalars,za);
+      for(size_t i=0;i<300;i++) {
+	vars["x"]=xa[i];
+	vars["y"]=ya[i];
+	t.test_gen(za[i]==calc.eval(&vars),"eval_vec");
+      }
+    }
+  }
+
   t.report();
   return 0;
 }
@@ -41,6 +41,7 @@
 #include <o2scl/interp.h>
 
 #include <o2scl/shunting_yard.h>
+#include <o2scl/text_numbers.h>
 
 #ifndef DOXYGEN_NO_O2NS
 
@@ -2350,93 +2351,61 @@ namespace o2scl {
     
   /// \name Miscellaneous methods
   //@{
-  /// Clear the current table and read from a generic data file
-  virtual int read_generic(std::istream &fin, int verbose=0) {
-
-    double data;
-    std::string line;
-    std::string cname;
+  /** \brief Clear the current table and read from a generic data file
 
-    // Read first line and into list
-    std::vector<std::string> onames, nnames;
-    getline(fin,line);
-    std::istringstream is(line);
-    while (is >> cname) {
-      onames.push_back(cname);
-      if (verbose>2) {
-	std::cout << "Read possible column name: " << cname << std::endl;
-      }
-    }
-
-    // Count number of likely numbers in the first row
-    size_t n_nums=0;
-    for(size_t i=0;i<onames.size();i++) {
-      if (is_number(onames[i])) n_nums++;
-    }
-
-    int irow=0;
-
-    if (n_nums==onames.size()) {
-
-      if (verbose>0) {
-	std::cout << "First row looks like it contains numerical values." 
-		  << std::endl;
-	std::cout << "Creating generic column names: ";
-      }
+      The first line is used for the column names, unless it appears
+      to contain only numbers, in which case the columns are named
+      \c c1, \c c2, and so on. The remainder of the stream is read
+      into memory and converted with \ref read_generic_data(). See
+      also \ref read_generic_file(), which is faster for large files.
+  */
+  virtual int read_generic(std::istream &fin, int verbose=0) {
 
-      for(size_t i=0;i<onames.size();i++) {
-	nnames.push_back(((std::string)"c")+szttos(i+1));
-	if (verbose>0) std::cout << nnames[i] << " ";
-      
-      }
-      if (verbose>0) std::cout << std::endl;
+    size_t irow;
+    int ret=read_generic_header(fin,irow,verbose);
+    if (ret!=0) return ret;
 
-      // Make columns
-      for(size_t i=0;i<nnames.size();i++) {
-	new_column(nnames[i]);
-      }
+    text_buffer tb;
+    tb.read(fin);
+    read_generic_data(tb.data(),tb.size(),irow);
 
-      // Add first row of data
-      for(size_t i=0;i<onames.size();i++) {
-	set(i,irow,o2scl::stod(onames[i]));
-      }
-      irow++;
-
-    } else {
+    return 0;
+  }
 
-      // Ensure good column names
-      for(size_t i=0;i<onames.size();i++) {
-	std::string temps=onames[i];
-	make_fp_varname(temps);
-	make_unique_name(temps,nnames);
-	nnames.push_back(temps);
-	if (temps!=onames[i] && verbose>0) {
-	  std::cout << "Converted column named '" << onames[i] << "' to '" 
-	       << temps << "'." << std::endl;
-	}
-      }
+  /** \brief Clear the current table and read from the generic data
+      file named \c fname
 
-      // Make columns
-      for(size_t i=0;i<nnames.size();i++) {
-	new_column(nnames[i]);
-      }
+      This function reads the same format as \ref read_generic(),
+      but the data following the header is memory-mapped (if
+      available, see \ref text_buffer) rather than read through a
+      stream.
+  */
+  virtual int read_generic_file(std::string fname, int verbose=0) {
 
+    std::ifstream fin(fname.c_str());
+    if (!fin) {
+      O2SCL_ERR((((std::string)"Could not open file '")+fname+
+		 "' in table::read_generic_file().").c_str(),
+		exc_efilenotfound);
+      return exc_efilenotfound;
     }
-
-    // Read remaining rows
-    while ((fin) >> data) {
-      set(0,irow,data);
-      for(size_t i=1;i<get_ncolumns();i++) {
-	(fin) >> data;
-	set(i,irow,data);
+    size_t irow;
+    int ret=read_generic_header(fin,irow,verbose);
+    if (ret!=0) return ret;
+    std::streamoff pos=fin.tellg();
+    fin.close();
+
+    // If the header took up the entire file, there is no data left
+    text_buffer tb;
+    if (pos>=0) {
+      ret=tb.open(fname,(size_t)pos);
+      if (ret!=0) {
+	O2SCL_ERR((((std::string)"Could not map file '")+fname+
+		   "' in table::read_generic_file().").c_str(),ret);
+	return ret;
       }
-      irow++;
-    }
-
-    if (intp_set) {
-      intp_set=false;
-      delete si;
     }
+    read_generic_data(tb.data(),tb.size(),irow);
 
     return 0;
   }
@@ -2704,6 +2673,165 @@ namespace o2scl {
   
   protected:
   
+  /** \brief Read the column names (and possibly the first row of
+      data) for \ref read_generic()
+
+      On exit, \c irow is the number of rows of data which were
+      read. Descendants which read additional information from the
+      header (e.g. units) can override this function.
+  */
+  virtual int read_generic_header(std::istream &fin, size_t &irow,
+				  int verbose=0) {
+
+    std::string line;
+    std::string cname;
+
+    // Read first line and into list
+    std::vector<std::string> onames, nnames;
+    getline(fin,line);
+    std::istringstream is(line);
+    while (is >> cname) {
+      onames.push_back(cname);
+      if (verbose>2) {
+	std::cout << "Read possible column name: " << cname << std::endl;
+      }
+    }
+
+    // Count number of likely numbers in the first row
+    size_t n_nums=0;
+    for(size_t i=0;i<onames.size();i++) {
+      if (is_number(onames[i])) n_nums++;
+    }
+
+    irow=0;
+
+    if (n_nums==onames.size()) {
+
+      if (verbose>0) {
+	std::cout << "First row looks like it contains numerical values." 
+		  << std::endl;
+	std::cout << "Creating generic column names: ";
+      }
+
+      for(size_t i=0;i<onames.size();i++) {
+	nnames.push_back(((std::string)"c")+szttos(i+1));
+	if (verbose>0) std::cout << nnames[i] << " ";
+      
+      }
+      if (verbose>0) std::cout << std::endl;
+
+      // Make columns
+      for(size_t i=0;i<nnames.size();i++) {
+	new_column(nnames[i]);
+      }
+
+      // Add first row of data
+      for(size_t i=0;i<onames.size();i++) {
+	set(i,irow,o2scl::stod(onames[i]));
+      }
+      irow++;
+
+    } else {
+
+      // Ensure good column names
+      for(size_t i=0;i<onames.size();i++) {
+	std::string temps=onames[i];
+	make_fp_varname(temps);
+	make_unique_name(temps,nnames);
+	nnames.push_back(temps);
+	if (temps!=onames[i] && verbose>0) {
+	  std::cout << "Converted column named '" << onames[i] << "' to '" 
+	       << temps << "'." << std::endl;
+	}
+      }
+
+      // Make columns
+      for(size_t i=0;i<nnames.size();i++) {
+	new_column(nnames[i]);
+      }
+
+    }
+
+    return 0;
+  }
+
+  /** \brief Convert the whitespace-separated numbers in the \c n
+      characters starting at \c buf to rows of the table beginning
+      with row \c irow
+
+      The buffer is divided into chunks with \ref text_numbers and,
+      if \c O2SCL_OPENMP is defined, the chunks are converted in
+      parallel. The columns are allocated once using the number of
+      tokens in the buffer and the numbers are stored directly in the
+      columns. Reading stops at the first token which is not a
+      number. If the number of values is not a multiple of the number
+      of columns, the remaining entries in the last row are set to
+      zero.
+  */
+  void read_generic_data(const char *buf, size_t n, size_t irow) {
+
+    size_t ncols=get_ncolumns();
+    if (ncols==0 || n==0) {
+      set_nlines(irow);
+      return;
+    }
+
+    text_numbers tn;
+    tn.scan(buf,n);
+
+    // Allocate space for all of the tokens
+    set_nlines(irow+(tn.n_tokens()+ncols-1)/ncols);
+
+    std::vector<vec_t *> cols(ncols);
+    for(size_t i=0;i<ncols;i++) {
+      cols[i]=&(alist[i]->second.dat);
+    }
+
+    size_t nch=tn.n_chunks();
+    std::vector<size_t> nconv(nch);
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel
+#endif
+    {
+      std::vector<double> vals;
+#ifdef O2SCL_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for(size_t ic=0;ic<nch;ic++) {
+	nconv[ic]=tn.parse_chunk(ic,vals);
+	size_t k=tn.first_token(ic);
+	size_t icol=k%ncols;
+	size_t row=irow+k/ncols;
+	for(size_t j=0;j<nconv[ic];j++) {
+	  (*cols[icol])[row]=vals[j];
+	  icol++;
+	  if (icol==ncols) {
+	    icol=0;
+	    row++;
+	  }
+	}
+      }
+    }
+
+    // Find the first token which was not a number
+    size_t nvals=tn.n_tokens();
+    for(size_t ic=0;ic<nch;ic++) {
+      if (nconv[ic]<tn.chunk_tokens(ic)) {
+	nvals=tn.first_token(ic)+nconv[ic];
+	ic=nch;
+      }
+    }
+
+    size_t nrows=(nvals+ncols-1)/ncols;
+    for(size_t k=nvals;k<nrows*ncols;k++) {
+      (*cols[k%ncols])[irow+k/ncols]=0.0;
+    }
+    set_nlines(irow+nrows);
+
+    return;
+  }
+
   /** \brief The list of constants 
    */
   std::map<std::string,double> constants;
@@ -308,6 +308,7 @@ void table3d::set_size(size_t nx, size_t ny) {
 
 void table3d::set_slice_all(std::string name, double val) {
   size_t z=lookup_slice(name);
+  reset_cache(z);
   for(size_t i=0;i<numx;i++) {
     for(size_t j=0;j<numy;j++) {
       (list[z])(i,j)=val;
@@ -318,6 +319,7 @@ void table3d::set_slice_all(std::string name, double val) {
 
 void table3d::set(size_t ix, size_t iy, std::string name, double val) {
   size_t z=lookup_slice(name);
+  reset_cache(z);
   (list[z])(ix,iy)=val;
   return;
 }
@@ -328,6 +330,7 @@ void table3d::set_val(double x, double y, std::string name, double val) {
   lookup_y(y,iy);
   
   size_t z=lookup_slice(name);
+  reset_cache(z);
   (list[z])(ix,iy)=val;
   return;
 }
@@ -340,11 +343,13 @@ void table3d::set_val_ret(double &x, double &y, std::string name, double val) {
   y=yval[iy];
 
   size_t z=lookup_slice(name);
+  reset_cache(z);
   (list[z])(ix,iy)=val;
   return;
 }
     
 void table3d::set(size_t ix, size_t iy, size_t z, double val) {
+  reset_cache(z);
   (list[z])(ix,iy)=val;
   return;
 }
@@ -356,6 +361,7 @@ void table3d::set_val(double x, double y, size_t z, double val) {
   x=xval[ix];
   y=yval[iy];
   
+  reset_cache(z);
   (list[z])(ix,iy)=val;
   return;
 }
@@ -365,12 +371,14 @@ void table3d::set_val_ret(double &x, double &y, size_t z, double val) {
   lookup_x(x,ix);
   lookup_y(y,iy);
 
+  reset_cache(z);
   (list[z])(ix,iy)=val;
   return;
 }
     
 double &table3d::get(size_t ix, size_t iy, std::string name) {
   size_t z=lookup_slice(name);
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
 
@@ -386,6 +394,7 @@ double &table3d::get_val_ret(double &x, double &y, std::string name) {
   x=xval[ix];
   y=yval[iy];
   size_t z=lookup_slice(name);
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
 
@@ -405,6 +414,7 @@ double &table3d::get_val(double x, double y, std::string name) {
   lookup_x(x,ix);
   lookup_y(y,iy);
   size_t z=lookup_slice(name);
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
     
@@ -417,6 +427,7 @@ const double &table3d::get_val(double x, double y, std::string name) const {
 }
     
 double &table3d::get(size_t ix, size_t iy, size_t z) {
+  reset_cache(z);
   return (list[z])(ix,iy);
 }
 
@@ -425,6 +436,7 @@ const double &table3d::get(size_t ix, size_t iy, size_t z) const {
 }
 
 double &table3d::get_val_ret(double &x, double &y, size_t z) {
+  reset_cache(z);
   size_t ix=0, iy=0;
   lookup_x(x,ix);
   lookup_y(y,iy);
@@ -443,6 +455,7 @@ const double &table3d::get_val_ret(double &x, double &y, size_t z) const {
 }
 
 double &table3d::get_val(double x, double y, size_t z) {
+  reset_cache(z);
   size_t ix=0, iy=0;
   lookup_x(x,ix);
   lookup_y(y,iy);
@@ -458,6 +471,7 @@ const double &table3d::get_val(double x, double y, size_t z) const {
 
 void table3d::set_grid_x(size_t ix, double val) {
   if (ix<numx) {
+    reset_cache();
     (xval)[ix]=val;
     return;
   }
@@ -468,6 +482,7 @@ void table3d::set_grid_x(size_t ix, double val) {
     
 void table3d::set_grid_y(size_t iy, double val) {
   if (iy<numy) {
+    reset_cache();
     (yval)[iy]=val;
     return;
   }
@@ -542,6 +557,7 @@ void table3d::new_slice(std::string name) {
   }
   ubmatrix mp(numx,numy);
   list.push_back(mp);
+  reset_cache(list.size()-1);
   tree.insert(make_pair(name,list.size()-1));
   has_slice=true;
   return;
@@ -607,6 +623,7 @@ void table3d::init_slice(std::string scol, double val) {
 	      exc_einval);
   }
   size_t sl1=lookup_slice(scol);
+  reset_cache(sl1);
   for(size_t i=0;i<numx;i++) {
     for(size_t j=0;j<numy;j++) {
       (list[sl1])(i,j)=val;
@@ -669,6 +686,7 @@ void table3d::lookup(double val, std::string slice, size_t &ix,
 }
 
 void table3d::set_interp_type(size_t interp_type) {
+  reset_cache();
   itype=interp_type;
   return;
 }
@@ -677,10 +695,173 @@ size_t table3d::get_interp_type() const {
   return itype;
 }
 
+void table3d::clear_interp_cache() {
+  reset_cache();
+  return;
+}
+
+void table3d::reset_cache(size_t z) {
+  if (cache_valid.size()<=z) {
+    cache_valid.resize(z+1,false);
+  }
+  cache_valid[z]=false;
+  return;
+}
+
+void table3d::reset_cache() {
+  for(size_t i=0;i<cache_valid.size();i++) cache_valid[i]=false;
+  return;
+}
+
+bool table3d::cache_usable() const {
+  if (itype==itp_linear) {
+    return (numx>=2 && numy>=2);
+  }
+  if (itype==itp_cspline || itype==itp_cspline_peri) {
+    return (numx>=3 && numy>=3);
+  }
+  return false;
+}
+
+void table3d::build_cache(size_t z) const {
+
+  // Only one thread constructs the cache at a time. Other threads
+  // may be reading the cache for a different slice, but the vectors
+  // are only resized when a slice has been added, which requires
+  // a non-const function.
+  std::lock_guard<std::mutex> lock(cache_mutex.m);
+
+  if (cache_valid.size()<list.size()) {
+    cache_valid.resize(list.size(),false);
+  }
+  if (cache_dx.size()<list.size()) {
+    cache_dx.resize(list.size());
+    cache_dy.resize(list.size());
+    cache_dxy.resize(list.size());
+  }
+  if (cache_valid[z]) return;
+
+  // Linear interpolation requires only the data itself
+  if (itype==itp_linear) {
+    cache_valid[z]=true;
+    return;
+  }
+
+  const ubmatrix &m=list[z];
+  ubmatrix &dx=cache_dx[z];
+  ubmatrix &dy=cache_dy[z];
+  ubmatrix &dxy=cache_dxy[z];
+  dx.resize(numx,numy);
+  dy.resize(numx,numy);
+  dxy.resize(numx,numy);
+
+  // Derivatives with respect to x along each column
+  interp_vec<ubvector,ubmatrix_column> itpc;
+  for(size_t j=0;j<numy;j++) {
+    ubmatrix_column col(m,j);
+    itpc.set(numx,xval,col,itype);
+    for(size_t i=0;i<numx;i++) {
+      dx(i,j)=itpc.deriv(xval[i]);
+    }
+  }
+
+  // Derivatives with respect to y of the data and of the
+  // x-derivatives along each row
+  interp_vec<ubvector,ubmatrix_row> itpr;
+  for(size_t i=0;i<numx;i++) {
+    ubmatrix_row row(m,i);
+    itpr.set(numy,yval,row,itype);
+    for(size_t j=0;j<numy;j++) {
+      dy(i,j)=itpr.deriv(yval[j]);
+    }
+    ubmatrix_row row2(dx,i);
+    itpr.set(numy,yval,row2,itype);
+    for(size_t j=0;j<numy;j++) {
+      dxy(i,j)=itpr.deriv(yval[j]);
+    }
+  }
+
+  cache_valid[z]=true;
+  return;
+}
+
+void table3d::cache_weights(double t, double h, bool deriv,
+			    double w[4]) const {
+  if (itype==itp_linear) {
+    if (deriv) {
+      w[0]=-1.0/h;
+      w[2]=1.0/h;
+    } else {
+      w[0]=1.0-t;
+      w[2]=t;
+    }
+    w[1]=0.0;
+    w[3]=0.0;
+    return;
+  }
+  double t2=t*t;
+  if (deriv) {
+    w[0]=(6.0*t2-6.0*t)/h;
+    w[1]=3.0*t2-4.0*t+1.0;
+    w[2]=(6.0*t-6.0*t2)/h;
+    w[3]=3.0*t2-2.0*t;
+  } else {
+    double t3=t2*t;
+    w[0]=2.0*t3-3.0*t2+1.0;
+    w[1]=(t3-2.0*t2+t)*h;
+    w[2]=3.0*t2-2.0*t3;
+    w[3]=(t3-t2)*h;
+  }
+  return;
+}
+
+double table3d::eval_cache(size_t z, double x, double y,
+			   bool deriv_x, bool deriv_y) const {
+
+  // Find the grid cell containing the point, extrapolating
+  // with the cell at the edge if necessary
+  search_vec<const ubvector> svx(numx,xval), svy(numy,yval);
+  size_t ix=numx/2, iy=numy/2;
+  ix=svx.find_const(x,ix);
+  iy=svy.find_const(y,iy);
+
+  double hx=xval[ix+1]-xval[ix];
+  double hy=yval[iy+1]-yval[iy];
+  double wx[4], wy[4];
+  cache_weights((x-xval[ix])/hx,hx,deriv_x,wx);
+  cache_weights((y-yval[iy])/hy,hy,deriv_y,wy);
+
+  const ubmatrix &m=list[z];
+  double res=0.0;
+  for(size_t a=0;a<2;a++) {
+    for(size_t b=0;b<2;b++) {
+      res+=wx[2*a]*wy[2*b]*m(ix+a,iy+b);
+    }
+  }
+  if (itype==itp_linear) return res;
+
+  const ubmatrix &dx=cache_dx[z];
+  const ubmatrix &dy=cache_dy[z];
+  const ubmatrix &dxy=cache_dxy[z];
+  for(size_t a=0;a<2;a++) {
+    for(size_t b=0;b<2;b++) {
+      res+=wx[2*a+1]*wy[2*b]*dx(ix+a,iy+b)+
+	wx[2*a]*wy[2*b+1]*dy(ix+a,iy+b)+
+	wx[2*a+1]*wy[2*b+1]*dxy(ix+a,iy+b);
+    }
+  }
+  return res;
+}
+
 double table3d::interp(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    build_cache(z);
+    return eval_cache(z,x,y,false,false);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
   
@@ -715,13 +896,20 @@ void table3d::deriv_y(std::string fname, std::string fpname) {
     zp=lookup_slice(fpname);
   }
   
-  interp_vec<ubvector,ubmatrix_row> itp;
-
-  for(size_t i=0;i<numx;i++) {
-    ubmatrix_row row(list[z],i);
+  reset_cache(zp);
+  const ubmatrix &m=list[z];
+  ubmatrix &mp=list[zp];
+  
+  int nx=((int)numx);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+  for(int i=0;i<nx;i++) {
+    interp_vec<ubvector,ubmatrix_row> itp;
+    ubmatrix_row row(m,i);
     itp.set(numy,yval,row,itype);
     for(size_t j=0;j<numy;j++) {
-      set(i,j,zp,itp.deriv(xval[i]));
+      mp(i,j)=itp.deriv(yval[j]);
     }
   }
   
@@ -737,13 +925,20 @@ void table3d::deriv_x(std::string fname, std::string fpname) {
     zp=lookup_slice(fpname);
   }
   
-  interp_vec<ubvector,ubmatrix_column> itp;
-
-  for(size_t i=0;i<numy;i++) {
-    ubmatrix_column col(list[z],i);
+  reset_cache(zp);
+  const ubmatrix &m=list[z];
+  ubmatrix &mp=list[zp];
+  
+  int ny=((int)numy);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+  for(int i=0;i<ny;i++) {
+    interp_vec<ubvector,ubmatrix_column> itp;
+    ubmatrix_column col(m,i);
     itp.set(numx,xval,col,itype);
     for(size_t j=0;j<numx;j++) {
-      set(j,i,zp,itp.deriv(xval[j]));
+      mp(j,i)=itp.deriv(xval[j]);
     }
   }
   
@@ -754,6 +949,11 @@ double table3d::deriv_x(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    build_cache(z);
+    return eval_cache(z,x,y,true,false);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -774,6 +974,11 @@ double table3d::deriv_y(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    build_cache(z);
+    return eval_cache(z,x,y,false,true);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -796,10 +1001,13 @@ double table3d::integ_x(double x1, double x2, double y,
   
   size_t z=lookup_slice(name);
   
-  interp_vec<ubvector,ubmatrix_row> itp;
-
   ubvector icol(numx);
-  for(size_t i=0;i<numx;i++) {
+  int nx=((int)numx);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+  for(int i=0;i<nx;i++) {
+    interp_vec<ubvector,ubmatrix_row> itp;
     ubmatrix_row row(list[z],i);
     itp.set(numy,yval,row,itype);
     icol[i]=itp.eval(y);
@@ -817,10 +1025,13 @@ double table3d::integ_y(double x, double y1, double y2,
   
   size_t z=lookup_slice(name);
   
-  interp_vec<ubvector,ubmatrix_column> itp;
-
   ubvector icol(numy);
-  for(size_t i=0;i<numy;i++) {
+  int ny=((int)numy);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+  for(int i=0;i<ny;i++) {
+    interp_vec<ubvector,ubmatrix_column> itp;
     ubmatrix_column col(list[z],i);
     itp.set(numx,xval,col,itype);
     icol[i]=itp.eval(x);
@@ -836,6 +1047,11 @@ double table3d::deriv_xy(double x, double y, std::string name) const {
   double result;
   
   size_t z=lookup_slice(name);
+
+  if (cache_usable()) {
+    build_cache(z);
+    return eval_cache(z,x,y,true,true);
+  }
   
   interp_vec<ubvector,ubmatrix_column> itp;
 
@@ -853,6 +1069,7 @@ double table3d::deriv_xy(double x, double y, std::string name) const {
 }
 
 void table3d::zero_table() {
+  reset_cache();
   for(size_t i=0;i<list.size();i++) {
     for(size_t j=0;j<numx;j++) {
       for(size_t k=0;k<numy;k++) {
@@ -881,6 +1098,10 @@ void table3d::clear_data() {
     list[i].clear();
   }
   list.clear();
+  cache_valid.clear();
+  cache_dx.clear();
+  cache_dy.clear();
+  cache_dxy.clear();
       
   has_slice=false;
   return;
@@ -1072,10 +1293,12 @@ const boost::numeric::ublas::matrix<double> &table3d::get_slice
 boost::numeric::ublas::matrix<double> &table3d::get_slice
 (std::string name) {
   size_t z=lookup_slice(name);
+  reset_cache(z);
   return list[z];
 }
 
 boost::numeric::ublas::matrix<double> &table3d::get_slice(size_t iz) {
+  reset_cache(iz);
   return list[iz];
 }
 
@@ -1085,10 +1308,34 @@ const vector<boost::numeric::ublas::matrix<double> > &table3d::get_data() {
 
 void table3d::function_slice(string function, string scol) {
   
-  new_slice(scol);
-  size_t ic=lookup_slice(scol);
+  size_t ic;
+  if (!is_slice(scol,ic)) {
+    new_slice(scol);
+    ic=lookup_slice(scol);
+  }
+  reset_cache(ic);
 
   function_matrix(function,list[ic]);
 
   return;
 }
+
+void table3d::function_row(const calculator &calc,
+			   const std::vector<std::string> &names,
+			   size_t ix, double *res) const {
+
+  // Slices are stored in row-major order, so each row
+  // of a slice is contiguous
+  std::map<std::string,const double *> arrays;
+  arrays[yname]=&yval[0];
+  for(size_t k=0;k<list.size();k++) {
+    arrays[names[k]]=&(list[k](ix,0));
+  }
+
+  std::map<std::string,double> scalars;
+  scalars[xname]=xval[ix];
+
+  calc.eval_vec(numy,arrays,scalars,res);
+  
+  return;
+}
@@ -33,6 +33,7 @@
 #include <string>
 #include <cmath>
 #include <sstream>
+#include <mutex>
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
@@ -68,8 +69,25 @@ namespace o2scl {
   /** \brief A data structure containing many slices of two-dimensional
       data points defined on a grid
 
-      \future Improve interpolation and derivative caching, possibly
-      through non-const versions of the interpolation functions.
+      For linear, cubic spline, and periodic cubic spline
+      interpolation, \ref interp(), \ref deriv_x(), \ref deriv_y()
+      and \ref deriv_xy() use a cache for each slice which stores
+      the derivatives of the spline with respect to \f$ x \f$, \f$ y
+      \f$, and both \f$ x \f$ and \f$ y \f$ at the grid points. The
+      interpolated value in each grid cell is then the bicubic
+      Hermite polynomial determined by these derivatives, which is
+      identical to the result from interpolating first in \f$ x \f$
+      and then in \f$ y \f$. The cache is constructed on the first
+      interpolation and is invalidated by any function which can
+      modify the slice, including the non-const versions of get() and
+      get_slice(). If a reference obtained from one of these
+      functions is used to modify a slice after an interpolation,
+      then \ref clear_interp_cache() must be called. The other
+      interpolation types are computed directly from the data on each
+      call. The cache is constructed while holding a lock, so
+      different threads may simultaneously interpolate in the same
+      object, as long as no thread modifies it.
+
       \future Should there be a clear_grid() function separate from
       clear_data() and clear_table()?
       \future Allow the user to more clearly probe 'size_set' vs.
@@ -146,6 +164,7 @@ namespace o2scl {
       yval.resize(ny);
       for(size_t i=0;i<nx;i++) (xval)[i]=x[i];
       for(size_t i=0;i<ny;i++) (yval)[i]=y[i];
+      reset_cache();
       size_set=true;
       xy_set=true;
       return;
@@ -183,6 +202,7 @@ namespace o2scl {
       yval.resize(numy);
       gx.vector(xval);
       gy.vector(yval);
+      reset_cache();
       size_set=true;
       xy_set=true;
     }
@@ -281,6 +301,7 @@ namespace o2scl {
       lookup_x(x,ix);
       lookup_y(y,iy);
 
+      reset_cache();
       for(size_t i=0;i<nv && i<list.size();i++) {
 	list[i](ix,iy)=vals[i];
       }
@@ -387,6 +408,7 @@ namespace o2scl {
       x=xval[ix];
       y=yval[iy];
 
+      reset_cache();
       for(size_t i=0;i<nv && i<list.size();i++) {
 	list[i](ix,iy)=vals[i];
       }
@@ -598,6 +620,43 @@ namespace o2scl {
      */
     double interp(double x, double y, std::string name) const;
 
+    /** \brief Interpolate the \c n points in \c x and \c y in 
+	slice named \c name, storing the results in \c res
+
+	If the interpolation cache can be used for the current 
+	interpolation type, then it is constructed first and, if
+	OpenMP support is enabled, the points are interpolated 
+	in parallel.
+    */
+    template<class vec_t, class vec2_t, class vec3_t>
+      void interp_many(size_t n, const vec_t &x, const vec2_t &y,
+		       std::string name, vec3_t &res) const {
+      
+      if (!cache_usable()) {
+	for(size_t i=0;i<n;i++) {
+	  res[i]=interp(x[i],y[i],name);
+	}
+	return;
+      }
+
+      size_t z=lookup_slice(name);
+      build_cache(z);
+
+      int nn=((int)n);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(int i=0;i<nn;i++) {
+	res[i]=eval_cache(z,x[i],y[i],false,false);
+      }
+      
+      return;
+    }
+
+    /** \brief Clear the interpolation cache for all slices
+     */
+    void clear_interp_cache();
+
     /** \brief Interpolate the derivative of the data with respect to
 	the x grid at point \c x and \c y in slice named \c name
     */
@@ -795,6 +854,9 @@ namespace o2scl {
     //@{
     /** \brief Fill a matrix from the function specified in \c function
 
+      If OpenMP support is enabled, the rows of the matrix are
+      computed in parallel.
+
       \comment
       This function must return an int rather than void because
       of the presence of the 'throw_on_err' mechanism
@@ -817,20 +879,29 @@ namespace o2scl {
       if (mat.size1()!=numx || mat.size2()!=numy) {
 	mat.resize(numx,numy);
       }
+      if (numx==0 || numy==0) return 0;
 
-      for(size_t i=0;i<numx;i++) {
-	for(size_t j=0;j<numy;j++) {
-	  vars[xname]=xval[i];
-	  vars[yname]=yval[j];
-	  
-	  for(size_t k=0;k<list.size();k++) {
-	    vars[get_slice_name(k)]=list[k](i,j);
-	  }
-	  
-	  mat(i,j)=calc.eval(&vars);
-	}
+      // The names of the slices
+      std::vector<std::string> names(list.size());
+      for(size_t k=0;k<list.size();k++) {
+	names[k]=get_slice_name(k);
+      }
+
+      // The first row is computed separately so that any errors in
+      // the function are reported outside of the parallel region
+      std::vector<double> row(numy);
+      function_row(calc,names,0,&row[0]);
+      for(size_t j=0;j<numy;j++) mat(0,j)=row[j];
+
+      int nx=((int)numx);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(int i=1;i<nx;i++) {
+	std::vector<double> rowi(numy);
+	function_row(calc,names,i,&rowi[0]);
+	for(size_t j=0;j<numy;j++) mat(i,j)=rowi[j];
       }
-      
       
       return 0;
     }
@@ -839,6 +910,10 @@ namespace o2scl {
 	
 	If the column already exists, the data already present is 
 	overwritten with the result.
+
+	The function is compiled once and evaluated for one row of
+	the grid at a time with calculator::eval_vec(). If OpenMP
+	support is enabled, the rows are evaluated in parallel.
     */
     void function_slice(std::string function, std::string col);
     //@}
@@ -906,8 +981,77 @@ namespace o2scl {
     map_const_iter const_end() const {return tree.end();};
     //@}
 
+    /** \brief Evaluate the compiled function in \c calc for all
+	of the grid points in row \c ix, storing the results in \c res
+     */
+    void function_row(const calculator &calc,
+		      const std::vector<std::string> &names,
+		      size_t ix, double *res) const;
+
+    /// The interpolation type
     size_t itype;
 
+    /// \name Interpolation cache
+    //@{
+    /** \brief True if the cache for the corresponding slice is
+	current
+
+	This is a vector of \c char rather than \c bool so that
+	each entry is a separate object.
+    */
+    mutable std::vector<char> cache_valid;
+
+    /// Derivatives with respect to x at the grid points
+    mutable std::vector<ubmatrix> cache_dx;
+
+    /// Derivatives with respect to y at the grid points
+    mutable std::vector<ubmatrix> cache_dy;
+
+    /// Mixed second derivatives at the grid points
+    mutable std::vector<ubmatrix> cache_dxy;
+
+    /** \brief A mutex which is not copied when the table is
+	copied
+    */
+    class cache_mutex_t {
+    public:
+      std::mutex m;
+      cache_mutex_t() {}
+      cache_mutex_t(const cache_mutex_t &) {}
+      cache_mutex_t &operator=(const cache_mutex_t &) {
+	return *this;
+      }
+    };
+
+    /// Lock for the construction of the cache
+    mutable cache_mutex_t cache_mutex;
+
+    /// Mark the cache for slice \c z as out of date
+    void reset_cache(size_t z);
+
+    /// Mark the cache for all slices as out of date
+    void reset_cache();
+
+    /** \brief Return true if the cache can be used with the
+	current interpolation type and grid size
+    */
+    bool cache_usable() const;
+
+    /// Construct the cache for slice \c z if necessary
+    void build_cache(size_t z) const;
+
+    /** \brief Compute the Hermite basis weights for the 
+	values and derivatives at the left and right grid points
+     */
+    void cache_weights(double t, double h, bool deriv, double w[4]) const;
+
+    /** \brief Use the cache to compute the value or the
+	derivatives of slice \c z at the point <tt>(x,y)</tt>
+    */
+    double eval_cache(size_t z, double x, double y, bool deriv_x,
+		      bool deriv_y) const;
+    //@}
+
 #endif
 
   };
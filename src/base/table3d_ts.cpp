@@ -216,6 +216,138 @@ int main(void) {
     cout << endl;
   }
 
+  // Compare the cached interpolation with direct interpolation
+  // first in x and then in y
+  {
+    typedef boost::numeric::ublas::matrix<double> ubmatrix;
+    typedef boost::numeric::ublas::matrix_column<const ubmatrix>
+      ubmatrix_column;
+
+    table3d ct;
+    ubvector x(8), y(6);
+    for(size_t i=0;i<8;i++) x[i]=((double)i)*0.3+0.02*i*i;
+    for(size_t j=0;j<6;j++) y[j]=2.0-((double)j)*0.4;
+    ct.set_xy("x",8,x,"y",6,y);
+    ct.new_slice("z");
+    for(size_t i=0;i<8;i++) {
+      for(size_t j=0;j<6;j++) {
+	ct.set(i,j,"z",sin(x[i])*exp(y[j]/2.0)+x[i]*y[j]);
+      }
+    }
+    const ubmatrix &m=ct.get_slice("z");
+
+    size_t types[4]={itp_linear,itp_cspline,itp_cspline_peri,itp_akima};
+    double px[3]={0.45,1.7,2.9}, py[3]={1.9,0.65,-0.1};
+    for(size_t k=0;k<4;k++) {
+      ct.set_interp_type(types[k]);
+      for(size_t ip=0;ip<3;ip++) {
+	ubvector col_v(6), col_d(6);
+	for(size_t j=0;j<6;j++) {
+	  ubmatrix_column col(m,j);
+	  interp_vec<ubvector,ubmatrix_column> itp(8,x,col,types[k]);
+	  col_v[j]=itp.eval(px[ip]);
+	  col_d[j]=itp.deriv(px[ip]);
+	}
+	interp_vec<ubvector> iv(6,y,col_v,types[k]);
+	interp_vec<ubvector> id(6,y,col_d,types[k]);
+	t.test_rel(ct.interp(px[ip],py[ip],"z"),iv.eval(py[ip]),
+		   1.0e-12,"cached interp");
+	t.test_rel(ct.deriv_x(px[ip],py[ip],"z"),id.eval(py[ip]),
+		   1.0e-12,"cached deriv_x");
+	t.test_rel(ct.deriv_y(px[ip],py[ip],"z"),iv.deriv(py[ip]),
+		   1.0e-12,"cached deriv_y");
+	t.test_rel(ct.deriv_xy(px[ip],py[ip],"z"),id.deriv(py[ip]),
+		   1.0e-12,"cached deriv_xy");
+      }
+    }
+
+    // Test interp_many()
+    ct.set_interp_type(itp_cspline);
+    ubvector vx(3), vy(3), vz(3);
+    for(size_t ip=0;ip<3;ip++) {
+      vx[ip]=px[ip];
+      vy[ip]=py[ip];
+    }
+    ct.interp_many(3,vx,vy,"z",vz);
+    for(size_t ip=0;ip<3;ip++) {
+      t.test_rel(vz[ip],ct.interp(px[ip],py[ip],"z"),1.0e-14,
+		 "interp_many");
+    }
+
+    // Ensure the cache is updated when the data changes
+    double z0=ct.interp(1.0,1.0,"z");
+    ct.set(3,3,"z",ct.get(3,3,"z")+1.0);
+    t.test_gen(ct.interp(1.0,1.0,"z")!=z0,"cache invalidated");
+
+    // Interpolate in a copy of the table from several threads at
+    // once, so that the caches for different slices are constructed
+    // simultaneously
+    ct.new_slice("z2");
+    ct.new_slice("z3");
+    for(size_t i=0;i<8;i++) {
+      for(size_t j=0;j<6;j++) {
+	ct.set(i,j,"z2",cos(x[i])*y[j]);
+	ct.set(i,j,"z3",x[i]*x[i]-y[j]);
+      }
+    }
+    table3d ct2=ct;
+    ct2.clear_interp_cache();
+    std::string snames[3]={"z","z2","z3"};
+    static const size_t np=300;
+    ubvector par(np), ser(np);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+    for(size_t ip=0;ip<np;ip++) {
+      par[ip]=ct2.interp(0.1+0.01*ip,1.8-0.005*ip,snames[ip%3]);
+    }
+    for(size_t ip=0;ip<np;ip++) {
+      ser[ip]=ct.interp(0.1+0.01*ip,1.8-0.005*ip,snames[ip%3]);
+    }
+    t.test_rel_vec(np,par,ser,1.0e-14,"parallel interp");
+  }
+
+  // Test the slice functions on a larger grid
+  {
+    table3d st;
+    ubvector x(40), y(30);
+    for(size_t i=0;i<40;i++) x[i]=((double)i)/39.0;
+    for(size_t j=0;j<30;j++) y[j]=((double)j)/29.0*2.0;
+    st.set_xy("x",40,x,"y",30,y);
+    st.add_constant("c",1.5);
+    st.function_slice("sin(x)*exp(y)+c","f");
+    for(size_t i=0;i<40;i++) {
+      for(size_t j=0;j<30;j++) {
+	t.test_rel(st.get(i,j,"f"),sin(x[i])*exp(y[j])+1.5,1.0e-14,
+		   "function_slice");
+      }
+    }
+
+    // Overwrite an existing slice
+    st.function_slice("f*2-c","f");
+    t.test_rel(st.get(3,4,"f"),2.0*sin(x[3])*exp(y[4])+1.5,1.0e-14,
+	       "function_slice overwrite");
+    st.function_slice("sin(x)*exp(y)+c","f");
+
+    st.deriv_x("f","dfdx");
+    st.deriv_y("f","dfdy");
+    // Test away from the boundaries where the natural
+    // spline is less accurate
+    for(size_t i=5;i<35;i++) {
+      for(size_t j=5;j<25;j++) {
+	t.test_rel(st.get(i,j,"dfdx"),cos(x[i])*exp(y[j]),1.0e-3,
+		   "deriv_x slice");
+	t.test_rel(st.get(i,j,"dfdy"),sin(x[i])*exp(y[j]),1.0e-3,
+		   "deriv_y slice");
+      }
+    }
+    
+    t.test_rel(st.integ_x(0.1,0.9,1.0,"f"),
+	       (cos(0.1)-cos(0.9))*exp(1.0)+0.8*1.5,1.0e-6,"integ_x");
+    t.test_rel(st.integ_y(0.5,0.2,1.8,"f"),
+	       sin(0.5)*(exp(1.8)-exp(0.2))+1.6*1.5,1.0e-6,"integ_y");
+  }
+
   /*
     12/4/15: This was old code for testing gen3_list. It just
     needs to be rewritten not to depend on separate text
@@ -199,6 +199,73 @@ int main(void) {
 
   }
 
+  {
+    // -------------------------------------------------------------
+    // Test read_generic() and read_generic_file()
+
+    ofstream fout("table_ts_gen.txt");
+    fout << "x y-val y-val" << endl;
+    for(size_t i=0;i<2000;i++) {
+      fout << ((double)i)/3.0 << " " << sin((double)i) << " "
+	   << ((double)i)*1.0e10 << endl;
+    }
+    fout.close();
+
+    table<> tg1, tg2;
+    ifstream fin("table_ts_gen.txt");
+    tg1.read_generic(fin);
+    fin.close();
+    tg2.read_generic_file("table_ts_gen.txt");
+    t.test_gen(tg1.get_ncolumns()==3,"read_generic ncolumns");
+    t.test_str(tg1.get_column_name(1),"y_val","read_generic names 1");
+    t.test_str(tg1.get_column_name(2),"y_val_","read_generic names 2");
+    t.test_gen(tg1.get_nlines()==2000,"read_generic nlines");
+    t.test_gen(tg2.get_nlines()==2000,"read_generic_file nlines");
+    for(size_t i=0;i<2000;i+=37) {
+      t.test_rel(tg1.get("x",i),((double)i)/3.0,1.0e-5,"read_generic 1");
+      t.test_rel(tg1.get("y_val_",i),((double)i)*1.0e10,1.0e-5,
+		 "read_generic 2");
+      for(size_t j=0;j<3;j++) {
+	t.test_gen(tg1.get(j,i)==tg2.get(j,i),"read_generic_file");
+      }
+    }
+
+    // Numeric first row, a partial last row, and text after the data
+    fout.open("table_ts_gen.txt");
+    fout << "1 2" << endl;
+    fout << "3 4" << endl;
+    fout << "5 6 7" << endl;
+    fout << "end 8" << endl;
+    fout.close();
+    table<> tg3;
+    tg3.read_generic_file("table_ts_gen.txt");
+    t.test_str(tg3.get_column_name(1),"c2","read_generic_file names");
+    t.test_gen(tg3.get_nlines()==4,"read_generic_file partial 1");
+    t.test_rel(tg3.get("c1",3),7.0,1.0e-14,"read_generic_file partial 2");
+    t.test_rel(tg3.get("c2",3),0.0,1.0e-14,"read_generic_file partial 3");
+
+    // Test the conversion with small chunks
+    std::string str=" 1.0 -2\n3e2\t4\n\n5.5 6 7\n8 9 10 11\n12";
+    text_numbers tn;
+    tn.chunk_size=3;
+    tn.scan(str.c_str(),str.length());
+    t.test_gen(tn.n_tokens()==12,"text_numbers tokens");
+    t.test_gen(tn.n_chunks()>1,"text_numbers chunks");
+    std::vector<double> vals, all;
+    for(size_t ic=0;ic<tn.n_chunks();ic++) {
+      t.test_gen(tn.first_token(ic)==all.size(),"text_numbers first");
+      size_t nc=tn.parse_chunk(ic,vals);
+      t.test_gen(nc==tn.chunk_tokens(ic),"text_numbers parse");
+      for(size_t j=0;j<nc;j++) all.push_back(vals[j]);
+    }
+    t.test_rel(all[2],300.0,1.0e-14,"text_numbers 1");
+    t.test_rel(all[11],12.0,1.0e-14,"text_numbers 2");
+    double d;
+    t.test_gen(text_numbers::to_double("1.5x",4,d)==false,"to_double 1");
+    t.test_gen(text_numbers::to_double("1.5x",3,d)==true,"to_double 2");
+
+  }
+
   t.report();
 
   return 0;
@@ -626,10 +626,76 @@ namespace o2scl {
       return;
     }
     
-    /// Clear the current table and read from a generic data file
-    virtual int read_generic(std::istream &fin, int verbose=0) {
+    /** \brief Insert columns from a source table into the new
+	table by interpolation (or extrapolation)
+    */
+    template<class vec2_t>
+      void insert_table(table_units<vec2_t> &source, std::string src_index,
+			bool allow_extrap=true, std::string dest_index="") {
+      
+      if (dest_index=="") dest_index=src_index;
+      
+      // Find limits to avoid extrapolation if necessary
+      double min=source.min(src_index);
+      double max=source.max(src_index);
+      if (allow_extrap==false) {
+	if (!std::isfinite(min) || !std::isfinite(max)) {
+	  O2SCL_ERR2("Minimum or maximum of source index not finite ",
+		     "in table_units::insert_table().",exc_einval);
+	}
+      }
+      
+      // Create list of columns to interpolate
+      std::vector<std::string> col_list;
+      for(size_t i=0;i<source.get_ncolumns();i++) {
+	std::string col=source.get_column_name(i);
+	if (col!=src_index && col!=dest_index &&
+	    this->is_column(col)==false) {
+	  col_list.push_back(col);
+	}
+      }
+      
+      // Create new columns and perform interpolation
+      for(size_t i=0;i<col_list.size();i++) {
+	this->new_column(col_list[i]);
+	set_unit(col_list[i],source.get_unit(col_list[i]));
+	for(size_t j=0;j<this->get_nlines();j++) {
+	  double val=this->get(dest_index,j);
+	  if (allow_extrap || (val>=min && val<=max)) {
+	    this->set(col_list[i],j,source.interp(src_index,val,col_list[i]));
+	  }
+	}
+      }
+      
+      return;
+    }
+    
+    // ---------
+    // Allow HDF I/O functions to access table_units data
+    friend void o2scl_hdf::hdf_output
+      (o2scl_hdf::hdf_file &hf, table_units<> &t, std::string name);
+    
+    template<class vecf_t> friend void o2scl_hdf::hdf_input
+      (o2scl_hdf::hdf_file &hf, table_units<vecf_t> &t, std::string name);
+
+    friend void o2scl_hdf::hdf_output_data
+      (o2scl_hdf::hdf_file &hf, table_units<> &t);
+    
+    template<class vecf_t> friend void o2scl_hdf::hdf_input_data
+      (o2scl_hdf::hdf_file &hf, table_units<vecf_t> &t);
+
+    // ---------
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /** \brief Read the column names, units (if present), and
+	possibly the first row of data for \ref read_generic()
+    */
+    virtual int read_generic_header(std::istream &fin, size_t &irow,
+				    int verbose=0) {
 	
-      double data;
       std::string line;
       std::string stemp;
       std::istringstream *is;
@@ -652,7 +718,7 @@ namespace o2scl {
 	if (is_number(onames[i])) n_nums++;
       }
 
-      int irow=0;
+      irow=0;
 
       if (n_nums==onames.size()) {
 
@@ -751,83 +817,8 @@ namespace o2scl {
 
       }
 
-      // Read remaining rows
-      while ((fin) >> data) {
-	this->set(0,irow,data);
-	for(size_t i=1;i<this->get_ncolumns();i++) {
-	  (fin) >> data;
-	  this->set(i,irow,data);
-	}
-	irow++;
-      }
-
       return 0;
     }
-    
-    /** \brief Insert columns from a source table into the new
-	table by interpolation (or extrapolation)
-    */
-    template<class vec2_t>
-      void insert_table(table_units<vec2_t> &source, std::string src_index,
-			bool allow_extrap=true, std::string dest_index="") {
-      
-      if (dest_index=="") dest_index=src_index;
-      
-      // Find limits to avoid extrapolation if necessary
-      double min=source.min(src_index);
-      double max=source.max(src_index);
-      if (allow_extrap==false) {
-	if (!std::isfinite(min) || !std::isfinite(max)) {
-	  O2SCL_ERR2("Minimum or maximum of source index not finite ",
-		     "in table_units::insert_table().",exc_einval);
-	}
-      }
-      
-      // Create list of columns to interpolate
-      std::vector<std::string> col_list;
-      for(size_t i=0;i<source.get_ncolumns();i++) {
-	std::string col=source.get_column_name(i);
-	if (col!=src_index && col!=dest_index &&
-	    this->is_column(col)==false) {
-	  col_list.push_back(col);
-	}
-      }
-      
-      // Create new columns and perform interpolation
-      for(size_t i=0;i<col_list.size();i++) {
-	this->new_column(col_list[i]);
-	set_unit(col_list[i],source.get_unit(col_list[i]));
-	for(size_t j=0;j<this->get_nlines();j++) {
-	  double val=this->get(dest_index,j);
-	  if (allow_extrap || (val>=min && val<=max)) {
-	    this->set(col_list[i],j,source.interp(src_index,val,col_list[i]));
-	  }
-	}
-      }
-      
-      return;
-    }
-    
-    // ---------
-    // Allow HDF I/O functions to access table_units data
-    friend void o2scl_hdf::hdf_output
-      (o2scl_hdf::hdf_file &hf, table_units<> &t, std::string name);
-    
-    template<class vecf_t> friend void o2scl_hdf::hdf_input
-      (o2scl_hdf::hdf_file &hf, table_units<vecf_t> &t, std::string name);
-
-    friend void o2scl_hdf::hdf_output_data
-      (o2scl_hdf::hdf_file &hf, table_units<> &t);
-    
-    template<class vecf_t> friend void o2scl_hdf::hdf_input_data
-      (o2scl_hdf::hdf_file &hf, table_units<vecf_t> &t);
-
-    // ---------
-
-#ifndef DOXYGEN_INTERNAL
-
-  protected:
-    
 
     /// The pointer to the convert units object
     convert_units *cup;
@@ -0,0 +1,309 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <o2scl/text_numbers.h>
+
+using namespace std;
+using namespace o2scl;
+
+text_buffer::text_buffer() {
+  ptr=0;
+  len=0;
+  map_ptr=0;
+  map_len=0;
+}
+
+text_buffer::~text_buffer() {
+  close();
+}
+
+void text_buffer::close() {
+#ifdef HAVE_MMAP
+  if (map_ptr!=0) {
+    munmap(map_ptr,map_len);
+  }
+#endif
+  map_ptr=0;
+  map_len=0;
+  store.clear();
+  ptr=0;
+  len=0;
+  return;
+}
+
+int text_buffer::open(std::string fname, size_t offset) {
+
+  close();
+
+#ifdef HAVE_MMAP
+
+  int fd=::open(fname.c_str(),O_RDONLY);
+  if (fd<0) return exc_efilenotfound;
+
+  struct stat st;
+  if (fstat(fd,&st)!=0) {
+    ::close(fd);
+    return exc_efilenotfound;
+  }
+  size_t fsize=(size_t)st.st_size;
+
+  if (fsize>offset) {
+    void *p=mmap(0,fsize,PROT_READ,MAP_PRIVATE,fd,0);
+    if (p!=MAP_FAILED) {
+      map_ptr=p;
+      map_len=fsize;
+      ptr=((const char *)p)+offset;
+      len=fsize-offset;
+    }
+  } else {
+    // Nothing after the offset
+    ::close(fd);
+    return 0;
+  }
+  ::close(fd);
+
+  // If the mapping succeeded, we're done, otherwise read
+  // the file below
+  if (map_ptr!=0) return 0;
+
+#endif
+
+  std::ifstream fin(fname.c_str(),std::ios::binary);
+  if (!fin) return exc_efilenotfound;
+  fin.seekg(offset);
+  if (fin) read(fin);
+
+  return 0;
+}
+
+void text_buffer::read(std::istream &fin) {
+
+  close();
+
+  const size_t block=1048576;
+  size_t n=0;
+  while (fin) {
+    store.resize(n+block);
+    fin.read(&store[n],block);
+    n+=fin.gcount();
+  }
+  store.resize(n);
+
+  if (n>0) ptr=&store[0];
+  len=n;
+
+  return;
+}
+
+/** \brief Return true if \c c is whitespace in the sense of
+    <tt>isspace()</tt> in the C locale
+*/
+static inline bool text_is_space(char c) {
+  return c==' ' || c=='\n' || c=='\t' || c=='\r' || c=='\v' || c=='\f';
+}
+
+text_numbers::text_numbers() {
+  chunk_size=1048576;
+  ntok=0;
+}
+
+void text_numbers::scan(const char *buf, size_t n) {
+
+  chunk_beg.clear();
+  chunk_end.clear();
+  ntok=0;
+
+  // Divide the buffer into chunks which end at a newline
+  const char *end=buf+n;
+  const char *p=buf;
+  while (p<end) {
+    const char *q=p+chunk_size;
+    if (chunk_size==0 || q>=end) {
+      q=end;
+    } else {
+      const char *nl=(const char *)memchr(q,'\n',end-q);
+      if (nl==0) q=end;
+      else q=nl+1;
+    }
+    chunk_beg.push_back(p);
+    chunk_end.push_back(q);
+    p=q;
+  }
+
+  size_t nch=chunk_beg.size();
+  chunk_ntok.resize(nch);
+  chunk_first.resize(nch);
+
+  // Count the tokens in each chunk
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(size_t ic=0;ic<nch;ic++) {
+    size_t cnt=0;
+    bool in_token=false;
+    for(const char *c=chunk_beg[ic];c<chunk_end[ic];c++) {
+      bool sp=text_is_space(*c);
+      if (!sp && !in_token) cnt++;
+      in_token=!sp;
+    }
+    chunk_ntok[ic]=cnt;
+  }
+
+  for(size_t ic=0;ic<nch;ic++) {
+    chunk_first[ic]=ntok;
+    ntok+=chunk_ntok[ic];
+  }
+
+  return;
+}
+
+bool text_numbers::to_double(const char *s, size_t len, double &d) {
+
+  if (len==0) return false;
+
+  // First try a decimal number with at most 15 significant digits
+  // and a small exponent. In this case the mantissa and the power
+  // of ten are exactly representable, so a single multiplication
+  // or division gives the correctly rounded result.
+  {
+    static const double pow10[23]={1.0e0,1.0e1,1.0e2,1.0e3,1.0e4,1.0e5,
+				   1.0e6,1.0e7,1.0e8,1.0e9,1.0e10,1.0e11,
+				   1.0e12,1.0e13,1.0e14,1.0e15,1.0e16,
+				   1.0e17,1.0e18,1.0e19,1.0e20,1.0e21,
+				   1.0e22};
+    const char *c=s, *end=s+len;
+    bool neg=false;
+    if (*c=='-' || *c=='+') {
+      neg=(*c=='-');
+      c++;
+    }
+    unsigned long long mant=0;
+    int ndig=0, exp10=0;
+    bool any=false;
+    // Leading zeros are not significant
+    while (c<end && *c=='0') {
+      c++;
+      any=true;
+    }
+    while (c<end && *c>='0' && *c<='9') {
+      if (ndig<19) mant=mant*10+(*c-'0');
+      else exp10++;
+      ndig++;
+      c++;
+      any=true;
+    }
+    if (c<end && *c=='.') {
+      c++;
+      if (ndig==0) {
+	while (c<end && *c=='0') {
+	  exp10--;
+	  c++;
+	  any=true;
+	}
+      }
+      while (c<end && *c>='0' && *c<='9') {
+	if (ndig<19) {
+	  mant=mant*10+(*c-'0');
+	  exp10--;
+	}
+	ndig++;
+	c++;
+	any=true;
+      }
+    }
+    bool ok=any;
+    if (ok && c<end && (*c=='e' || *c=='E')) {
+      c++;
+      bool eneg=false;
+      if (c<end && (*c=='-' || *c=='+')) {
+	eneg=(*c=='-');
+	c++;
+      }
+      if (c==end) ok=false;
+      int e=0;
+      while (c<end && *c>='0' && *c<='9') {
+	if (e<100000) e=e*10+(*c-'0');
+	c++;
+      }
+      exp10+=eneg ? -e : e;
+    }
+    if (ok && c==end && ndig<=15 && exp10>=-22 && exp10<=22) {
+      double v=(double)mant;
+      if (exp10<0) v/=pow10[-exp10];
+      else v*=pow10[exp10];
+      d=neg ? -v : v;
+      return true;
+    }
+  }
+
+  // Otherwise, use strtod(), copying the token so that it is
+  // null-terminated, since the buffer need not be
+  char sbuf[64];
+  std::string lbuf;
+  const char *t;
+  if (len<64) {
+    memcpy(sbuf,s,len);
+    sbuf[len]='\0';
+    t=sbuf;
+  } else {
+    lbuf.assign(s,len);
+    t=lbuf.c_str();
+  }
+
+  char *tend;
+  d=strtod(t,&tend);
+  return tend==t+len;
+}
+
+size_t text_numbers::parse_chunk(size_t ic, std::vector<double> &vals) const {
+
+  if (vals.size()<chunk_ntok[ic]) vals.resize(chunk_ntok[ic]);
+
+  size_t cnt=0;
+  const char *c=chunk_beg[ic];
+  const char *end=chunk_end[ic];
+  while (c<end) {
+    while (c<end && text_is_space(*c)) c++;
+    if (c==end) break;
+    const char *s=c;
+    while (c<end && !text_is_space(*c)) c++;
+    if (!to_double(s,c-s,vals[cnt])) return cnt;
+    cnt++;
+  }
+
+  return cnt;
+}
@@ -0,0 +1,195 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_TEXT_NUMBERS_H
+#define O2SCL_TEXT_NUMBERS_H
+
+/** \file text_numbers.h
+    \brief File defining \ref o2scl::text_buffer and
+    \ref o2scl::text_numbers
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <o2scl/err_hnd.h>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief A read-only buffer containing the contents of a text file
+      or the remainder of a stream
+
+      If \c HAVE_MMAP was defined when \o2 was compiled, then files
+      are memory-mapped, otherwise they are read into memory.
+  */
+  class text_buffer {
+
+  public:
+
+    text_buffer();
+
+    ~text_buffer();
+
+    /** \brief Open the file named \c fname, beginning \c offset bytes
+	from the start of the file
+
+	This function returns 0 for success and \ref exc_efilenotfound
+	if the file could not be opened.
+    */
+    int open(std::string fname, size_t offset=0);
+
+    /** \brief Read the remainder of stream \c fin into the buffer
+     */
+    void read(std::istream &fin);
+
+    /// Release the buffer
+    void close();
+
+    /// Pointer to the beginning of the buffer
+    const char *data() const {
+      return ptr;
+    }
+
+    /// The number of characters in the buffer
+    size_t size() const {
+      return len;
+    }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// Pointer to the beginning of the buffer
+    const char *ptr;
+    /// The number of characters in the buffer
+    size_t len;
+    /// The mapped region (including the part before the offset)
+    void *map_ptr;
+    /// The size of the mapped region
+    size_t map_len;
+    /// Storage for a buffer which is not mapped
+    std::vector<char> store;
+
+  private:
+
+    text_buffer(const text_buffer &);
+    text_buffer& operator=(const text_buffer&);
+
+#endif
+
+  };
+
+  /** \brief Whitespace-separated numbers in a text buffer
+
+      The function \ref scan() splits the buffer into chunks which
+      end at the end of a line and counts the number of
+      whitespace-separated tokens in each chunk. The chunks can then
+      be converted independently with \ref parse_chunk(), so that
+      large files can be processed in parallel. If \c O2SCL_OPENMP is
+      defined, then \ref scan() is parallelized.
+
+      Decimal numbers with at most 15 significant digits and
+      exponents between -22 and 22 are converted directly, and other
+      tokens are converted with <tt>strtod()</tt>. In both cases the
+      result is correctly rounded. A token is counted as a number
+      only if the entire token is converted.
+  */
+  class text_numbers {
+
+  public:
+
+    text_numbers();
+
+    /** \brief The approximate number of characters in each chunk
+	(default \f$ 2^{20} \f$)
+    */
+    size_t chunk_size;
+
+    /** \brief Split the \c n characters starting at \c buf into chunks
+	and count the tokens in each chunk
+
+	The buffer must remain valid as long as \ref parse_chunk()
+	is used.
+    */
+    void scan(const char *buf, size_t n);
+
+    /// The number of chunks
+    size_t n_chunks() const {
+      return chunk_beg.size();
+    }
+
+    /// The total number of tokens
+    size_t n_tokens() const {
+      return ntok;
+    }
+
+    /// The number of tokens in chunk \c ic
+    size_t chunk_tokens(size_t ic) const {
+      return chunk_ntok[ic];
+    }
+
+    /// The index of the first token of chunk \c ic
+    size_t first_token(size_t ic) const {
+      return chunk_first[ic];
+    }
+
+    /** \brief Convert the tokens in chunk \c ic, storing the results
+	in \c vals
+
+	This function stops at the first token which is not a number
+	and returns the number of tokens which were converted. The
+	vector \c vals is resized if necessary, but is not shrunk.
+    */
+    size_t parse_chunk(size_t ic, std::vector<double> &vals) const;
+
+    /** \brief Convert the \c len characters starting at \c s to a
+	double, returning false if they are not a number
+    */
+    static bool to_double(const char *s, size_t len, double &d);
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The beginning of each chunk
+    std::vector<const char *> chunk_beg;
+    /// The end of each chunk
+    std::vector<const char *> chunk_end;
+    /// The number of tokens in each chunk
+    std::vector<size_t> chunk_ntok;
+    /// The index of the first token in each chunk
+    std::vector<size_t> chunk_first;
+    /// The total number of tokens
+    size_t ntok;
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
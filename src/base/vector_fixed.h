@@ -0,0 +1,157 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_VECTOR_FIXED_H
+#define O2SCL_VECTOR_FIXED_H
+
+/** \file vector_fixed.h
+    \brief Vector and matrix types with a size fixed at compile time
+
+    The types in this file store their elements in a
+    <tt>std::array</tt>, so they require no heap allocation, and they
+    provide the <tt>resize()</tt>, <tt>size()</tt>, and element
+    access functions used by the \o2 solvers. They can be used as
+    the \c vec_t and \c mat_t template parameters of classes like
+    \ref o2scl::mroot_hybrids and \ref o2scl::jacobian_gsl for small
+    problems where the number of variables is known at compile time.
+    The linear algebra functions \ref o2scl_linalg::LU_decomp(), \ref
+    o2scl_linalg::LU_svx(), and \ref o2scl_linalg::HH_svx() have
+    overloads for these types with loop bounds fixed at compile time.
+*/
+
+#include <array>
+
+#include <o2scl/err_hnd.h>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief A vector with a size fixed at compile time
+
+      Attempting to resize the vector to a size other than \c N
+      calls the error handler.
+  */
+  template<size_t N> class fixed_vector : public std::array<double,N> {
+
+  public:
+
+    fixed_vector() {
+    }
+
+    /** \brief Create a vector of size \c n, which must be equal
+	to \c N
+    */
+    fixed_vector(size_t n) {
+      resize(n);
+    }
+
+    /** \brief Resize the vector (which must be of size \c N)
+     */
+    void resize(size_t n) {
+      if (n!=N) {
+	O2SCL_ERR("Size not equal to template parameter in fixed_vector.",
+		  exc_einval);
+      }
+      return;
+    }
+
+  };
+
+  /** \brief A row-major matrix with a size fixed at compile time
+
+      Elements can be accessed either with <tt>operator(,)</tt> or
+      with <tt>operator[]</tt>, which returns a pointer to the
+      beginning of the specified row. Attempting to resize the
+      matrix to a size other than \c N by \c M calls the error
+      handler.
+  */
+  template<size_t N, size_t M=N> class fixed_matrix {
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// The matrix elements
+    std::array<double,N*M> data_;
+
+#endif
+
+  public:
+
+    fixed_matrix() {
+    }
+
+    /** \brief Create a matrix of size \c n by \c m, which must be
+	equal to \c N and \c M
+    */
+    fixed_matrix(size_t n, size_t m) {
+      resize(n,m);
+    }
+
+    /** \brief Resize the matrix (which must be of size \c N by \c M)
+     */
+    void resize(size_t n, size_t m) {
+      if (n!=N || m!=M) {
+	O2SCL_ERR("Size not equal to template parameter in fixed_matrix.",
+		  exc_einval);
+      }
+      return;
+    }
+
+    /// The number of rows
+    size_t size1() const {
+      return N;
+    }
+
+    /// The number of columns
+    size_t size2() const {
+      return M;
+    }
+
+    /// Element access
+    double &operator()(size_t i, size_t j) {
+      return data_[i*M+j];
+    }
+
+    /// Element access
+    const double &operator()(size_t i, size_t j) const {
+      return data_[i*M+j];
+    }
+
+    /// Pointer to the beginning of row \c i
+    double *operator[](size_t i) {
+      return &data_[i*M];
+    }
+
+    /// Pointer to the beginning of row \c i
+    const double *operator[](size_t i) const {
+      return &data_[i*M];
+    }
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
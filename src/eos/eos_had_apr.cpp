@@ -289,6 +289,18 @@ double eos_had_apr::fesym_diff(double nb) {
   return ret;
 }
 
+int eos_had_apr::fsat_props(double nb, double &leoa, double &lcomp,
+			    double &lkprime, double &lmsom, double &lesym,
+			    double &lslope, double &lcurve) {
+  
+  int ret=eos_had_base::fsat_props(nb,leoa,lcomp,lkprime,lmsom,
+				   lesym,lslope,lcurve);
+  if (!parent_method) {
+    lcomp=fcomp(nb);
+  }
+  return ret;
+}
+
 double eos_had_apr::fcomp(double nb) {
 
   if (parent_method) {
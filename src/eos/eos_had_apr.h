@@ -189,6 +189,17 @@ namespace o2scl {
      */
     double fcomp(double nb);
 
+    /** \brief Compute the properties of isospin-symmetric matter 
+	in one pass
+
+	This uses \ref eos_had_base::fsat_props() and, unless \ref
+	parent_method is true, replaces the incompressibility with
+	the exact result from \ref fcomp().
+    */
+    virtual int fsat_props(double nb, double &leoa, double &lcomp,
+			   double &lkprime, double &lmsom, double &lesym,
+			   double &lslope, double &lcurve);
+
     /** \brief Calculate symmetry energy of matter as energy of 
 	neutron matter minus the energy of nuclear matter
 
@@ -284,7 +295,7 @@ namespace o2scl {
     //@}
 
     /** \brief If true, use the methods from eos_had_base for \ref
-	fcomp() and \ref fesym_diff() (default true)
+	fcomp(), \ref fsat_props(), and \ref fesym_diff() (default true)
 
 	This can be set to true to check the difference in the
 	compressibility and symmety energy between the exact
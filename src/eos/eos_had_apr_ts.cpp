@@ -248,6 +248,21 @@ int main(void) {
     }
     cout << endl;
 
+    cout << "Check saturation_fast()." << endl;
+    ap.pion=eos_had_apr::best;
+    for(size_t k=0;k<2;k++) {
+      ap.parent_method=(k==0);
+      ap.saturation_fast();
+      t.test_rel(ap.comp,ap.fcomp(ap.n0),1.0e-4,"sat_fast comp");
+      t.test_rel(ap.esym,ap.fesym(ap.n0),1.0e-4,"sat_fast esym");
+      t.test_rel(ap.esym_slope,ap.fesym_slope(ap.n0),1.0e-4,
+		 "sat_fast esym_slope");
+      t.test_rel(ap.esym_curve,ap.fesym_curve(ap.n0),1.0e-2,
+		 "sat_fast esym_curve");
+    }
+    ap.parent_method=false;
+    cout << endl;
+
   }
 
   // ----------------------------------------------------
@@ -50,6 +50,11 @@ eos_had_base::eos_had_base() {
   eos_mroot=&def_mroot;
   sat_root=&def_sat_root;
 
+  sat_props_dnb=1.0e-2;
+  sat_props_ddelta=1.0e-3;
+  esym_slope=0.0;
+  esym_curve=0.0;
+
   err_nonconv=true;
 }
 
@@ -308,6 +313,66 @@ int eos_had_base::saturation() {
   return 0;
 }
 
+int eos_had_base::fsat_props(double nb, double &leoa, double &lcomp,
+			     double &lkprime, double &lmsom, double &lesym,
+			     double &lslope, double &lcurve) {
+
+  double h=sat_props_dnb*nb, hd=sat_props_ddelta;
+  double pr[5], pon2[5], esy[5];
+
+  for(int k=0;k<5;k++) {
+    
+    double nbk=nb+((double)(k-2))*h;
+    
+    // Symmetry energy from a central difference of mu_n-mu_p
+    double dmu_plus=calc_dmu_delta(hd,nbk);
+    double dmu_minus=calc_dmu_delta(-hd,nbk);
+    esy[k]=(dmu_plus-dmu_minus)/hd/8.0;
+
+    // Isospin-symmetric matter
+    neutron->n=nbk/2.0;
+    proton->n=nbk/2.0;
+    calc_e(*neutron,*proton,*eos_thermo);
+    pr[k]=eos_thermo->pr;
+    pon2[k]=pr[k]/nbk/nbk;
+
+    if (k==2) {
+      leoa=eos_thermo->ed/nb;
+      if (neutron->inc_rest_mass) {
+	leoa-=neutron->m/2.0;
+      }
+      if (proton->inc_rest_mass) {
+	leoa-=proton->m/2.0;
+      }
+      lmsom=neutron->ms/neutron->m;
+    }
+  }
+
+  // Five-point first and second derivatives
+  lcomp=9.0*(pr[0]-8.0*pr[1]+8.0*pr[3]-pr[4])/12.0/h;
+  lkprime=27.0*nb*nb*nb*(-pon2[0]+16.0*pon2[1]-30.0*pon2[2]+
+			 16.0*pon2[3]-pon2[4])/12.0/h/h;
+  lesym=esy[2];
+  lslope=3.0*nb*(esy[0]-8.0*esy[1]+8.0*esy[3]-esy[4])/12.0/h;
+  lcurve=9.0*nb*nb*(-esy[0]+16.0*esy[1]-30.0*esy[2]+
+		    16.0*esy[3]-esy[4])/12.0/h/h;
+
+  if (!std::isfinite(lcomp) || !std::isfinite(lkprime) ||
+      !std::isfinite(lesym) || !std::isfinite(lslope) ||
+      !std::isfinite(lcurve)) {
+    O2SCL_CONV_RET("Saturation properties not finite in fsat_props().",
+		   exc_efailed,err_nonconv);
+  }
+  
+  return 0;
+}
+
+int eos_had_base::saturation_fast() {
+  double leoa;
+  n0=fn0(0.0,leoa);
+  return fsat_props(n0,eoa,comp,kprime,msom,esym,esym_slope,esym_curve);
+}
+
 void eos_had_base::gradient_qij(fermion &n, fermion &p, thermo &th,
 				double &qnn, double &qnp, double &qpp, 
 				double &dqnndnn, double &dqnndnp,
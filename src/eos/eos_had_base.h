@@ -350,6 +350,26 @@ namespace o2scl {
 
     /// Skewness in \f$ \mathrm{fm}^{-1} \f$
     double kprime;
+
+    /** \brief Slope of the symmetry energy in \f$ \mathrm{fm}^{-1} \f$
+	(computed only by \ref saturation_fast() )
+    */
+    double esym_slope;
+
+    /** \brief Curvature of the symmetry energy in \f$ \mathrm{fm}^{-1} 
+	\f$ (computed only by \ref saturation_fast() )
+    */
+    double esym_curve;
+
+    /** \brief Relative baryon density step size for \ref fsat_props() 
+	(default \f$ 10^{-2} \f$)
+    */
+    double sat_props_dnb;
+
+    /** \brief Isospin asymmetry step size for \ref fsat_props() 
+	(default \f$ 10^{-3} \f$)
+    */
+    double sat_props_ddelta;
     
     /** \brief If true, call the error handler if msolve() or
 	msolve_de() does not converge (default true)
@@ -570,6 +590,43 @@ namespace o2scl {
 	in the saturation properties.
     */
     virtual int saturation();
+
+    /** \brief Compute the properties of isospin-symmetric matter 
+	at the baryon density \c nb in one pass
+
+	This function computes the binding energy, the
+	incompressibility, the skewness, the reduced neutron effective
+	mass, the symmetry energy, and the slope and curvature of the
+	symmetry energy, sharing a single set of calls to calc_e()
+	between all of them. The pressure and the symmetry energy
+	(computed from a central difference of \f$ \mu_n - \mu_p \f$
+	with step size \ref sat_props_ddelta) are evaluated at the
+	five densities \f$ n_B + k h \f$ for \f$ k=-2,\ldots,2 \f$
+	with \f$ h = \f$ \ref sat_props_dnb \f$ \times n_B \f$,
+	and the density derivatives are obtained from the
+	fourth-order five-point finite difference formulas. This
+	requires 15 calls to calc_e(), much fewer than the nested
+	numerical derivatives used by the separate functions like
+	\ref fcomp(), \ref fkprime(), and \ref fesym_slope().
+
+	Children which have analytic expressions for these
+	quantities (e.g. \ref eos_had_skyrme) overload this function.
+    */
+    virtual int fsat_props(double nb, double &leoa, double &lcomp,
+			   double &lkprime, double &lmsom, double &lesym,
+			   double &lslope, double &lcurve);
+
+    /** \brief Calculate the saturation properties using 
+	\ref fsat_props()
+
+	This computes the saturation density with \ref fn0() and
+	then stores the results from \ref fsat_props() in \ref n0,
+	\ref eoa, \ref comp, \ref kprime, \ref msom, \ref esym,
+	\ref esym_slope, and \ref esym_curve. This is typically much
+	faster than \ref saturation() and also computes the slope and
+	curvature of the symmetry energy.
+    */
+    virtual int saturation_fast();
     //@}
 
     /// \name Functions for calculating physical properties
@@ -427,6 +427,53 @@ double eos_had_skyrme::fkprime(double nb) {
   return ret;
 }
 
+int eos_had_skyrme::fsat_props(double nb, double &leoa, double &lcomp,
+			       double &lkprime, double &lmsom, double &lesym,
+			       double &lslope, double &lcurve) {
+
+  if (parent_method) {
+    return eos_had_base::fsat_props(nb,leoa,lcomp,lkprime,lmsom,
+				    lesym,lslope,lcurve);
+  }
+
+  double mnuc=neutron->m+proton->m;
+  double t3p=(a+b)*t3;
+  double kr23=0.6/mnuc*pow(1.5*pi2*nb,2.0/3.0);
+  double beta=mnuc/4.0*(0.25*(3.0*t1+5.0*t2)+t2*x2);
+  double na=pow(nb,1.0+alpha);
+
+  // Exponents and coefficients of the terms in the binding
+  // energy and the symmetry energy
+  const size_t nterms=4;
+  double pw[nterms]={2.0/3.0,5.0/3.0,1.0,1.0+alpha};
+  double ce[nterms]={kr23,kr23*beta*nb,0.375*t0*nb,0.0625*t3p*na};
+  double cs[nterms]={5.0/9.0*kr23,
+		     10.0/6.0*mnuc*kr23*nb*(t2/6.0*(1.0+1.25*x2)-
+					    0.125*t1*x1),
+		     -0.25*t0*(0.5+x0)*nb,
+		     -b*t3/24.0*(0.5+x3)*na-a/96.0*na*t3*
+		     (2.0-alpha*(3.0+alpha)+x3*(4.0+alpha*(3.0+alpha)))};
+
+  leoa=0.0;
+  lcomp=0.0;
+  lkprime=0.0;
+  lesym=0.0;
+  lslope=0.0;
+  lcurve=0.0;
+  for(size_t i=0;i<nterms;i++) {
+    double p=pw[i];
+    leoa+=ce[i];
+    lcomp+=9.0*p*(p+1.0)*ce[i];
+    lkprime+=27.0*p*(p-1.0)*(p-2.0)*ce[i];
+    lesym+=cs[i];
+    lslope+=3.0*p*cs[i];
+    lcurve+=9.0*p*(p-1.0)*cs[i];
+  }
+  lmsom=1.0/(1.0+beta*nb);
+
+  return 0;
+}
+
 int eos_had_skyrme::calpar(double gt0, double gt3, double galpha,
 		       double gt1, double gt2) {
 
@@ -336,6 +336,21 @@ namespace o2scl {
 	\f]
     */
     virtual double fkprime(double nb);
+
+    /** \brief Compute the properties of isospin-symmetric matter 
+	exactly from the parameters
+
+	The binding energy and the symmetry energy are sums of terms
+	of the form \f$ c n_B^{p} \f$, so the incompressibility, the
+	skewness, and the slope and curvature of the symmetry energy
+	are computed exactly from the coefficients and exponents of
+	the expressions given in \ref feoa() and \ref fesym(). If
+	\ref parent_method is true, then this calls \ref
+	eos_had_base::fsat_props() instead.
+    */
+    virtual int fsat_props(double nb, double &leoa, double &lcomp,
+			   double &lkprime, double &lmsom, double &lesym,
+			   double &lslope, double &lcurve);
     //@}
 
     /** \brief Calculate \f$ t_0,t_1,t_2,t_3 \f$ and \f$ \alpha \f$ from 
@@ -288,6 +288,37 @@ int main(void) {
   sk.parent_method=false;
   cout << endl;
 
+  cout << "Compare exact and numerical fsat_props():" << endl;
+
+  for(n0=0.08;n0<0.51;n0*=2.0) {
+    double se, sc, sk2, sm, ss, sl, sq;
+    double pe, pc, pk2, pm, ps, pl, pq;
+    sk.fsat_props(n0,se,sc,sk2,sm,ss,sl,sq);
+    sk.parent_method=true;
+    sk.fsat_props(n0,pe,pc,pk2,pm,ps,pl,pq);
+    sk.parent_method=false;
+    t.test_rel(se,pe,1.0e-6,"fsat_props eoa");
+    t.test_rel(sc,pc,1.0e-6,"fsat_props comp");
+    t.test_rel(sk2,pk2,1.0e-4,"fsat_props kprime");
+    t.test_rel(sm,pm,1.0e-6,"fsat_props msom");
+    t.test_rel(ss,ps,1.0e-5,"fsat_props esym");
+    t.test_rel(sl,pl,1.0e-5,"fsat_props esym_slope");
+    t.test_abs(sq,pq,1.0e-4,"fsat_props esym_curve");
+    t.test_rel(sc,sk.fcomp(n0),1.0e-10,"fsat_props comp 2");
+    t.test_rel(sk2,sk.fkprime(n0),1.0e-10,"fsat_props kprime 2");
+    sk.parent_method=true;
+    t.test_rel(sl,sk.fesym_slope(n0),1.0e-5,"fsat_props esym_slope 2");
+    sk.parent_method=false;
+  }
+
+  sk.saturation();
+  double sat_n0=sk.n0, sat_comp=sk.comp, sat_esym=sk.esym;
+  sk.saturation_fast();
+  t.test_rel(sk.n0,sat_n0,1.0e-8,"saturation_fast n0");
+  t.test_rel(sk.comp,sat_comp,1.0e-6,"saturation_fast comp");
+  t.test_rel(sk.esym,sat_esym,1.0e-6,"saturation_fast esym");
+  cout << endl;
+
 #ifdef O2SCL_NEVER_DEFINED
 
   cout << "Compare model PeHF with known saturation values: " << endl;
@@ -28,6 +28,7 @@
 */
 
 #include <string>
+#include <vector>
 
 #include <o2scl/jacobian.h>
 #include <o2scl/mm_funct.h>
@@ -40,6 +41,18 @@ namespace o2scl {
   typedef std::function<
     double(size_t,const boost::numeric::ublas::vector<double> &, 
 	   double)> fit_funct;
+
+  /** \brief Vectorized fitting function typedef (C++11 version)
+
+      The arguments are the number of parameters, the parameters,
+      the number of data points, the abscissae, and the vector in
+      which to store the model values at the abscissae. See
+      \ref chi_fit_vfunct .
+  */
+  typedef std::function<
+    void(size_t,const boost::numeric::ublas::vector<double> &,size_t,
+	 const boost::numeric::ublas::vector<double> &,
+	 boost::numeric::ublas::vector<double> &)> fit_vfunct;
   
   /** \brief String fitting function
       
@@ -183,7 +196,8 @@ namespace o2scl {
       from \ref jacobian_gsl. This default is identical to the GSL
       approach, except that the default value of \ref
       jacobian_gsl::epsmin is non-zero. See \ref jacobian_gsl for more
-      details.
+      details. The columns of the Jacobian can be computed in
+      parallel using \ref set_threads().
 
       Default template arguments
       - \c vec_t - \ref boost::numeric::ublas::vector \< double \>
@@ -240,6 +254,23 @@ namespace o2scl {
     return;
   }
 
+  /** \brief Compute the columns of the Jacobian using \c nt
+      threads
+
+      If \c O2SCL_OPENMP is defined and \c nt is larger than 1, the
+      parameter perturbations for the numerical Jacobian are
+      evaluated simultaneously (see \ref
+      jacobian_gsl::set_function_threads()), in which case the
+      fitting function must be safe to call from several threads at
+      once. A value of 0 or 1 returns to the serial computation.
+  */
+  void set_threads(size_t nt) {
+    std::vector<std::function<int(size_t,const vec_t &,vec_t &)> > fv;
+    if (nt>1) fv.resize(nt,mfm);
+    auto_jac.set_function_threads(fv);
+    return;
+  }
+
   /** \brief Return \f$ \chi^2 \f$
    */
   virtual double chi2(size_t np, const vec_t &p) {
@@ -312,6 +343,157 @@ namespace o2scl {
   chi_fit_funct(const chi_fit_funct &);
   chi_fit_funct& operator=(const chi_fit_funct&);
   
+#endif
+  
+  };
+
+  /** \brief Fitting function based on one-dimensional data with a
+      vectorized model function and a numerical Jacobian
+
+      This class is the same as \ref chi_fit_funct except that the
+      model is specified by a function like \ref fit_vfunct which
+      computes the model at all of the abscissae in one call. This
+      allows the model to reuse intermediate results for all of the
+      data points and avoids a function call for each point. The
+      columns of the Jacobian can be computed in parallel using \ref
+      set_threads().
+
+      Default template arguments
+      - \c vec_t - \ref boost::numeric::ublas::vector \< double \>
+      - \c mat_t - \ref boost::numeric::ublas::matrix \< double \>
+      - \c func_t - \ref fit_vfunct
+  */
+  template<class vec_t=boost::numeric::ublas::vector<double>, 
+    class mat_t=boost::numeric::ublas::matrix<double>, 
+    class fit_func_t=fit_vfunct> class chi_fit_vfunct : 
+    public gen_fit_funct<vec_t,mat_t> {
+    
+  public:
+  
+  /** \brief Create an object with specified data and specified 
+      fitting function
+  */
+  chi_fit_vfunct(size_t ndat, const vec_t &xdat, const vec_t &ydat, 
+		 const vec_t &yerr, fit_func_t &fun) {
+    ndat_=ndat;
+    xdat_=&xdat;
+    ydat_=&ydat;
+    yerr_=&yerr;
+    fun_=&fun;
+    
+    mfm=std::bind(std::mem_fn<int(size_t,const vec_t &,vec_t &)>
+		  (&chi_fit_vfunct::jac_mm_funct),this,
+		  std::placeholders::_1,std::placeholders::_2,
+		  std::placeholders::_3);
+
+    auto_jac.set_function(mfm);
+  }
+
+  /** \brief Set the data to be fit 
+   */
+  void set_data(size_t ndat, const vec_t &xdat, const vec_t &ydat, 
+		const vec_t &yerr) {
+    ndat_=ndat;
+    xdat_=&xdat;
+    ydat_=&ydat;
+    yerr_=&yerr;
+    return;
+  }
+
+  /** \brief Set the fitting function
+   */
+  void set_func(fit_func_t &fun) {
+    fun_=&fun;
+    return;
+  }
+
+  /** \brief Compute the columns of the Jacobian using \c nt
+      threads
+
+      This is the same as \ref chi_fit_funct::set_threads().
+  */
+  void set_threads(size_t nt) {
+    std::vector<std::function<int(size_t,const vec_t &,vec_t &)> > fv;
+    if (nt>1) fv.resize(nt,mfm);
+    auto_jac.set_function_threads(fv);
+    return;
+  }
+
+  /** \brief Return \f$ \chi^2 \f$
+   */
+  virtual double chi2(size_t np, const vec_t &p) {
+    vec_t f(ndat_);
+    operator()(np,p,ndat_,f);
+    double ret=0.0;
+    for(size_t i=0;i<ndat_;i++) {
+      ret+=f[i]*f[i];
+    }
+    return ret;
+  }
+  
+  /** \brief Using parameters in \c p, compute the 
+      relative deviations in \c f
+  */
+  virtual void operator()(size_t np, const vec_t &p, size_t nd, vec_t &f) {
+    
+    // Compute the model values in f and then convert them
+    // to deviations
+    (*fun_)(np,p,nd,*xdat_,f);
+    for(size_t i=0;i<nd;i++) {
+      f[i]=(f[i]-(*ydat_)[i])/((*yerr_)[i]);
+    }
+    return;
+  }
+  
+  /** \brief Using parameters in \c p, compute the Jacobian
+      in \c J
+  */
+  virtual void jac(size_t np, vec_t &p, size_t nd, vec_t &f,
+		   mat_t &J) {
+    
+    auto_jac(np,p,nd,f,J);
+    
+    return;
+  }
+
+  /// Return the number of data points
+  virtual size_t get_ndata() {
+    return ndat_;
+  }
+
+  /// Automatic Jacobian object
+  jacobian_gsl<std::function<int(size_t,const vec_t &,vec_t &)>,
+  vec_t,mat_t> auto_jac;
+
+#ifndef DOXYGEN_INTERNAL
+  
+  protected:
+
+  /// Reformulate <tt>operator()</tt> into a \ref mm_funct object
+  int jac_mm_funct(size_t np, const vec_t &p, vec_t &f) {
+    operator()(np,p,ndat_,f);
+    return 0;
+  }
+  
+  /// Function object for Jacobian object
+  std::function<int(size_t,const vec_t &,vec_t &)> mfm;
+  
+  /// \name Data and uncertainties
+  //@{
+  size_t ndat_;
+  const vec_t *xdat_;
+  const vec_t *ydat_;
+  const vec_t *yerr_;
+  //@}
+
+  /// Fitting function
+  fit_func_t *fun_;
+  
+  private:
+  
+  chi_fit_vfunct(const chi_fit_vfunct &);
+  chi_fit_vfunct& operator=(const chi_fit_vfunct&);
+  
 #endif
   
   };
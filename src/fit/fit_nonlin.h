@@ -900,6 +900,14 @@ namespace o2scl {
       \Phi(x) = || F(x) ||^2
       \f]
 
+      The workspace vectors and matrices are allocated only when
+      the number of parameters or data points changes, so repeated
+      fits of the same size do not allocate memory. For expensive
+      models, \ref chi_fit_vfunct computes the model at all of the
+      data points in one function call and both it and \ref
+      chi_fit_funct can compute the columns of the numerical
+      Jacobian in parallel (see \ref chi_fit_funct::set_threads()).
+
       Default template arguments
       - \c func_t - \ref gen_fit_funct\<\>
       - \c vec_t - \ref boost::numeric::ublas::vector \<double \>
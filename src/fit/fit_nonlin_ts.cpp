@@ -138,6 +138,14 @@ double func(size_t np, const ubvector &p, double x) {
   return p[0]*exp(-p[1]*x)+p[2];
 }
 
+void vfunc(size_t np, const ubvector &p, size_t nd, const ubvector &x,
+	   ubvector &y) {
+  for(size_t i=0;i<nd;i++) {
+    y[i]=p[0]*exp(-p[1]*x[i])+p[2];
+  }
+  return;
+}
+
 int main(void) {
   test_mgr tm;
   tm.set_output_level(1);
@@ -469,6 +477,40 @@ int main(void) {
     cout << endl;
   }
 
+  //----------------------------------------------------------------
+  // O2scl, unscaled version with a vectorized model and 
+  // several copies of the function for the Jacobian
+
+  if (true) {
+
+    cout << "O2scl unscaled fit() with chi_fit_vfunct." << endl;
+
+    fit_vfunct fvf=vfunc;
+    chi_fit_vfunct<> cvf(40,axdat,ay,asigma,fvf);
+    cvf.auto_jac.set_epsrel(1.0e-4);
+    cvf.auto_jac.set_epsmin(0.0);
+    cvf.set_threads(4);
+
+    fit_nonlin<> gf;
+    gf.use_scaled=false;
+    
+    double chi2;
+    ubmatrix mycovar(3,3);
+
+    double x[3]={1.0,0.0,0.0};
+    ubvector ax(3);
+    vector_copy(3,x,ax);
+
+    gf.fit(3,ax,mycovar,chi2,cvf);
+
+    tm.test_rel(ax[0],x0_u[x0_u.size()-1],1.0e-11,"vfunct x0");
+    tm.test_rel(ax[1],x1_u[x1_u.size()-1],1.0e-11,"vfunct x1");
+    tm.test_rel(ax[2],x2_u[x2_u.size()-1],1.0e-11,"vfunct x2");
+    tm.test_rel(chi2red_u,chi2/(n-3),1.0e-10,"vfunct chi2");
+
+    cout << endl;
+  }
+
 #endif
   
   tm.report();
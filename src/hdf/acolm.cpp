@@ -3615,6 +3615,11 @@ int acol_manager::comm_contours(std::vector<std::string> &sv, bool itive_com) {
 
 int acol_manager::comm_show_units(std::vector<std::string> &sv, 
 				  bool itive_com) {
+  if (cng.natural_units) {
+    cout << "Allowing natural units (c=hbar=kB=1)? Yes." << endl;
+  } else {
+    cout << "Allowing natural units (c=hbar=kB=1)? No." << endl;
+  }
   if (cng.use_gnu_units) {
     cout << "Using GNU units? Yes." << endl;
     cout << "Variable 'unit_fname': " << unit_fname << endl;
@@ -5219,7 +5224,8 @@ int acol_manager::comm_generic(std::vector<std::string> &sv, bool itive_com) {
   if (ctype=="table") {
     
     if (sv2[1]!=((std::string)"cin")) {
-      table_obj.read_generic(ifs,verbose);
+      ifs.close();
+      table_obj.read_generic_file(sv2[1],verbose);
     } else {
       table_obj.read_generic(std::cin,verbose);
     }
@@ -5547,10 +5553,13 @@ int acol_manager::comm_stats(std::vector<std::string> &sv, bool itive_com) {
 
   const vector<double> &cref=table_obj.get_column(i1);
   cout << "N        : " << table_obj.get_nlines() << endl;
-  cout << "Sum      : " << vector_mean(table_obj.get_nlines(),cref)*
-    table_obj.get_nlines() << endl;
-  cout << "Mean     : " << vector_mean(table_obj.get_nlines(),cref) << endl;
-  cout << "Std. dev.: " << vector_stddev(table_obj.get_nlines(),cref) << endl;
+  moment_accum ma;
+  ma.add_vector(table_obj.get_nlines(),cref);
+  cout << "Sum      : " << ma.mean()*table_obj.get_nlines() << endl;
+  cout << "Mean     : " << ma.mean() << endl;
+  cout << "Std. dev.: " << ma.stddev() << endl;
+  cout << "Skewness : " << ma.skew() << endl;
+  cout << "Kurtosis : " << ma.kurtosis() << endl;
   size_t ix;
   double val;
   vector_min(table_obj.get_nlines(),cref,ix,val);
@@ -1604,6 +1604,73 @@ int hdf_file::setd_arr(std::string name, size_t n, const double *d) {
   return 0;
 }
 
+int hdf_file::setd_arr_append(std::string name, size_t n,
+			       const double *d) {
+  
+  if (write_access==false) {
+    O2SCL_ERR2("File not opened with write access in ",
+	       "hdf_file::setd_arr_append().",exc_efailed);
+  }
+
+  hid_t dset;
+  
+  H5E_BEGIN_TRY
+    {
+      // See if the dataspace already exists first
+      dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+    } 
+  H5E_END_TRY 
+#ifdef O2SCL_NEVER_DEFINED
+    {
+    }
+#endif
+
+  // If it doesn't exist, create it
+  if (dset<0) {
+    return setd_arr(name,n,d);
+  }
+  
+  if (n==0) {
+    H5Dclose(dset);
+    return 0;
+  }
+  
+  // Get current dimensions
+  hid_t space=H5Dget_space(dset);  
+  hsize_t dims;
+  int ndims=H5Sget_simple_extent_dims(space,&dims,0);
+  H5Sclose(space);
+  
+  // Set error if this dataset is more than 1-dimensional
+  if (ndims!=1) {
+    H5Dclose(dset);
+    O2SCL_ERR2("Tried to append to a multidimensional dataset in ",
+	       "hdf_file::setd_arr_append().",exc_einval);
+  }
+
+  // Extend the dataset
+  hsize_t new_dims=dims+n;
+  int status=H5Dset_extent(dset,&new_dims);
+  if (status<0) {
+    H5Dclose(dset);
+    O2SCL_ERR2("Could not extend dataset (not chunked?) in ",
+	       "hdf_file::setd_arr_append().",exc_efailed);
+  }
+
+  // Select the new part of the dataset and write the data
+  hid_t fspace=H5Dget_space(dset);
+  hsize_t start=dims, count=n;
+  status=H5Sselect_hyperslab(fspace,H5S_SELECT_SET,&start,0,&count,0);
+  hid_t mspace=H5Screate_simple(1,&count,0);
+  status=H5Dwrite(dset,H5T_NATIVE_DOUBLE,mspace,fspace,H5P_DEFAULT,d);
+
+  status=H5Sclose(mspace);
+  status=H5Sclose(fspace);
+  status=H5Dclose(dset);
+  
+  return 0;
+}
+
 int hdf_file::setf_arr(std::string name, size_t n, const float *f) { 
   
   if (write_access==false) {
@@ -2851,6 +2918,49 @@ int hdf_file::getd_vec_prealloc(std::string name, size_t n, double *d) {
   return 0;
 }
 
+int hdf_file::getd_vec_part(std::string name, size_t offset, size_t n, 
+			    double *d) {
+      
+  // See if the dataspace already exists first
+  hid_t dset=H5Dopen(current,name.c_str(),H5P_DEFAULT);
+      
+  // Get space requirements, to make sure the requested 
+  // part is inside the array
+  hid_t space=H5Dget_space(dset);  
+  hsize_t dims[1];
+  int ndims=H5Sget_simple_extent_dims(space,dims,0);
+
+  if (offset+n>dims[0]) {
+    H5Sclose(space);
+    H5Dclose(dset);
+    O2SCL_ERR2("Requested elements beyond end of array ",
+	       "in hdf_file::getd_vec_part().",exc_einval);
+  }
+
+  int status=0;
+  if (n>0) {
+    
+    // Select the part of the array in the file
+    hsize_t start[1]={offset};
+    hsize_t count[1]={n};
+    status=H5Sselect_hyperslab(space,H5S_SELECT_SET,start,0,count,0);
+    
+    // Create a memory space for the data
+    hid_t mem_space=H5Screate_simple(1,count,0);
+    
+    // Read the data
+    status=H5Dread(dset,H5T_NATIVE_DOUBLE,mem_space,space,
+		   H5P_DEFAULT,d);
+    
+    status=H5Sclose(mem_space);
+  }
+  
+  status=H5Sclose(space);
+  status=H5Dclose(dset);
+      
+  return 0;
+}
+
 int hdf_file::geti_vec_prealloc(std::string name, size_t n, int *i) {
       
   // See if the dataspace already exists first
@@ -891,6 +891,15 @@ namespace o2scl_hdf {
     /// Set a double array named \c name of size \c n to value \c d
     int setd_arr(std::string name, size_t n, const double *d);
 
+    /** \brief Append the \c n values in \c d to the end of the
+	double array named \c name
+
+	If the array does not exist, it is created with \ref
+	setd_arr(). Otherwise, the array must have been created in
+	the chunked format, and only the new values are written.
+    */
+    int setd_arr_append(std::string name, size_t n, const double *d);
+
     /// Set a float array named \c name of size \c n to value \c f
     int setf_arr(std::string name, size_t n, const float *f);
 
@@ -959,6 +968,16 @@ namespace o2scl_hdf {
     /// Get an integer array \c i pre-allocated to have size \c n
     int geti_vec_prealloc(std::string name, size_t n, int *i);
 
+    /** \brief Get \c n elements of the double array named \c name,
+	beginning at index \c offset, and store them in \c d 
+	pre-allocated to have size \c n
+
+	This reads only the specified part of the array from the
+	file, so that large datasets can be processed in chunks.
+    */
+    int getd_vec_part(std::string name, size_t offset, size_t n, 
+		      double *d);
+
     /// Get a double matrix \c d pre-allocated to have size <tt>(n,m)</tt>
     int getd_mat_prealloc(std::string name, size_t n, size_t m, double *d);
 
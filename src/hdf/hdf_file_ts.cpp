@@ -823,6 +823,29 @@ int main(void) {
   }
 
 #endif
+
+  // Test appending to a dataset
+  {
+    double d[6]={1.0,2.0,3.0,4.0,5.0,6.0};
+    std::vector<double> dv;
+    
+    hdf_file hf;
+    hf.open_or_create("hdf_file_app.o2");
+    hf.setd_arr_append("app",4,d);
+    hf.close();
+    
+    hf.open("hdf_file_app.o2",true);
+    hf.setd_arr_append("app",2,&(d[4]));
+    hf.setd_arr_append("app",0,d);
+    hf.close();
+
+    hf.open("hdf_file_app.o2");
+    hf.getd_vec("app",dv);
+    hf.close();
+    
+    t.test_gen(dv.size()==6,"append size");
+    t.test_rel_vec(6,dv,d,1.0e-12,"append data");
+  }
   
   t.report();
 
@@ -24,6 +24,8 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
+
 #include <o2scl/hdf_io.h>
 
 using namespace std;
@@ -423,6 +425,140 @@ void o2scl_hdf::hdf_input(hdf_file &hf, hist_2d &h, std::string name) {
   return;
 }
 
+// Open the table named \c name for reading in chunks, check
+// that the columns in \c req exist, and return the number of lines.
+// The current id is set to the data group of the table.
+static size_t hdf_fill_open(hdf_file &hf, std::string name,
+			    std::vector<std::string> &req,
+			    hid_t &top, hid_t &group, hid_t &group2) {
+  
+  // If no name specified, find name of first group of specified type
+  if (name.length()==0) {
+    hf.find_group_by_type("table",name);
+    if (name.length()==0) {
+      O2SCL_ERR2("No object of type table found in ",
+		 "o2scl_hdf::hdf_fill_open().",exc_efailed);
+    }
+  }
+  
+  // Open main group
+  top=hf.get_current_id();
+  group=hf.open_group(name);
+  hf.set_current_id(group);
+  
+  // Check typename
+  string type;
+  hf.gets_fixed("o2scl_type",type);
+  if (type!="table") {
+    O2SCL_ERR2("Typename in HDF group does not match class in ",
+	       "o2scl_hdf::hdf_fill_open().",exc_efailed);
+  }
+
+  // Check that the columns are present
+  std::vector<std::string> cols;
+  hf.gets_vec("col_names",cols);
+  for(size_t i=0;i<req.size();i++) {
+    if (std::find(cols.begin(),cols.end(),req[i])==cols.end()) {
+      hf.close_group(group);
+      hf.set_current_id(top);
+      O2SCL_ERR((((string)"Column '")+req[i]+"' not found in "+
+		 "o2scl_hdf::hdf_fill_open().").c_str(),exc_enotfound);
+    }
+  }
+
+  // Get number of lines
+  int nlines;
+  hf.geti("nlines",nlines);
+  
+  // Open data group
+  group2=hf.open_group("data");
+  hf.set_current_id(group2);
+
+  return nlines;
+}
+
+void o2scl_hdf::hdf_fill_hist(hdf_file &hf, hist &h, std::string name,
+			      std::string colx, std::string colw,
+			      size_t n_chunk) {
+
+  if (h.size()==0) {
+    O2SCL_ERR2("Histogram bins not set in ",
+	       "o2scl_hdf::hdf_fill_hist().",exc_einval);
+  }
+  if (n_chunk==0) n_chunk=1;
+
+  std::vector<std::string> req;
+  req.push_back(colx);
+  if (colw.length()>0) req.push_back(colw);
+  
+  hid_t top, group, group2;
+  size_t nlines=hdf_fill_open(hf,name,req,top,group,group2);
+
+  std::vector<double> x(std::min(n_chunk,nlines)), w;
+  if (colw.length()>0) w.resize(x.size());
+
+  // Read the table in chunks and add each chunk to the histogram
+  for(size_t offset=0;offset<nlines;offset+=n_chunk) {
+    size_t n=std::min(n_chunk,nlines-offset);
+    hf.getd_vec_part(colx,offset,n,&x[0]);
+    if (colw.length()>0) {
+      hf.getd_vec_part(colw,offset,n,&w[0]);
+      h.update_many(n,x,w);
+    } else {
+      h.update_many(n,x);
+    }
+  }
+
+  // Close groups and return location to previous value
+  hf.close_group(group2);
+  hf.close_group(group);
+  hf.set_current_id(top);
+
+  return;
+}
+
+void o2scl_hdf::hdf_fill_hist_2d(hdf_file &hf, hist_2d &h, std::string name,
+				 std::string colx, std::string coly,
+				 std::string colw, size_t n_chunk) {
+  
+  if (h.size_x()==0) {
+    O2SCL_ERR2("Histogram bins not set in ",
+	       "o2scl_hdf::hdf_fill_hist_2d().",exc_einval);
+  }
+  if (n_chunk==0) n_chunk=1;
+
+  std::vector<std::string> req;
+  req.push_back(colx);
+  req.push_back(coly);
+  if (colw.length()>0) req.push_back(colw);
+  
+  hid_t top, group, group2;
+  size_t nlines=hdf_fill_open(hf,name,req,top,group,group2);
+
+  std::vector<double> x(std::min(n_chunk,nlines)), y(x.size()), w;
+  if (colw.length()>0) w.resize(x.size());
+
+  // Read the table in chunks and add each chunk to the histogram
+  for(size_t offset=0;offset<nlines;offset+=n_chunk) {
+    size_t n=std::min(n_chunk,nlines-offset);
+    hf.getd_vec_part(colx,offset,n,&x[0]);
+    hf.getd_vec_part(coly,offset,n,&y[0]);
+    if (colw.length()>0) {
+      hf.getd_vec_part(colw,offset,n,&w[0]);
+      h.update_many(n,x,y,w);
+    } else {
+      h.update_many(n,x,y);
+    }
+  }
+
+  // Close groups and return location to previous value
+  hf.close_group(group2);
+  hf.close_group(group);
+  hf.set_current_id(top);
+
+  return;
+}
+
 void o2scl_hdf::hdf_output(o2scl_hdf::hdf_file &hf, table3d &t, 
 			   std::string name) {
 
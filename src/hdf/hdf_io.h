@@ -247,6 +247,29 @@ namespace o2scl_hdf {
   void hdf_output(hdf_file &hf, o2scl::hist_2d &h, std::string name);
   /// Input a \ref o2scl::hist_2d object from a \ref hdf_file
   void hdf_input(hdf_file &hf, o2scl::hist_2d &h, std::string name="");
+
+  /** \brief Add the data in column \c colx of the table named 
+      \c name in a \ref hdf_file to the histogram \c h
+
+      The table is read from the file in chunks of at most 
+      \c n_chunk lines, so that the full table does not need 
+      to be stored in memory. The bins of \c h must already be 
+      set. If \c colw is not empty, then the values in that column
+      are used as the weights. If \c name is empty, the first 
+      table in the current group is used.
+  */
+  void hdf_fill_hist(hdf_file &hf, o2scl::hist &h, std::string name,
+		     std::string colx, std::string colw="",
+		     size_t n_chunk=1000000);
+
+  /** \brief Add the data in columns \c colx and \c coly of the
+      table named \c name in a \ref hdf_file to the histogram \c h
+
+      This function works in the same way as \ref hdf_fill_hist() .
+  */
+  void hdf_fill_hist_2d(hdf_file &hf, o2scl::hist_2d &h, std::string name,
+			std::string colx, std::string coly,
+			std::string colw="", size_t n_chunk=1000000);
   /// Output a \ref o2scl::table3d object to a \ref hdf_file
   void hdf_output(hdf_file &hf, o2scl::table3d &h, std::string name);
   /// Input a \ref o2scl::table3d object from a \ref hdf_file
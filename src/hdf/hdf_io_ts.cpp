@@ -94,6 +94,52 @@ int main(void) {
     t.test_gen(tab.get_unit("a")==tab2.get_unit("a"),"unit");
   }
 
+  // Test of filling histograms from a table in a file in chunks
+  {
+    table<> tab;
+    tab.line_of_names("x y w");
+    for(size_t i3=0;i3<1000;i3++) {
+      double d=((double)i3);
+      double line[3]={sin(d),cos(d),1.0+d/1000.0};
+      tab.line_of_data(3,line);
+    }
+
+    hdf_file hf;
+    hf.open_or_create("table_hist.o2");
+    hdf_output(hf,tab,"table_hist");
+    hf.close();
+
+    hist h, h2;
+    h.set_bin_edges(uniform_grid_end<>(-1.0,1.0,20));
+    h2.set_bin_edges(uniform_grid_end<>(-1.0,1.0,20));
+    hf.open("table_hist.o2");
+    hdf_fill_hist(hf,h,"table_hist","x","w",77);
+    hf.close();
+    h2.update_many(tab.get_nlines(),tab["x"],tab["w"]);
+    for(size_t i3=0;i3<20;i3++) {
+      t.test_rel(h.get_wgt_i(i3),h2.get_wgt_i(i3),1.0e-12,"fill hist");
+    }
+
+    hist_2d h3, h4;
+    h3.set_bin_edges(uniform_grid_end<>(-1.0,1.0,10),
+		     uniform_grid_end<>(-1.0,1.0,10));
+    h4.set_bin_edges(uniform_grid_end<>(-1.0,1.0,10),
+		     uniform_grid_end<>(-1.0,1.0,10));
+    hf.open("table_hist.o2");
+    hdf_fill_hist_2d(hf,h3,"","x","y","",300);
+    hf.close();
+    for(size_t i3=0;i3<tab.get_nlines();i3++) {
+      h4.update(tab.get("x",i3),tab.get("y",i3));
+    }
+    t.test_rel(h3.sum_wgts(),1000.0,1.0e-12,"fill hist_2d sum");
+    for(size_t i3=0;i3<10;i3++) {
+      for(size_t j3=0;j3<10;j3++) {
+	t.test_rel(h3.get_wgt_i(i3,j3),h4.get_wgt_i(i3,j3),1.0e-12,
+		   "fill hist_2d");
+      }
+    }
+  }
+
   t.report();
 
   return 0;
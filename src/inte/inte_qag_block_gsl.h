@@ -0,0 +1,567 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Jerry Gagelman and Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_GSL_INTE_QAG_BLOCK_H
+#define O2SCL_GSL_INTE_QAG_BLOCK_H
+
+/** \file inte_qag_block_gsl.h
+    \brief File defining \ref o2scl::inte_qag_block_gsl
+*/
+#include <vector>
+#include <algorithm>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
+#include <o2scl/inte.h>
+#include <o2scl/inte_kronrod_gsl.h>
+#include <o2scl/funct.h>
+#include <o2scl/string_conv.h>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief Adaptive integration with batched function evaluations
+      (GSL)
+
+      This class performs the same adaptive bisection as \ref
+      inte_qag_gsl, but evaluates the integrand in blocks. Whenever
+      the subinterval with the largest error estimate has not yet
+      been evaluated, the \ref n_block subintervals with the largest
+      error estimates are bisected speculatively and all of the
+      Gauss-Kronrod abscissae for the resulting halves are passed to
+      the integrand in a single batched call. The bisections are then
+      applied to the workspace one at a time in exactly the order
+      chosen by \ref inte_qag_gsl, so the result, the error estimate,
+      and the number of iterations are identical to those from \ref
+      inte_qag_gsl with the same rule and tolerances. Speculative
+      evaluations which are not used in the current iteration are
+      kept until the corresponding subinterval is bisected, and are
+      only wasted if the integration finishes first.
+
+      The integrand can be specified either as an object of type
+      \c func_t, in which case the abscissae of a block are evaluated
+      one at a time (or using \ref n_threads OpenMP threads if
+      OpenMP support is enabled), or as an object of type \ref
+      funct_batch using \ref integ_err_batch(). When more than one
+      thread is used, the integrand must be safe to call from
+      several threads simultaneously.
+
+      This class is most useful when the integrand is expensive
+      relative to the overhead of the workspace, or when the
+      integrand can be evaluated more efficiently for several points
+      at once (e.g. vectorized or nested integrals).
+  */
+  template<class func_t=funct> class inte_qag_block_gsl :
+  public inte_kronrod_gsl<func_t> {
+
+  public:
+
+  inte_qag_block_gsl() {
+    n_block=8;
+    n_threads=1;
+    last_nodes=0;
+  }
+
+  virtual ~inte_qag_block_gsl() {}
+
+  /** \brief The number of subintervals bisected in each
+      block (default 8)
+
+      If this is zero, then it is treated as though it were one.
+  */
+  size_t n_block;
+
+  /** \brief The number of OpenMP threads used to evaluate a block
+      when the integrand is of type \c func_t (default 1)
+  */
+  size_t n_threads;
+
+  /** \brief The number of integrand evaluations in the last
+      integration, including unused speculative evaluations
+  */
+  size_t last_nodes;
+
+  /** \brief Integrate function \c func from \c a to \c b and place
+      the result in \c res and the error in \c err
+  */
+  virtual int integ_err(func_t &func, double a, double b,
+			double &res, double &err) {
+    funct_batch bf=std::bind
+      (std::mem_fn<int(func_t &,size_t,const double *,double *)>
+       (&inte_qag_block_gsl<func_t>::eval_batch),this,std::ref(func),
+       std::placeholders::_1,std::placeholders::_2,
+       std::placeholders::_3);
+    return qag_block(bf,a,b,this->tol_abs,this->tol_rel,&res,&err);
+  }
+
+  /** \brief Integrate the batched function \c bfunc from \c a to
+      \c b and place the result in \c res and the error in \c err
+  */
+  virtual int integ_err_batch(funct_batch &bfunc, double a, double b,
+			      double &res, double &err) {
+    return qag_block(bfunc,a,b,this->tol_abs,this->tol_rel,&res,&err);
+  }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+  /// Results for the two halves of each bisected subinterval
+  std::vector<double> spec;
+
+  /// If true, the corresponding entry in \ref spec is valid
+  std::vector<bool> spec_valid;
+
+  /// Abscissae for the current block
+  std::vector<double> x_block;
+
+  /// Function values for the current block
+  std::vector<double> f_block;
+
+  /// Workspace indices of the subintervals in the current block
+  std::vector<size_t> ix_block;
+
+  /** \brief Evaluate \c func at \c n points, possibly in parallel
+   */
+  int eval_batch(func_t &func, size_t n, const double *x, double *y) {
+#ifdef O2SCL_OPENMP
+    int nt=(int)n_threads;
+    if (nt<1) nt=1;
+#pragma omp parallel for num_threads(nt) if (nt>1)
+    for(int i=0;i<((int)n);i++) {
+      y[i]=func(x[i]);
+    }
+#else
+    for(size_t i=0;i<n;i++) {
+      y[i]=func(x[i]);
+    }
+#endif
+    return 0;
+  }
+
+  /// Number of abscissae in the current Gauss-Kronrod rule
+  size_t n_nodes() {
+    return 2*this->n_gk-1;
+  }
+
+  /** \brief Store the Gauss-Kronrod abscissae for the interval
+      from \c a to \c b in \c x
+
+      The ordering matches the order of the function evaluations
+      in \ref inte_kronrod_gsl::gauss_kronrod_base().
+  */
+  void gk_nodes(double a, double b, double *x) {
+    const double center=0.5*(a+b);
+    const double half_length=0.5*(b-a);
+    size_t k=0;
+    x[k++]=center;
+    for (int j=0; j < (this->n_gk-1) / 2; j++) {
+      const double abscissa=half_length*this->x_gk[j*2+1];
+      x[k++]=center-abscissa;
+      x[k++]=center+abscissa;
+    }
+    for (int j=0; j < this->n_gk / 2; j++) {
+      const double abscissa=half_length*this->x_gk[j*2];
+      x[k++]=center-abscissa;
+      x[k++]=center+abscissa;
+    }
+    return;
+  }
+
+  /** \brief Compute the Gauss-Kronrod sums for the interval
+      from \c a to \c b given the function values in \c f
+
+      This performs the same floating-point operations in the same
+      order as \ref inte_kronrod_gsl::gauss_kronrod_base().
+  */
+  void gk_reduce(double a, double b, const double *f, double *result,
+		 double *abserr, double *resabs, double *resasc) {
+
+    const double half_length=0.5*(b-a);
+    const double abs_half_length=fabs(half_length);
+    const double f_center=f[0];
+
+    double result_gauss=0.0;
+    double result_kronrod=f_center*this->w_gk[this->n_gk-1];
+    double result_abs=fabs(result_kronrod);
+    double result_asc=0.0;
+    double mean=0.0, err=0.0;
+
+    if (this->n_gk % 2 == 0) {
+      result_gauss=f_center*this->w_g[this->n_gk / 2-1];
+    }
+
+    size_t k=1;
+    for (int j=0; j < (this->n_gk-1) / 2; j++) {
+      const int jtw=j*2+1;
+      const double fval1=f[k++];
+      const double fval2=f[k++];
+      const double fsum=fval1+fval2;
+      this->f_v1[jtw]=fval1;
+      this->f_v2[jtw]=fval2;
+      result_gauss+=this->w_g[j]*fsum;
+      result_kronrod+=this->w_gk[jtw]*fsum;
+      result_abs+=this->w_gk[jtw]*(fabs(fval1)+fabs(fval2));
+    }
+
+    for (int j=0; j < this->n_gk / 2; j++) {
+      int jtwm1=j*2;
+      const double fval1=f[k++];
+      const double fval2=f[k++];
+      this->f_v1[jtwm1]=fval1;
+      this->f_v2[jtwm1]=fval2;
+      result_kronrod+=this->w_gk[jtwm1]*(fval1+fval2);
+      result_abs+=this->w_gk[jtwm1]*(fabs(fval1)+fabs(fval2));
+    }
+
+    mean=result_kronrod*0.5;
+
+    result_asc=this->w_gk[this->n_gk-1]*fabs(f_center-mean);
+
+    for (int j=0;j<this->n_gk-1;j++) {
+      result_asc+=this->w_gk[j]*(fabs(this->f_v1[j]-mean)+
+				 fabs(this->f_v2[j]-mean));
+    }
+
+    err=(result_kronrod-result_gauss)*half_length;
+
+    result_kronrod*=half_length;
+    result_abs*=abs_half_length;
+    result_asc*=abs_half_length;
+
+    *result=result_kronrod;
+    *resabs=result_abs;
+    *resasc=result_asc;
+    *abserr=this->rescale_error(err,result_abs,result_asc);
+
+    return;
+  }
+
+  /** \brief Bisect the subintervals with the largest error estimates
+      which have not already been evaluated
+
+      At most \c n_max subintervals are bisected. The subinterval
+      with the largest error estimate is always included.
+  */
+  int speculate(funct_batch &bfunc, size_t n_max) {
+
+    inte_workspace_gsl *ws=this->w;
+    size_t nb=n_block;
+    if (nb==0) nb=1;
+    if (nb>n_max) nb=n_max;
+
+    // Select the subintervals in decreasing order of their error
+    // estimates, beginning with the current one
+    ix_block.clear();
+    for(size_t j=ws->nrmax;j<ws->size && ix_block.size()<nb;j++) {
+      size_t ix=ws->order[j];
+      if (!spec_valid[ix] && ix<ws->size &&
+	  std::find(ix_block.begin(),ix_block.end(),ix)==ix_block.end()) {
+	ix_block.push_back(ix);
+      }
+    }
+    if (!spec_valid[ws->i] &&
+	(ix_block.size()==0 || ix_block[0]!=ws->i)) {
+      ix_block.insert(ix_block.begin(),ws->i);
+      if (ix_block.size()>nb) ix_block.pop_back();
+    }
+
+    const size_t nn=n_nodes();
+    size_t ntot=2*nn*ix_block.size();
+    if (x_block.size()<ntot) {
+      x_block.resize(ntot);
+      f_block.resize(ntot);
+    }
+
+    for(size_t k=0;k<ix_block.size();k++) {
+      double a_i=ws->alist[ix_block[k]];
+      double b_i=ws->blist[ix_block[k]];
+      double m_i=0.5*(a_i+b_i);
+      gk_nodes(a_i,m_i,&x_block[2*k*nn]);
+      gk_nodes(m_i,b_i,&x_block[(2*k+1)*nn]);
+    }
+
+    int ret=bfunc(ntot,&x_block[0],&f_block[0]);
+    last_nodes+=ntot;
+    if (ret!=0) {
+      O2SCL_CONV2_RET("Batched function failed in ",
+		      "inte_qag_block_gsl::speculate().",
+		      exc_efailed,this->err_nonconv);
+    }
+
+    for(size_t k=0;k<ix_block.size();k++) {
+      size_t ix=ix_block[k];
+      double a_i=ws->alist[ix];
+      double b_i=ws->blist[ix];
+      double m_i=0.5*(a_i+b_i);
+      double *sp=&spec[8*ix];
+      gk_reduce(a_i,m_i,&f_block[2*k*nn],&sp[0],&sp[1],&sp[2],&sp[3]);
+      gk_reduce(m_i,b_i,&f_block[(2*k+1)*nn],&sp[4],&sp[5],&sp[6],
+		&sp[7]);
+      spec_valid[ix]=true;
+    }
+
+    return success;
+  }
+
+  /** \brief Perform an adaptive integration with batched function
+      evaluations and return the result in \c result
+  */
+  int qag_block(funct_batch &bfunc, const double a, const double b,
+		const double l_epsabs, const double l_epsrel,
+		double *result, double *abserr) {
+
+    double area, errsum;
+    double result0, abserr0, resabs0, resasc0;
+    double tolerance;
+    size_t iteration = 0;
+    int roundoff_type1 = 0, roundoff_type2 = 0, error_type = 0;
+
+    double round_off;
+
+    /* Initialize results */
+
+    this->w->initialise(a,b);
+
+    *result = 0;
+    *abserr = 0;
+    last_nodes=0;
+
+    double dbl_eps=std::numeric_limits<double>::epsilon();
+
+    if (l_epsabs <= 0 &&
+	(l_epsrel < 50 * dbl_eps || l_epsrel < 0.5e-28)) {
+      this->last_iter=0;
+      std::string estr="Tolerance cannot be achieved with given ";
+      estr+="value of tol_abs, "+dtos(l_epsabs)+", and tol_rel, "+
+	dtos(l_epsrel)+", in inte_qag_block_gsl::qag_block().";
+      O2SCL_ERR(estr.c_str(),exc_ebadtol);
+    }
+
+    // Clear the speculative results
+    spec.resize(8*this->w->limit);
+    spec_valid.assign(this->w->limit,false);
+
+    /* perform the first integration */
+
+    const size_t nn=n_nodes();
+    if (x_block.size()<nn) {
+      x_block.resize(nn);
+      f_block.resize(nn);
+    }
+    gk_nodes(a,b,&x_block[0]);
+    int ret=bfunc(nn,&x_block[0],&f_block[0]);
+    last_nodes+=nn;
+    if (ret!=0) {
+      this->last_iter=0;
+      O2SCL_CONV2_RET("Batched function failed in ",
+		      "inte_qag_block_gsl::qag_block().",
+		      exc_efailed,this->err_nonconv);
+    }
+    gk_reduce(a,b,&f_block[0],&result0,&abserr0,&resabs0,&resasc0);
+
+    this->w->set_initial_result(result0,abserr0);
+
+    /* Test on accuracy */
+
+    tolerance = GSL_MAX_DBL(l_epsabs, l_epsrel * fabs (result0));
+
+    /* need IEEE rounding here to match original quadpack behavior */
+
+    round_off=gsl_coerce_double(50 * dbl_eps * resabs0);
+
+    if (abserr0 <= round_off && abserr0 > tolerance) {
+
+      *result = result0;
+      *abserr = abserr0;
+
+      this->last_iter=1;
+
+      std::string estr="Cannot reach tolerance because of roundoff ";
+      estr+="error on first attempt in inte_qag_block_gsl::qag_block().";
+      O2SCL_CONV_RET(estr.c_str(),exc_eround,this->err_nonconv);
+
+    } else if ((abserr0 <= tolerance &&
+		abserr0 != resasc0) || abserr0 == 0.0) {
+
+      *result = result0;
+      *abserr = abserr0;
+
+      this->last_iter=1;
+
+      return success;
+
+    } else if (this->w->limit == 1) {
+
+      *result = result0;
+      *abserr = abserr0;
+
+      this->last_iter=1;
+
+      O2SCL_CONV2_RET("A maximum of 1 iteration was insufficient ",
+		      "in inte_qag_block_gsl::qag_block().",
+		      exc_emaxiter,this->err_nonconv);
+    }
+
+    area = result0;
+    errsum = abserr0;
+
+    iteration = 1;
+    do {
+      double a1, b1, a2, b2;
+      double a_i, b_i, r_i, e_i;
+      double area1 = 0, area2 = 0, area12 = 0;
+      double error1 = 0, error2 = 0, error12 = 0;
+      double resasc1, resasc2;
+
+      /* Bisect the subinterval with the largest error estimate,
+	 evaluating a new block if it has not yet been computed */
+
+      this->w->retrieve (&a_i, &b_i, &r_i, &e_i);
+
+      size_t i_cur=this->w->i;
+      if (!spec_valid[i_cur]) {
+	int sret=speculate(bfunc,this->w->limit-iteration);
+	if (sret!=0) {
+	  *result = this->w->sum_results();
+	  *abserr = errsum;
+	  this->last_iter=iteration;
+	  return sret;
+	}
+      }
+
+      const double *sp=&spec[8*i_cur];
+      spec_valid[i_cur]=false;
+
+      a1 = a_i;
+      b1 = 0.5 * (a_i + b_i);
+      a2 = b1;
+      b2 = b_i;
+
+      // The absolute integrals in sp[2] and sp[6] are not needed
+      area1=sp[0];
+      error1=sp[1];
+      resasc1=sp[3];
+      area2=sp[4];
+      error2=sp[5];
+      resasc2=sp[7];
+
+      area12 = area1 + area2;
+      error12 = error1 + error2;
+
+      errsum += (error12 - e_i);
+      area += area12 - r_i;
+
+      if (resasc1 != error1 && resasc2 != error2) {
+	double delta = r_i - area12;
+
+	if (fabs (delta) <= 1.0e-5 * fabs (area12) &&
+	    error12 >= 0.99 * e_i) {
+	  roundoff_type1++;
+	}
+	if (iteration >= 10 && error12 > e_i) {
+	  roundoff_type2++;
+	}
+      }
+
+      tolerance = GSL_MAX_DBL (l_epsabs, l_epsrel * fabs (area));
+
+      if (errsum > tolerance) {
+	if (roundoff_type1 >= 6 || roundoff_type2 >= 20) {
+	  // round off error
+	  error_type = 2;
+	}
+	/* set error flag in the case of bad integrand behaviour at
+	   a point of the integration range */
+
+	if (this->w->subinterval_too_small (a1, a2, b2)) {
+	  error_type = 3;
+	}
+      }
+
+      this->w->update (a1, b1, area1, error1, a2, b2, area2, error2);
+
+      if (this->verbose>0) {
+	std::cout << "inte_qag_block_gsl Iter: " << iteration;
+	std::cout.setf(std::ios::showpos);
+	std::cout << " Res: " << area;
+	std::cout.unsetf(std::ios::showpos);
+	std::cout << " Err: " << errsum
+		  << " Tol: " << tolerance << std::endl;
+	if (this->verbose>1) {
+	  char ch;
+	  std::cout << "Press a key and type enter to continue. " ;
+	  std::cin >> ch;
+	}
+      }
+
+      iteration++;
+
+    } while (iteration < this->w->limit && !error_type &&
+	     errsum > tolerance);
+
+    *result = this->w->sum_results();
+    *abserr = errsum;
+
+    this->last_iter=iteration;
+
+    if (errsum <= tolerance) {
+      return success;
+    } else if (error_type == 2) {
+      std::string estr="Roundoff error prevents tolerance ";
+      estr+="from being achieved in inte_qag_block_gsl::qag_block().";
+      O2SCL_CONV_RET(estr.c_str(),exc_eround,this->err_nonconv);
+    } else if (error_type == 3) {
+      std::string estr="Bad integrand behavior ";
+      estr+=" in inte_qag_block_gsl::qag_block().";
+      O2SCL_CONV_RET(estr.c_str(),exc_esing,this->err_nonconv);
+    } else if (iteration == this->w->limit) {
+      std::string estr="Maximum number of subdivisions ("+itos(iteration);
+      estr+=") reached in inte_qag_block_gsl::qag_block().";
+      O2SCL_CONV_RET(estr.c_str(),exc_emaxiter,this->err_nonconv);
+    } else {
+      std::string estr="Could not integrate function in ";
+      estr+="inte_qag_block_gsl::qag_block() (it may have returned ";
+      estr+="a non-finite result).";
+      O2SCL_ERR(estr.c_str(),exc_efailed);
+    }
+
+    return o2scl::success;
+  }
+
+#endif
+
+  public:
+
+  /// Return string denoting type ("inte_qag_block_gsl")
+  const char *type() { return "inte_qag_block_gsl"; }
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
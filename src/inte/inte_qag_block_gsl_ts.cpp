@@ -0,0 +1,123 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <o2scl/test_mgr.h>
+#include <o2scl/funct.h>
+#include <o2scl/inte_qag_gsl.h>
+#include <o2scl/inte_qag_block_gsl.h>
+
+using namespace std;
+using namespace o2scl;
+
+// This function oscillates quite rapidly near x=0
+double test_func_1(double x) {
+  return -sin(1.0/(x+0.01))*pow(x+0.01,-2.0);
+}
+
+// The QUADPACK test function
+double quadpack_func(double x, double alpha) {
+  double sigma=pow(2.0,alpha);
+  return cos(sigma*sin(x));
+}
+
+// Number of batched calls
+static size_t n_batch_calls=0;
+
+// A batched version of test_func_1
+int test_func_batch(size_t n, const double *x, double *y) {
+  n_batch_calls++;
+  for(size_t i=0;i<n;i++) y[i]=test_func_1(x[i]);
+  return 0;
+}
+
+int main(void) {
+  test_mgr t;
+  t.set_output_level(1);
+
+  cout.setf(ios::scientific);
+  cout.precision(10);
+
+  inte_qag_gsl<funct> iq;
+  inte_qag_block_gsl<funct> ib;
+
+  funct tf1=test_func_1;
+  double exact=cos(100.0)-cos(1/1.01);
+
+  // Compare with inte_qag_gsl for all rules and several block sizes
+  for(int h=1;h<=6;h++) {
+    iq.set_rule(h);
+    ib.set_rule(h);
+    double res1, err1;
+    iq.integ_err(tf1,0.0,1.0,res1,err1);
+    for(size_t nb=1;nb<=16;nb*=4) {
+      double res2, err2;
+      ib.n_block=nb;
+      ib.integ_err(tf1,0.0,1.0,res2,err2);
+      cout << h << " " << nb << " " << res2 << " " << err2 << " "
+	   << ib.last_iter << " " << ib.last_nodes << endl;
+      t.test_gen(res1==res2,"result");
+      t.test_gen(err1==err2,"error");
+      t.test_gen(iq.last_iter==ib.last_iter,"iterations");
+    }
+    t.test_rel(iq.integ(tf1,0.0,1.0),exact,1.0e-8,"exact");
+  }
+  cout << endl;
+
+  // Test the batched interface
+  {
+    ib.set_rule(2);
+    iq.set_rule(2);
+    ib.n_block=8;
+    funct_batch bf=test_func_batch;
+    double res1, err1, res2, err2;
+    iq.integ_err(tf1,0.0,1.0,res1,err1);
+    ib.integ_err_batch(bf,0.0,1.0,res2,err2);
+    cout << res2 << " " << err2 << " " << n_batch_calls << " "
+	 << ib.last_iter << endl;
+    t.test_gen(res1==res2,"batch result");
+    t.test_gen(err1==err2,"batch error");
+    t.test_gen(n_batch_calls<ib.last_iter,"fewer batch calls");
+  }
+
+  // Test the QUADPACK oscillatory integrand with a tight tolerance
+  {
+    double alpha=8.0;
+    funct f=std::bind(quadpack_func,std::placeholders::_1,alpha);
+    iq.tol_abs=1.0e-12;
+    iq.tol_rel=0.0;
+    ib.tol_abs=1.0e-12;
+    ib.tol_rel=0.0;
+    for(int h=1;h<=6;h++) {
+      iq.set_rule(h);
+      ib.set_rule(h);
+      double res1, err1, res2, err2;
+      iq.integ_err(f,0.0,M_PI,res1,err1);
+      ib.integ_err(f,0.0,M_PI,res2,err2);
+      t.test_gen(res1==res2,"quadpack result");
+      t.test_gen(err1==err2,"quadpack error");
+    }
+  }
+
+  t.report();
+  return 0;
+}
+
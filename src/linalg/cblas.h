@@ -31,6 +31,7 @@
 
 #include <cmath>
 #include <o2scl/permutation.h>
+#include <o2scl/cblas_packed.h>
 
 /** \brief Namespace for O2scl CBLAS function templates
 
@@ -57,6 +58,16 @@
 
     Currently only \ref dgemm() is implemented.
 
+    <b>Contiguous storage</b>
+
+    For matrix types which store their elements contiguously in
+    row-major order (as indicated by \ref matrix_storage, currently
+    the default <tt>boost::numeric::ublas::matrix<double></tt>), 
+    \ref dgemm() uses the packed and cache-blocked kernel \ref
+    dgemm_packed() and \ref dgemv() uses \ref dgemv_contig(). Both
+    kernels are parallelized with OpenMP when \c O2SCL_OPENMP is
+    defined. Other matrix types use the generic loops.
+
     <b>Helper BLAS functions</b>
 
     There are several basic BLAS functions which are helpful
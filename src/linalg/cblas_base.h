@@ -261,6 +261,20 @@ namespace o2scl_cblas {
       return;
     }
 
+    // Use the contiguous kernel when possible
+    if (o2scl_cblas::matrix_storage<mat_t>::contiguous &&
+	lenX*lenY>=o2scl_cblas::dgemv_contig_min) {
+      bool tA=!((order == o2cblas_RowMajor && Trans == o2cblas_NoTrans) ||
+		(order == o2cblas_ColMajor && Trans == o2cblas_Trans));
+      std::vector<double> xv(lenX), yv(lenY,0.0);
+      for (j=0;j<lenX;j++) xv[j]=O2SCL_IX(X,j);
+      o2scl_cblas::dgemv_contig
+	(tA,lenY,lenX,alpha,o2scl_cblas::matrix_storage<mat_t>::data(A),
+	 o2scl_cblas::matrix_storage<mat_t>::stride(A),&xv[0],&yv[0]);
+      for (i=0;i<lenY;i++) O2SCL_IX(Y,i)+=yv[i];
+      return;
+    }
+
     if ((order == o2cblas_RowMajor && Trans == o2cblas_NoTrans) ||
 	(order == o2cblas_ColMajor && Trans == o2cblas_Trans)) {
 
@@ -593,6 +607,59 @@ namespace o2scl_cblas {
       return;
     }
 
+    // Use the packed kernel for contiguous storage
+    if (o2scl_cblas::matrix_storage<mat_t>::contiguous &&
+	(Order == o2cblas_RowMajor ?
+	 o2scl_cblas::dgemm_packed_ok(M,N,K) :
+	 o2scl_cblas::dgemm_packed_ok(N,M,K))) {
+      
+      typedef o2scl_cblas::matrix_storage<mat_t> ms_t;
+      bool tA=(TransA != o2cblas_NoTrans);
+      bool tB=(TransB != o2cblas_NoTrans);
+
+      if (Order == o2cblas_RowMajor) {
+	n1=M;
+	n2=N;
+      } else {
+	n1=N;
+	n2=M;
+      }
+      
+      /* form  y := beta*y */
+      double *c=ms_t::data(C);
+      size_t ldc=ms_t::stride(C);
+      if (beta == 0.0) {
+	for (i=0;i<n1;i++) {
+	  for (j=0;j<n2;j++) {
+	    c[i*ldc+j]=0.0;
+	  }
+	}
+      } else if (beta != 1.0) {
+	for (i=0;i<n1;i++) {
+	  for (j=0;j<n2;j++) {
+	    c[i*ldc+j]*=beta;
+	  }
+	}
+      }
+      
+      if (alpha == 0.0) {
+	return;
+      }
+
+      // The column-major case is the row-major product with A and
+      // B exchanged
+      if (Order == o2cblas_RowMajor) {
+	o2scl_cblas::dgemm_packed(tA,tB,M,N,K,alpha,ms_t::data(A),
+				  ms_t::stride(A),ms_t::data(B),
+				  ms_t::stride(B),c,ldc);
+      } else {
+	o2scl_cblas::dgemm_packed(tB,tA,N,M,K,alpha,ms_t::data(B),
+				  ms_t::stride(B),ms_t::data(A),
+				  ms_t::stride(A),c,ldc);
+      }
+      return;
+    }
+
     /*
       This is a little more complicated than the original in GSL,
       which assigned the matrices A and B to variables *F and *G which
@@ -0,0 +1,347 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_CBLAS_PACKED_H
+#define O2SCL_CBLAS_PACKED_H
+
+/** \file cblas_packed.h
+    \brief Packed and cache-blocked kernels for \ref o2scl_cblas::dgemm()
+    and \ref o2scl_cblas::dgemv()
+*/
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+namespace o2scl_cblas {
+
+  /** \brief Information on the storage of a matrix type
+
+      The generic version indicates that the matrix elements may not
+      be stored contiguously, in which case \ref dgemm() and \ref
+      dgemv() use the generic loops with <tt>operator()</tt> or
+      <tt>operator[]</tt>. Specializations for types which store
+      their elements contiguously in row-major order allow those
+      functions to use the kernels \ref dgemm_packed() and \ref
+      dgemv_contig() instead.
+  */
+  template<class mat_t> class matrix_storage {
+
+  public:
+
+    /// True if the matrix is stored contiguously in row-major order
+    static const bool contiguous=false;
+
+    /// Pointer to the first element
+    static const double *data(const mat_t &m) {
+      return 0;
+    }
+
+    /// Pointer to the first element
+    static double *data(mat_t &m) {
+      return 0;
+    }
+
+    /// The number of elements between successive rows
+    static size_t stride(const mat_t &m) {
+      return 0;
+    }
+
+  };
+
+  /** \brief Storage information for the default row-major
+      <tt>boost::numeric::ublas::matrix<double></tt>
+  */
+  template<> class matrix_storage<boost::numeric::ublas::matrix<double> > {
+
+  public:
+
+    /// True if the matrix is stored contiguously in row-major order
+    static const bool contiguous=true;
+
+    /// Pointer to the first element
+    static const double *data
+      (const boost::numeric::ublas::matrix<double> &m) {
+      return &(m.data()[0]);
+    }
+
+    /// Pointer to the first element
+    static double *data(boost::numeric::ublas::matrix<double> &m) {
+      return &(m.data()[0]);
+    }
+
+    /// The number of elements between successive rows
+    static size_t stride(const boost::numeric::ublas::matrix<double> &m) {
+      return m.size2();
+    }
+
+  };
+
+  /// \name Parameters for the packed matrix multiplication
+  //@{
+  /// Number of rows in the register-blocked micro-kernel
+  static const size_t dgemm_mr=4;
+  /// Number of columns in the register-blocked micro-kernel
+  static const size_t dgemm_nr=8;
+  /// Number of rows of \f$ \mathrm{op}(A) \f$ in each packed block
+  static const size_t dgemm_mc=96;
+  /// Number of columns of \f$ \mathrm{op}(A) \f$ in each packed block
+  static const size_t dgemm_kc=256;
+  /// Number of columns of \f$ \mathrm{op}(B) \f$ in each packed panel
+  static const size_t dgemm_nc=1024;
+  /** \brief The minimum value of \f$ M N K \f$ for which
+      \ref dgemm() uses the packed kernel (see \ref
+      dgemm_packed_ok())
+  */
+  static const size_t dgemm_packed_min=64;
+  /** \brief The minimum value of \f$ M N \f$ for which \ref
+      dgemv() uses the contiguous kernel
+  */
+  static const size_t dgemv_contig_min=256;
+  //@}
+
+  /** \brief Compute the product of an \f$ m_r \times k_c \f$ packed
+      sliver of \f$ A \f$ and a \f$ k_c \times n_r \f$ packed sliver
+      of \f$ B \f$
+
+      This is an internal function used by \ref dgemm_packed(). The
+      fixed loop bounds allow the compiler to keep the result in
+      registers and vectorize the inner loop.
+  */
+  inline void dgemm_micro(size_t kc, const double *a, const double *b,
+			  double c[dgemm_mr][dgemm_nr]) {
+    for(size_t ii=0;ii<dgemm_mr;ii++) {
+      for(size_t jj=0;jj<dgemm_nr;jj++) {
+	c[ii][jj]=0.0;
+      }
+    }
+    for(size_t p=0;p<kc;p++) {
+      const double *ap=a+p*dgemm_mr;
+      const double *bp=b+p*dgemm_nr;
+      for(size_t ii=0;ii<dgemm_mr;ii++) {
+	const double av=ap[ii];
+	for(size_t jj=0;jj<dgemm_nr;jj++) {
+	  c[ii][jj]+=av*bp[jj];
+	}
+      }
+    }
+    return;
+  }
+
+  /** \brief Return true if \ref dgemm_packed() is expected to be
+      faster than the generic loops for an \f$ M \times K \f$ times
+      \f$ K \times N \f$ product
+
+      This requires that \f$ M N K \f$ is at least \ref
+      dgemm_packed_min, that at most one of \f$ M \f$, \f$ N \f$
+      and \f$ K \f$ is unity, and that the padding of the rows
+      and columns to multiples of \ref dgemm_mr and \ref dgemm_nr
+      makes the micro-kernel do less than eight times the required
+      work. These conditions were chosen by timing both methods.
+      The products which fail them are essentially matrix-vector
+      products or are so small that the packing dominates.
+  */
+  inline bool dgemm_packed_ok(size_t M, size_t N, size_t K) {
+    if (M*N*K<dgemm_packed_min) return false;
+    if ((M==1)+(N==1)+(K==1)>1) return false;
+    size_t Mp=(M+dgemm_mr-1)/dgemm_mr*dgemm_mr;
+    size_t Np=(N+dgemm_nr-1)/dgemm_nr*dgemm_nr;
+    return (Mp*Np<8*M*N);
+  }
+
+  /** \brief Compute \f$ C=\alpha \mathrm{op}(A) \mathrm{op}(B) + C \f$
+      for contiguous row-major storage
+
+      The matrix \f$ \mathrm{op}(A) \f$ is \f$ M \times K \f$,
+      \f$ \mathrm{op}(B) \f$ is \f$ K \times N \f$ and \f$ C \f$ is
+      \f$ M \times N \f$. The parameters \c lda, \c ldb, and \c ldc
+      are the number of elements between successive rows of the
+      three matrices as they are stored.
+
+      Blocks of \f$ \mathrm{op}(A) \f$ and panels of \f$
+      \mathrm{op}(B) \f$ are copied into contiguous buffers sized
+      to fit in cache, with zero padding at the edges, and the
+      product is computed with a register-blocked micro-kernel. If
+      \c O2SCL_OPENMP is defined, the row blocks of \f$ C \f$ are
+      computed in parallel.
+  */
+  inline void dgemm_packed(bool transA, bool transB, size_t M, size_t N,
+			   size_t K, double alpha, const double *a,
+			   size_t lda, const double *b, size_t ldb,
+			   double *c, size_t ldc) {
+
+    const size_t mr=dgemm_mr, nr=dgemm_nr;
+
+    // Buffer for the packed panel of op(B), sized for the largest
+    // panel actually used. Every element is written when packing,
+    // so the buffers are not initialized.
+    size_t kc_max=std::min(dgemm_kc,K);
+    size_t nc_max=(std::min(dgemm_nc,N)+nr-1)/nr*nr;
+    std::unique_ptr<double[]> bpack(new double[kc_max*nc_max]);
+
+    for(size_t jc=0;jc<N;jc+=dgemm_nc) {
+      size_t nc=std::min(dgemm_nc,N-jc);
+      size_t nslb=(nc+nr-1)/nr;
+
+      for(size_t pc=0;pc<K;pc+=dgemm_kc) {
+	size_t kc=std::min(dgemm_kc,K-pc);
+
+	// Pack op(B) into slivers of nr columns
+	for(size_t t=0;t<nslb;t++) {
+	  double *bs=&bpack[t*kc*nr];
+	  for(size_t p=0;p<kc;p++) {
+	    for(size_t jj=0;jj<nr;jj++) {
+	      size_t j=jc+t*nr+jj;
+	      if (j<jc+nc) {
+		if (transB) bs[p*nr+jj]=b[j*ldb+pc+p];
+		else bs[p*nr+jj]=b[(pc+p)*ldb+j];
+	      } else {
+		bs[p*nr+jj]=0.0;
+	      }
+	    }
+	  }
+	}
+
+	size_t nblocks=(M+dgemm_mc-1)/dgemm_mc;
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel if (nblocks>1 && M*nc*kc>=262144)
+#endif
+	{
+	  // Buffer for the packed block of op(A)
+	  size_t mc_max=(std::min(dgemm_mc,M)+mr-1)/mr*mr;
+	  std::unique_ptr<double[]> apack(new double[mc_max*kc]);
+	  double cb[dgemm_mr][dgemm_nr];
+
+#ifdef O2SCL_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+	  for(size_t ib=0;ib<nblocks;ib++) {
+	    size_t ic=ib*dgemm_mc;
+	    size_t mc=std::min(dgemm_mc,M-ic);
+	    size_t nsla=(mc+mr-1)/mr;
+
+	    // Pack op(A) into slivers of mr rows
+	    for(size_t s=0;s<nsla;s++) {
+	      double *as=&apack[s*kc*mr];
+	      for(size_t p=0;p<kc;p++) {
+		for(size_t ii=0;ii<mr;ii++) {
+		  size_t i=ic+s*mr+ii;
+		  if (i<ic+mc) {
+		    if (transA) as[p*mr+ii]=a[(pc+p)*lda+i];
+		    else as[p*mr+ii]=a[i*lda+pc+p];
+		  } else {
+		    as[p*mr+ii]=0.0;
+		  }
+		}
+	      }
+	    }
+
+	    // Multiply the slivers and add the result to C
+	    for(size_t t=0;t<nslb;t++) {
+	      size_t nj=std::min(nr,nc-t*nr);
+	      for(size_t s=0;s<nsla;s++) {
+		size_t ni=std::min(mr,mc-s*mr);
+		dgemm_micro(kc,&apack[s*kc*mr],&bpack[t*kc*nr],cb);
+		for(size_t ii=0;ii<ni;ii++) {
+		  double *crow=c+(ic+s*mr+ii)*ldc+jc+t*nr;
+		  for(size_t jj=0;jj<nj;jj++) {
+		    crow[jj]+=alpha*cb[ii][jj];
+		  }
+		}
+	      }
+	    }
+
+	  }
+	}
+
+      }
+    }
+
+    return;
+  }
+
+  /** \brief Compute \f$ y=\alpha \mathrm{op}(A) x + y \f$ for
+      contiguous row-major storage
+
+      The matrix \f$ \mathrm{op}(A) \f$ is \f$ M \times N \f$ and
+      \c lda is the number of elements between successive rows of
+      \f$ A \f$ as it is stored. If \c O2SCL_OPENMP is defined,
+      the rows (or, for the transpose, the columns) are divided
+      between threads.
+  */
+  inline void dgemv_contig(bool transA, size_t M, size_t N, double alpha,
+			   const double *a, size_t lda, const double *x,
+			   double *y) {
+
+    if (!transA) {
+
+      // Each element of y is a dot product with a row of A
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for if (M*N>=65536)
+#endif
+      for(size_t i=0;i<M;i++) {
+	const double *arow=a+i*lda;
+	double t0=0.0, t1=0.0, t2=0.0, t3=0.0;
+	size_t j=0;
+	for(;j+4<=N;j+=4) {
+	  t0+=arow[j]*x[j];
+	  t1+=arow[j+1]*x[j+1];
+	  t2+=arow[j+2]*x[j+2];
+	  t3+=arow[j+3]*x[j+3];
+	}
+	for(;j<N;j++) t0+=arow[j]*x[j];
+	y[i]+=alpha*((t0+t1)+(t2+t3));
+      }
+
+    } else {
+
+      // Add multiples of the rows of A to y, with each thread
+      // handling a separate range of elements of y
+      const size_t cb=512;
+      size_t nblocks=(M+cb-1)/cb;
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for if (nblocks>1 && M*N>=65536)
+#endif
+      for(size_t ib=0;ib<nblocks;ib++) {
+	size_t j0=ib*cb, j1=std::min(M,j0+cb);
+	for(size_t i=0;i<N;i++) {
+	  const double temp=alpha*x[i];
+	  if (temp!=0.0) {
+	    const double *arow=a+i*lda;
+	    for(size_t j=j0;j<j1;j++) {
+	      y[j]+=temp*arow[j];
+	    }
+	  }
+	}
+      }
+
+    }
+
+    return;
+  }
+
+}
+
+#endif
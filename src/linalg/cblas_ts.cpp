@@ -491,6 +491,60 @@ int main(void) {
     cout << endl;
   }
 
+  // Compare the packed and contiguous kernels used for ubmatrix
+  // with the generic loops used for column-major ublas matrices
+  {
+    typedef boost::numeric::ublas::matrix
+      <double,boost::numeric::ublas::column_major> cmmatrix;
+    
+    // Include small shapes which are dispatched to the packed
+    // kernel as well as shapes with a unit dimension which are not
+    size_t shapes[6][3]={{37,53,41},{4,4,4},{3,5,7},{2,32,1},
+			 {1,8,64},{1,1,64}};
+    size_t dmax=64;
+    ubmatrix a(dmax,dmax), b(dmax,dmax), c(dmax,dmax);
+    cmmatrix ca(dmax,dmax), cb(dmax,dmax), cc(dmax,dmax);
+    for(size_t i=0;i<dmax;i++) {
+      for(size_t j=0;j<dmax;j++) {
+	a(i,j)=sin((double)(i*dmax+j+1));
+	b(i,j)=cos((double)(i*dmax+2*j+1));
+	c(i,j)=sin((double)(3*i+j+2));
+	ca(i,j)=a(i,j);
+	cb(i,j)=b(i,j);
+	cc(i,j)=c(i,j);
+      }
+    }
+
+    o2scl_cblas::o2cblas_order orders[2]={o2scl_cblas::o2cblas_RowMajor,
+					  o2scl_cblas::o2cblas_ColMajor};
+    o2scl_cblas::o2cblas_transpose trans[2]={o2scl_cblas::o2cblas_NoTrans,
+					     o2scl_cblas::o2cblas_Trans};
+    
+    for(size_t io=0;io<2;io++) {
+      for(size_t is=0;is<6;is++) {
+	for(size_t ia=0;ia<2;ia++) {
+	  for(size_t ib=0;ib<2;ib++) {
+	    o2scl_cblas::dgemm(orders[io],trans[ia],trans[ib],shapes[is][0],
+			       shapes[is][1],shapes[is][2],0.3,a,b,0.7,c);
+	    o2scl_cblas::dgemm(orders[io],trans[ia],trans[ib],shapes[is][0],
+			       shapes[is][1],shapes[is][2],0.3,ca,cb,0.7,cc);
+	    t.test_rel_mat(dmax,dmax,c,cc,1.0e-11,"dgemm packed");
+	  }
+	}
+      }
+      for(size_t ia=0;ia<2;ia++) {
+	ubvector x(dmax), y(dmax), y2(dmax);
+	for(size_t i=0;i<dmax;i++) {
+	  x[i]=cos((double)(i+1));
+	  y[i]=sin((double)(i+1));
+	  y2[i]=y[i];
+	}
+	o2scl_cblas::dgemv(orders[io],trans[ia],37,53,0.3,a,x,0.7,y);
+	o2scl_cblas::dgemv(orders[io],trans[ia],37,53,0.3,ca,x,0.7,y2);
+	t.test_rel_vec(dmax,y,y2,1.0e-12,"dgemv contiguous");
+      }
+    }
+  }
 
   t.report();
   return 0;
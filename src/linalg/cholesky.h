@@ -30,6 +30,7 @@
 #include <o2scl/err_hnd.h>
 #include <o2scl/permutation.h>
 #include <o2scl/cblas.h>
+#include <o2scl/decomp_blocked.h>
 #include <o2scl/vector.h>
 
 namespace o2scl_linalg {
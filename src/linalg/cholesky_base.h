@@ -57,11 +57,31 @@ namespace o2scl_linalg {
     
       If the matrix is not positive-definite, the error handler 
       will be called. 
+
+      If the matrix is stored contiguously (see \ref
+      o2scl_cblas::matrix_storage) and is at least \ref
+      decomp_blocked_min rows, then \ref cholesky_decomp_blocked()
+      is used instead of the unblocked algorithm.
   */
   template<class mat_t> void cholesky_decomp(const size_t M, mat_t &A) {
   
     size_t i,j,k;
 
+    // Use the blocked algorithm for large matrices with contiguous
+    // storage
+    if (o2scl_cblas::matrix_storage<mat_t>::contiguous &&
+	M>=o2scl_linalg::decomp_blocked_min) {
+      o2scl_linalg::cholesky_decomp_blocked
+	(M,o2scl_cblas::matrix_storage<mat_t>::data(A),
+	 o2scl_cblas::matrix_storage<mat_t>::stride(A));
+      for (i=1;i<M;i++) {
+	for (j=0;j<i;j++) {
+	  O2SCL_IX2(A,j,i)=O2SCL_IX2(A,i,j);
+	}
+      }
+      return;
+    }
+
     /* [GSL] Do the first 2 rows explicitly. It is simple, and faster.
        And one can return if the matrix has only 1 or 2 rows.
     */
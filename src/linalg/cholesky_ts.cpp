@@ -152,6 +152,31 @@ int main(void) {
 
   }
 
+  // Compare the blocked decomposition used for ubmatrix with the
+  // unblocked decomposition used for column-major ublas matrices
+  {
+    using namespace o2scl_linalg;
+    
+    typedef boost::numeric::ublas::matrix
+      <double,boost::numeric::ublas::column_major> cmmatrix;
+
+    size_t n=203;
+    ubmatrix om1(n,n);
+    cmmatrix cm1(n,n);
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<=i;j++) {
+	om1(i,j)=sin((double)(i*n+j+1))+cos((double)(i+2*j));
+	if (i==j) om1(i,j)+=((double)n);
+	om1(j,i)=om1(i,j);
+	cm1(i,j)=om1(i,j);
+	cm1(j,i)=om1(i,j);
+      }
+    }
+    cholesky_decomp(n,om1);
+    cholesky_decomp(n,cm1);
+    t.test_rel_mat(n,n,om1,cm1,1.0e-10,"blocked cholesky");
+  }
+
   t.report();
   return 0;
 }
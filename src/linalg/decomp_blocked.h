@@ -0,0 +1,216 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_DECOMP_BLOCKED_H
+#define O2SCL_DECOMP_BLOCKED_H
+
+/** \file decomp_blocked.h
+    \brief Blocked LU and Cholesky decompositions for contiguous
+    storage
+*/
+
+#include <cmath>
+#include <algorithm>
+
+#include <o2scl/err_hnd.h>
+#include <o2scl/permutation.h>
+#include <o2scl/cblas_packed.h>
+
+namespace o2scl_linalg {
+
+  /// \name Parameters for the blocked decompositions
+  //@{
+  /// The number of columns in each panel
+  static const size_t decomp_block_size=64;
+  /** \brief The minimum matrix size for which \ref LU_decomp() and
+      \ref cholesky_decomp() use the blocked algorithms
+  */
+  static const size_t decomp_blocked_min=128;
+  //@}
+
+  /** \brief Compute the LU decomposition of a matrix stored
+      contiguously in row-major order using a blocked algorithm
+
+      This is the right-looking blocked form of the algorithm in
+      \ref LU_decomp() and gives the same output (up to roundoff).
+      The parameter \c lda is the number of elements between
+      successive rows of \c a. The permutation \c p and \c signum
+      must be initialized by the caller.
+
+      For each panel of \ref decomp_block_size columns, the panel
+      is factored with partial pivoting, the corresponding block
+      row of U is computed by forward substitution, and the
+      trailing submatrix is updated with \ref
+      o2scl_cblas::dgemm_packed(), which is parallelized if \c
+      O2SCL_OPENMP is defined.
+  */
+  inline void LU_decomp_blocked(size_t N, double *a, size_t lda,
+				o2scl::permutation &p, int &signum) {
+
+    for(size_t j0=0;j0<N;j0+=decomp_block_size) {
+      size_t jb=std::min(decomp_block_size,N-j0);
+      size_t j1=j0+jb;
+
+      // Factor the panel with partial pivoting
+      for(size_t j=j0;j<j1 && j+1<N;j++) {
+
+	double max=fabs(a[j*lda+j]);
+	size_t i_pivot=j;
+	for(size_t i=j+1;i<N;i++) {
+	  double aij=fabs(a[i*lda+j]);
+	  if (aij>max) {
+	    max=aij;
+	    i_pivot=i;
+	  }
+	}
+
+	if (i_pivot!=j) {
+	  // Swap the full rows j and i_pivot
+	  double *rj=a+j*lda, *rp=a+i_pivot*lda;
+	  for(size_t k=0;k<N;k++) {
+	    std::swap(rj[k],rp[k]);
+	  }
+	  p.swap(j,i_pivot);
+	  signum=-signum;
+	}
+
+	double ajj=a[j*lda+j];
+	if (ajj!=0.0) {
+	  const double *rj=a+j*lda;
+	  for(size_t i=j+1;i<N;i++) {
+	    double *ri=a+i*lda;
+	    double aij=ri[j]/ajj;
+	    ri[j]=aij;
+	    for(size_t k=j+1;k<j1;k++) {
+	      ri[k]-=aij*rj[k];
+	    }
+	  }
+	}
+      }
+
+      if (j1<N) {
+
+	// Compute the block row of U by forward substitution with
+	// the unit lower-triangular part of the panel
+	for(size_t i=j0+1;i<j1;i++) {
+	  double *ri=a+i*lda;
+	  for(size_t k=j0;k<i;k++) {
+	    const double lik=ri[k];
+	    const double *rk=a+k*lda;
+	    for(size_t m=j1;m<N;m++) {
+	      ri[m]-=lik*rk[m];
+	    }
+	  }
+	}
+
+	// Update the trailing submatrix
+	o2scl_cblas::dgemm_packed(false,false,N-j1,N-j1,jb,-1.0,
+				  a+j1*lda+j0,lda,a+j0*lda+j1,lda,
+				  a+j1*lda+j1,lda);
+      }
+    }
+
+    return;
+  }
+
+  /** \brief Compute the lower-triangular Cholesky factor of a
+      matrix stored contiguously in row-major order using a blocked
+      algorithm
+
+      This is the right-looking blocked form of the algorithm in
+      \ref cholesky_decomp(). Only the lower triangular part and
+      the diagonal of \c a are used on input, and on output they
+      contain L. The upper triangular part is left unspecified. The
+      parameter \c lda is the number of elements between successive
+      rows of \c a.
+
+      For each panel of \ref decomp_block_size columns, the
+      diagonal block is factored directly, the rows below it are
+      computed by triangular substitution, and the lower part of
+      the trailing submatrix is updated with \ref
+      o2scl_cblas::dgemm_packed(). The substitution and the update
+      are parallelized if \c O2SCL_OPENMP is defined.
+  */
+  inline void cholesky_decomp_blocked(size_t M, double *a, size_t lda) {
+
+    for(size_t k0=0;k0<M;k0+=decomp_block_size) {
+      size_t kb=std::min(decomp_block_size,M-k0);
+      size_t k1=k0+kb;
+
+      // Factor the diagonal block
+      for(size_t k=k0;k<k1;k++) {
+	double *rk=a+k*lda;
+	for(size_t i=k0;i<k;i++) {
+	  const double *ri=a+i*lda;
+	  double sum=0.0;
+	  for(size_t j=k0;j<i;j++) {
+	    sum+=ri[j]*rk[j];
+	  }
+	  rk[i]=(rk[i]-sum)/ri[i];
+	}
+	double diag=rk[k];
+	for(size_t j=k0;j<k;j++) {
+	  diag-=rk[j]*rk[j];
+	}
+	if (diag<=0) {
+	  O2SCL_ERR2("Matrix not positive definite (diag<=0) in ",
+		     "cholesky_decomp().",o2scl::exc_einval);
+	  return;
+	}
+	rk[k]=sqrt(diag);
+      }
+
+      if (k1<M) {
+
+	// Compute the rows below the diagonal block
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for if ((M-k1)*kb*kb>=262144)
+#endif
+	for(size_t r=k1;r<M;r++) {
+	  double *rr=a+r*lda;
+	  for(size_t i=k0;i<k1;i++) {
+	    const double *ri=a+i*lda;
+	    double sum=0.0;
+	    for(size_t j=k0;j<i;j++) {
+	      sum+=ri[j]*rr[j];
+	    }
+	    rr[i]=(rr[i]-sum)/ri[i];
+	  }
+	}
+
+	// Update the lower part of the trailing submatrix one block
+	// column at a time
+	for(size_t c0=k1;c0<M;c0+=decomp_block_size) {
+	  size_t cb=std::min(decomp_block_size,M-c0);
+	  o2scl_cblas::dgemm_packed(false,true,M-c0,cb,kb,-1.0,
+				    a+c0*lda+k0,lda,a+c0*lda+k0,lda,
+				    a+c0*lda+c0,lda);
+	}
+      }
+    }
+
+    return;
+  }
+
+}
+
+#endif
@@ -32,8 +32,90 @@
 #include <o2scl/cblas.h>
 #include <o2scl/householder.h>
 #include <o2scl/givens.h>
+#include <o2scl/vector_fixed.h>
 
 namespace o2scl_linalg {
+
+  /** \brief Specialized version of HH_svx() for square matrices
+      and vectors with a size fixed at compile time
+
+      This version is also used by HH_solve() for these types. It
+      requires no heap allocation and the loop bounds are
+      compile-time constants. The parameters \c n and \c m are
+      ignored.
+  */
+  template<size_t N>
+    int HH_svx(size_t n, size_t m, o2scl::fixed_matrix<N,N> &A,
+	       o2scl::fixed_vector<N> &x) {
+
+    std::array<double,N> d;
+
+    /* Perform Householder transformation. */
+
+    for (size_t i=0;i<N;i++) {
+      const double aii=A(i,i);
+      double max_norm=0.0;
+      double r=0.0;
+
+      for (size_t k=i;k<N;k++) {
+	r+=A(k,i)*A(k,i);
+      }
+
+      if (r==0.0) {
+	/* Rank of matrix is less than size1. */
+	O2SCL_ERR("Matrix is rank deficient in HH_svx().",
+		  o2scl::exc_esing);
+      }
+
+      double alpha=sqrt(r)*(aii>=0.0 ? 1.0 : -1.0);
+      double ak=1.0/(r+alpha*aii);
+      A(i,i)=aii+alpha;
+      d[i]=-alpha;
+
+      for (size_t k=i+1;k<N;k++) {
+	double norm=0.0;
+	double f=0.0;
+	for (size_t j=i;j<N;j++) {
+	  norm+=A(j,k)*A(j,k);
+	  f+=A(j,k)*A(j,i);
+	}
+	if (norm>max_norm) max_norm=norm;
+	f*=ak;
+	for (size_t j=i;j<N;j++) {
+	  A(j,k)-=f*A(j,i);
+	}
+      }
+
+      double dbl_eps=std::numeric_limits<double>::epsilon();
+      if (fabs(alpha)<2.0*dbl_eps*sqrt(max_norm)) {
+	/* Apparent singularity. */
+	O2SCL_ERR("Apparent singularity in HH_svx().",o2scl::exc_esing);
+      }
+
+      /* Perform update of RHS. */
+
+      double f=0.0;
+      for (size_t j=i;j<N;j++) {
+	f+=x[j]*A(j,i);
+      }
+      f*=ak;
+      for (size_t j=i;j<N;j++) {
+	x[j]-=f*A(j,i);
+      }
+    }
+
+    /* Perform back-substitution. */
+    
+    for (size_t i=N;i-->0;) {
+      double sum=0.0;
+      for (size_t k=i+1;k<N;k++) {
+	sum+=A(i,k)*x[k];
+      }
+      x[i]=(x[i]-sum)/d[i];
+    }
+
+    return o2scl::success;
+  }
   
 #define O2SCL_IX(V,i) V[i]
 #define O2SCL_IX2(M,i,j) M(i,j)
@@ -29,8 +29,102 @@
 #include <o2scl/err_hnd.h>
 #include <o2scl/permutation.h>
 #include <o2scl/cblas.h>
+#include <o2scl/decomp_blocked.h>
+#include <o2scl/vector_fixed.h>
 
 namespace o2scl_linalg {
+
+  /** \brief Specialized version of LU_decomp() for matrices with
+      a size fixed at compile time
+
+      The loop bounds are compile-time constants, so the compiler can
+      unroll the loops for small matrices. The parameter \c n is
+      ignored.
+  */
+  template<size_t N>
+    int LU_decomp(const size_t n, o2scl::fixed_matrix<N,N> &A, 
+		  o2scl::permutation &p, int &signum) {
+    
+    signum=1;
+    p.init();
+  
+    for (size_t j=0;j+1<N;j++) {
+    
+      /* Find maximum in the j-th column */
+      double max=fabs(A(j,j));
+      size_t i_pivot=j;
+      for (size_t i=j+1;i<N;i++) {
+	double aij=fabs(A(i,j));
+	if (aij>max) {
+	  max=aij;
+	  i_pivot=i;
+	}
+      }
+
+      if (i_pivot!=j) {
+	// Swap rows j and i_pivot
+	for (size_t k=0;k<N;k++) {
+	  std::swap(A(j,k),A(i_pivot,k));
+	}
+	p.swap(j,i_pivot);
+	signum=-signum;
+      }
+      
+      double ajj=A(j,j);
+      if (ajj!=0.0) {
+	for (size_t i=j+1;i<N;i++) {
+	  double aij=A(i,j)/ajj;
+	  A(i,j)=aij;
+	  for (size_t k=j+1;k<N;k++) {
+	    A(i,k)-=aij*A(j,k);
+	  }
+	}
+      }
+    }
+  
+    return o2scl::success;
+  }
+
+  /** \brief Specialized version of LU_svx() for matrices and
+      vectors with a size fixed at compile time
+
+      This version is also used by LU_solve() for these types. The
+      parameter \c n is ignored.
+  */
+  template<size_t N>
+    int LU_svx(const size_t n, const o2scl::fixed_matrix<N,N> &LU, 
+	       const o2scl::permutation &p, o2scl::fixed_vector<N> &x) {
+    
+    for (size_t i=0;i<N;i++) {
+      if (LU(i,i)==0.0) {
+	O2SCL_ERR("LU matrix is singular in LU_svx().",
+		  o2scl::exc_edom);
+      }
+    }
+
+    /* Apply permutation to RHS */
+    p.apply(x);
+  
+    /* Solve for c using forward-substitution, L c = P b */
+    for (size_t i=1;i<N;i++) {
+      double sum=x[i];
+      for (size_t j=0;j<i;j++) {
+	sum-=LU(i,j)*x[j];
+      }
+      x[i]=sum;
+    }
+  
+    /* Perform back-substitution, U x = c */
+    for (size_t i=N;i-->0;) {
+      double sum=x[i];
+      for (size_t j=i+1;j<N;j++) {
+	sum-=LU(i,j)*x[j];
+      }
+      x[i]=sum/LU(i,i);
+    }
+  
+    return o2scl::success;
+  }
   
 #define O2SCL_IX(V,i) V[i]
 #define O2SCL_IX2(M,i,j) M(i,j)
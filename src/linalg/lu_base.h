@@ -75,7 +75,10 @@ namespace o2scl_linalg {
       
       The algorithm used in the decomposition is Gaussian Elimination
       with partial pivoting (Golub & Van Loan, Matrix Computations,
-      Algorithm 3.4.1).
+      Algorithm 3.4.1). If the matrix is stored contiguously (see
+      \ref o2scl_cblas::matrix_storage) and is at least \ref
+      decomp_blocked_min rows, then the blocked form in \ref
+      LU_decomp_blocked() is used instead.
 
       \future The "swap rows j and i_pivot" section could probably
       be made more efficient using a "matrix_row"-like object
@@ -90,6 +93,16 @@ namespace o2scl_linalg {
   
     signum=1;
     p.init();
+
+    // Use the blocked algorithm for large matrices with contiguous
+    // storage
+    if (o2scl_cblas::matrix_storage<mat_t>::contiguous &&
+	N>=o2scl_linalg::decomp_blocked_min) {
+      o2scl_linalg::LU_decomp_blocked
+	(N,o2scl_cblas::matrix_storage<mat_t>::data(A),
+	 o2scl_cblas::matrix_storage<mat_t>::stride(A),p,signum);
+      return o2scl::success;
+    }
   
     for (j = 0; j < N - 1; j++) {
     
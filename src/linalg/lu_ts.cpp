@@ -171,6 +171,36 @@ int main(void) {
     }
   }
 
+  // Compare the blocked decomposition used for ubmatrix with the
+  // unblocked decomposition used for column-major ublas matrices
+  {
+    using namespace o2scl_linalg;
+    
+    typedef boost::numeric::ublas::matrix
+      <double,boost::numeric::ublas::column_major> cmmatrix;
+
+    size_t n=203;
+    ubmatrix om1(n,n);
+    cmmatrix cm1(n,n);
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	om1(i,j)=sin((double)((i+1)*(j+1)*(i+j+1)));
+	cm1(i,j)=om1(i,j);
+      }
+    }
+    permutation op1(n), cp1(n);
+    int sig1, sig2;
+    LU_decomp(n,om1,op1,sig1);
+    LU_decomp(n,cm1,cp1,sig2);
+    t.test_gen(sig1==sig2,"blocked LU signum");
+    bool same_perm=true;
+    for(size_t i=0;i<n;i++) {
+      if (op1[i]!=cp1[i]) same_perm=false;
+    }
+    t.test_gen(same_perm,"blocked LU permutation");
+    t.test_rel_mat(n,n,om1,cm1,1.0e-9,"blocked LU");
+  }
+
   t.report();
   return 0;
 }
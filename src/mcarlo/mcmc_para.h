@@ -29,6 +29,8 @@
 
 #include <iostream>
 #include <random>
+#include <thread>
+#include <exception>
 
 #ifdef O2SCL_OPENMP
 #include <omp.h>
@@ -103,6 +105,37 @@ namespace o2scl {
       otherwise be required, in order to avoid copying of data objects
       in the case that the steps are accepted or rejected.
 
+      If \ref par_temp is true, then parallel tempering is used. The
+      independent chain in each thread samples the distribution
+      raised to the power \f$ \beta_i = 1/T_i \f$, where the
+      temperatures \f$ T_i \f$ are given in \ref pt_temps (or
+      spaced geometrically between 1 and \ref pt_max_temp if \ref
+      pt_temps is empty). The first thread always has the
+      temperature given by the first entry, which should be 1 to
+      sample the original distribution. Every \ref pt_swap_iters
+      iterations, the states of chains with adjacent temperatures
+      are proposed to be exchanged, alternating between the even and
+      odd pairs of chains. The swaps are decided between the
+      parallel regions which already exist for each iteration, so no
+      additional synchronization between the threads is required.
+      When a swap is accepted, the measurement function is called
+      for the new point in each chain as if it were an accepted
+      step. The weight given to the measurement function is always
+      the original log weight, not the tempered one. The
+      measurement function is called for every chain, so only the
+      points measured in chains with unit temperature (by default,
+      only thread 0) are samples of the original distribution. With
+      affine-invariant sampling, the ensemble in each thread has
+      the same temperature and the walkers being moved in the
+      current iteration are exchanged. The acceptance rate of each
+      temperature is given by \ref n_accept and \ref n_reject and
+      the swap acceptance rates are given in \ref pt_swap_accept and
+      \ref pt_swap_reject. The number of accepted swaps which
+      changed each chain, and thus the number of additional calls
+      to the measurement function with an accepted point, is given
+      in \ref pt_swapped. Parallel tempering is performed
+      separately in each MPI rank.
+
       \note This class is experimental.
   */
   template<class func_t, class measure_t,
@@ -185,6 +218,14 @@ namespace o2scl {
 	<< "): accept=" << n_accept[it]
 	<< " reject=" << n_reject[it] << std::endl;
       }
+      if (par_temp) {
+	for(size_t it=0;it+1<n_chains_per_rank;it++) {
+	  scr_out << "mcmc (" << it << "," << mpi_rank
+		  << "): swap with " << it+1 << " accept="
+		  << pt_swap_accept[it] << " reject="
+		  << pt_swap_reject[it] << std::endl;
+	}
+      }
       scr_out.close();
     }
     return;
@@ -215,6 +256,91 @@ namespace o2scl {
    */
   size_t n_chains_per_rank;
 
+  /** \brief The number of parallel tempering swap attempts, used
+      to alternate between even and odd pairs of chains
+  */
+  size_t pt_n_swaps;
+
+  /// For each thread, true if the state was changed by a swap
+  std::vector<bool> pt_changed;
+
+  /** \brief Propose swaps between chains with adjacent temperatures
+      for parallel tempering
+
+      The swaps are decided serially and then the measurement
+      function is called for each changed chain in parallel. 
+  */
+  void pt_swap(std::vector<double> &w_current, std::vector<int> &func_ret,
+	       std::vector<int> &meas_ret, std::vector<measure_t> &meas) {
+
+    // Don't swap if any thread is done or has failed
+    for(size_t it=0;it<n_threads;it++) {
+      if (func_ret[it]==mcmc_done || meas_ret[it]!=o2scl::success) {
+	return;
+      }
+    }
+
+    size_t ntot=n_walk*n_threads;
+    pt_changed.resize(n_threads);
+    for(size_t it=0;it<n_threads;it++) pt_changed[it]=false;
+    bool any_changed=false;
+
+    // Alternate between the even and the odd pairs
+    for(size_t it=pt_n_swaps%2;it+1<n_threads;it+=2) {
+      size_t ia=n_walk*it+curr_walker[it];
+      size_t ib=n_walk*(it+1)+curr_walker[it+1];
+      double r=rg[it].random();
+      if (r<exp((pt_beta[it]-pt_beta[it+1])*
+		(w_current[ib]-w_current[ia]))) {
+	std::swap(current[ia],current[ib]);
+	std::swap(w_current[ia],w_current[ib]);
+	// The data for the current point is in the second half of 
+	// data_arr if switch_arr is true
+	size_t da=ia, db=ib;
+	if (switch_arr[ia]) da+=ntot;
+	if (switch_arr[ib]) db+=ntot;
+	std::swap(data_arr[da],data_arr[db]);
+	pt_changed[it]=true;
+	pt_changed[it+1]=true;
+	any_changed=true;
+	pt_swap_accept[it]++;
+	pt_swapped[it]++;
+	pt_swapped[it+1]++;
+	if (verbose>=2) {
+	  scr_out << "mcmc (" << it << "," << mpi_rank
+		  << "): Swapped with chain " << it+1 << "." << std::endl;
+	}
+      } else {
+	pt_swap_reject[it]++;
+      }
+    }
+    pt_n_swaps++;
+
+    // Measure the new points
+    if (any_changed && !warm_up) {
+#ifdef O2SCL_OPENMP
+#pragma omp parallel default(shared)
+#endif
+      {
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+	for(size_t it=0;it<n_threads;it++) {
+	  if (pt_changed[it]) {
+	    size_t sindex=n_walk*it+curr_walker[it];
+	    size_t dindex=sindex;
+	    if (switch_arr[sindex]) dindex+=ntot;
+	    meas_ret[it]=meas[it](current[sindex],w_current[sindex],
+				  curr_walker[it],true,data_arr[dindex]);
+	  }
+	}
+      }
+      // End of parallel region
+    }
+    
+    return;
+  }
+
   public:
 
   /** \brief The MPI starting time
@@ -258,6 +384,36 @@ namespace o2scl {
       This vector has a size equal to \ref n_chains_per_rank .
   */
   std::vector<size_t> n_reject;
+
+  /** \brief The inverse temperature of each independent chain
+      when \ref par_temp is true
+
+      This vector has a size equal to \ref n_chains_per_rank .
+  */
+  std::vector<double> pt_beta;
+  
+  /** \brief The number of accepted swaps between chains \c i and
+      <tt>i+1</tt> when \ref par_temp is true
+
+      This vector has a size equal to \ref n_chains_per_rank minus 
+      one.
+  */
+  std::vector<size_t> pt_swap_accept;
+
+  /** \brief The number of rejected swaps between chains \c i and
+      <tt>i+1</tt> when \ref par_temp is true
+
+      This vector has a size equal to \ref n_chains_per_rank minus
+      one.
+  */
+  std::vector<size_t> pt_swap_reject;
+
+  /** \brief The number of accepted swaps which changed the state
+      of each independent chain when \ref par_temp is true
+
+      This vector has a size equal to \ref n_chains_per_rank .
+  */
+  std::vector<size_t> pt_swapped;
   //@}
 
   /// \name Settings
@@ -311,6 +467,27 @@ namespace o2scl {
       (default 0.1)
   */
   double ai_initial_step;
+
+  /// If true, use parallel tempering (default false)
+  bool par_temp;
+
+  /** \brief The temperature of each independent chain for parallel
+      tempering (default empty)
+
+      If this is not empty, then it must have one entry for each
+      thread, and all entries must be positive.
+  */
+  std::vector<double> pt_temps;
+
+  /** \brief The largest temperature for parallel tempering if
+      \ref pt_temps is empty (default 10.0)
+  */
+  double pt_max_temp;
+
+  /** \brief The number of iterations between swap attempts for 
+      parallel tempering (default 1)
+  */
+  size_t pt_swap_iters;
   //@}
   
   mcmc_para_base() {
@@ -330,6 +507,11 @@ namespace o2scl {
     always_accept=false;
     ai_initial_step=0.1;
 
+    par_temp=false;
+    pt_max_temp=10.0;
+    pt_swap_iters=1;
+    pt_n_swaps=0;
+
     n_threads=1;
     n_walk=1;
 
@@ -472,6 +654,9 @@ namespace o2scl {
       n_walk_per_thread=n_walk;
       n_chains_per_rank=n_threads;
 #endif
+    } else {
+      n_walk_per_thread=n_walk;
+      n_chains_per_rank=n_threads;
     }
     
     // Fix 'step_fac' if it's less than or equal to zero
@@ -508,6 +693,43 @@ namespace o2scl {
       n_reject[it]=0;
     }
 
+    // Set up the temperatures for parallel tempering
+    pt_beta.resize(n_chains_per_rank);
+    for(size_t it=0;it<n_chains_per_rank;it++) {
+      pt_beta[it]=1.0;
+    }
+    pt_swap_accept.resize(n_chains_per_rank>0 ? n_chains_per_rank-1 : 0);
+    pt_swap_reject.resize(pt_swap_accept.size());
+    for(size_t it=0;it<pt_swap_accept.size();it++) {
+      pt_swap_accept[it]=0;
+      pt_swap_reject[it]=0;
+    }
+    pt_swapped.resize(n_chains_per_rank);
+    for(size_t it=0;it<n_chains_per_rank;it++) {
+      pt_swapped[it]=0;
+    }
+    pt_n_swaps=0;
+    if (par_temp) {
+      if (pt_temps.size()>0) {
+	if (pt_temps.size()!=n_chains_per_rank) {
+	  O2SCL_ERR2("Number of temperatures not equal to number of ",
+		     "chains in mcmc_para_base::mcmc().",o2scl::exc_einval);
+	}
+	for(size_t it=0;it<n_chains_per_rank;it++) {
+	  if (!(pt_temps[it]>0.0)) {
+	    O2SCL_ERR2("Temperatures must be positive in ",
+		       "mcmc_para_base::mcmc().",o2scl::exc_einval);
+	  }
+	  pt_beta[it]=1.0/pt_temps[it];
+	}
+      } else if (n_chains_per_rank>1) {
+	for(size_t it=0;it<n_chains_per_rank;it++) {
+	  pt_beta[it]=pow(pt_max_temp,-((double)it)/
+			  ((double)(n_chains_per_rank-1)));
+	}
+      }
+    }
+
     // Warm-up flag, not to be confused with 'n_warm_up', the
     // number of warm_up iterations.
     warm_up=true;
@@ -568,6 +790,13 @@ namespace o2scl {
     // Initial verbose output
     
     if (verbose>=1) {
+      if (par_temp) {
+	scr_out << "mcmc: Parallel tempering, temperatures: ";
+	for(size_t it=0;it<n_chains_per_rank;it++) {
+	  scr_out << 1.0/pt_beta[it] << " ";
+	}
+	scr_out << std::endl;
+      }
       if (aff_inv) {
 	scr_out << "mcmc: Affine-invariant step, n_params="
 		<< n_params << ", n_walk=" << n_walk
@@ -1098,20 +1327,24 @@ namespace o2scl {
 	  if (func_ret[it]==o2scl::success) {
 	    double r=rg[it].random();
 	    
+	    // The inverse temperature (unity unless parallel
+	    // tempering is used)
+	    double beta=pt_beta[it];
+	    
 	    if (aff_inv) {
 	      double ai_ratio=pow(smove_z[it],((double)n_params)-1.0)*
-		exp(w_next[it]-w_current[sindex]);
+		exp(beta*(w_next[it]-w_current[sindex]));
 	      if (r<ai_ratio) {
 		accept=true;
 	      }
 	    } else if (pd_mode) {
-	      if (r<exp(w_next[it]-w_current[sindex]+q_prop[it])) {
+	      if (r<exp(beta*(w_next[it]-w_current[sindex])+q_prop[it])) {
 		accept=true;
 	      }
 	      
 	    } else {
 	      // Metropolis algorithm
-	      if (r<exp(w_next[it]-w_current[sindex])) {
+	      if (r<exp(beta*(w_next[it]-w_current[sindex]))) {
 		accept=true;
 	      }
 	    }
@@ -1149,10 +1382,10 @@ namespace o2scl {
 	    // Repeat measurement of old point
 	    if (!warm_up) {
 	      if (switch_arr[sindex]==false) {
-		meas_ret[it]=meas[it](next[sindex],w_next[sindex],
+		meas_ret[it]=meas[it](current[sindex],w_current[sindex],
 				      curr_walker[it],false,data_arr[sindex]);
 	      } else {
-		meas_ret[it]=meas[it](next[sindex],w_next[sindex],
+		meas_ret[it]=meas[it](current[sindex],w_current[sindex],
 				      curr_walker[it],false,
 				      data_arr[sindex+n_walk*n_threads]);
 	      }
@@ -1165,6 +1398,14 @@ namespace o2scl {
       // End of parallel region
 
       post_pointmeas();
+
+      // -----------------------------------------------------------
+      // Parallel tempering swaps
+
+      if (par_temp && n_threads>1 &&
+	  (pt_swap_iters<=1 || (mcmc_iters+1)%pt_swap_iters==0)) {
+	pt_swap(w_current,func_ret,meas_ret,meas);
+      }
       
       // -----------------------------------------------------------
       // Post-measurement verbose output of iteration count, weight,
@@ -1227,6 +1468,13 @@ namespace o2scl {
 	    n_accept[it]=0;
 	    n_reject[it]=0;
 	  }
+	  for(size_t it=0;it<pt_swap_accept.size();it++) {
+	    pt_swap_accept[it]=0;
+	    pt_swap_reject[it]=0;
+	  }
+	  for(size_t it=0;it<pt_swapped.size();it++) {
+	    pt_swapped[it]=0;
+	  }
 	  if (verbose>=1) {
 	    scr_out << "mcmc: Finished warmup." << std::endl;
 	  }
@@ -1354,11 +1602,41 @@ namespace o2scl {
       accepted and the multiplier for that row is set to 1. If a
       future step is rejected, then the multiplier is increased by
       one, rather than adding the same row to the table again.
+      For a chain with one walker, the number of rows is thus one
+      more than the number of accepted steps.
+
+      If parallel tempering is used (see \ref
+      mcmc_para_base::par_temp), the table contains the points from
+      the chains at every temperature. Only the rows from chains
+      with unit temperature, those with a value of zero in the
+      "thread" column when the default temperatures are used, are
+      samples of the original distribution. Each accepted swap also
+      adds a row, so the number of rows for chain \c i with one
+      walker is <tt>n_accept[i]+pt_swapped[i]+1</tt>.
 
       This class forms the basis of the MCMC used in the Bayesian
       analysis of neutron star mass and radius in
       http://github.com/awsteiner/bamr .
 
+      If \ref file_update_iters is non-zero, the table is written to
+      a file periodically by \ref write_files(). By default the
+      entire table is rewritten each time. If \ref async_write is
+      true (and \ref table_io_chunk is 1), then the rows which can no
+      longer change are copied to a second buffer and appended to the
+      datasets in the file by a background thread while the
+      simulation continues. A row can change until its walker has
+      accepted a later point (because the multiplier is increased
+      after rejections), so the last few rows for each walker are
+      only written at the next update or at the end of the
+      simulation. In this mode, the writes from different MPI ranks
+      are not serialized. The function \ref file_header() is then
+      called from the background thread. If the background thread
+      calls the error handler, the exception is stored and rethrown
+      by the next call to \ref write_files() or at the end of the
+      simulation. If the point or measurement functions also use
+      HDF5, then the HDF5 library must be built with thread safety
+      enabled.
+
       \note This class is experimental.
 
       \future Verbose output may need improvement
@@ -1503,9 +1781,244 @@ namespace o2scl {
       file write() (default 0)
   */
   size_t last_write;
+
+  /// \name Asynchronous file output
+  //@{
+  /// The background thread which writes to the file
+  std::thread write_thread;
+
+  /// An exception thrown by the background thread
+  std::exception_ptr write_error;
+
+  /// The number of rows of the table which have been written
+  size_t rows_written;
+
+  /// The rows to be written by the background thread
+  o2scl::table_units<> write_buf;
+
+  /// \name Copies of the output quantities for writing
+  //@{
+  std::vector<size_t> wbuf_n_accept;
+  std::vector<size_t> wbuf_n_reject;
+  std::vector<double> wbuf_pt_beta;
+  std::vector<size_t> wbuf_pt_swap_accept;
+  std::vector<size_t> wbuf_pt_swap_reject;
+  std::vector<size_t> wbuf_pt_swapped;
+  std::vector<std::vector<size_t> > wbuf_ret_value_counts;
+  //@}
+  //@}
+
+  /** \brief Copy the output quantities to the write buffer
+   */
+  void copy_counts() {
+    wbuf_n_accept=this->n_accept;
+    wbuf_n_reject=this->n_reject;
+    wbuf_pt_beta=this->pt_beta;
+    wbuf_pt_swap_accept=this->pt_swap_accept;
+    wbuf_pt_swap_reject=this->pt_swap_reject;
+    wbuf_pt_swapped=this->pt_swapped;
+    wbuf_ret_value_counts=this->ret_value_counts;
+    return;
+  }
+
+  /** \brief Write the settings (on the first write only) and the
+      output quantities copied by \ref copy_counts() to \c hf
+  */
+  void write_info(o2scl_hdf::hdf_file &hf) {
+    
+    if (first_write==false) {
+      hf.set_szt("max_iters",this->max_iters);
+      hf.sets("prefix",this->prefix);
+      hf.seti("aff_inv",this->aff_inv);
+      hf.setd("step_fac",this->step_fac);
+      hf.setd("ai_initial_step",this->ai_initial_step);
+      hf.set_szt("n_warm_up",this->n_warm_up);
+      hf.seti("user_seed",this->user_seed);
+      hf.seti("mpi_rank",this->mpi_rank);
+      hf.seti("mpi_size",this->mpi_size);
+      hf.seti("verbose",this->verbose);
+      hf.set_szt("max_bad_steps",this->max_bad_steps);
+      hf.set_szt("n_walk",this->n_walk);
+      hf.set_szt("n_walk_per_thread",this->n_walk_per_thread);
+      hf.set_szt("n_chains_per_rank",this->n_chains_per_rank);
+      hf.set_szt("n_threads",this->n_threads);
+      hf.set_szt("n_params",this->n_params);
+      hf.seti("always_accept",this->always_accept);
+      hf.seti("par_temp",this->par_temp);
+      hf.seti("allow_estimates",allow_estimates);
+      hf.setd_vec_copy("low",this->low_copy);
+      hf.setd_vec_copy("high",this->high_copy);
+      file_header(hf);
+      first_write=true;
+    }
+    
+    hf.set_szt_vec("n_accept",wbuf_n_accept);
+    hf.set_szt_vec("n_reject",wbuf_n_reject);
+    if (this->par_temp) {
+      hf.setd_vec("pt_beta",wbuf_pt_beta);
+      hf.set_szt_vec("pt_swap_accept",wbuf_pt_swap_accept);
+      hf.set_szt_vec("pt_swap_reject",wbuf_pt_swap_reject);
+      hf.set_szt_vec("pt_swapped",wbuf_pt_swapped);
+    }
+    hf.set_szt_arr2d_copy("ret_value_counts",wbuf_ret_value_counts.size(),
+			  wbuf_ret_value_counts[0].size(),
+			  wbuf_ret_value_counts);
+    hf.setd_arr2d_copy("initial_points",this->initial_points.size(),
+		       this->initial_points[0].size(),
+		       this->initial_points);
+
+    return;
+  }
+
+  /** \brief Write the rows in \ref write_buf to the file, 
+      beginning at row \c start of the table in the file
+
+      This function is run by the background thread. It only
+      uses the data in \ref write_buf and the copies of the 
+      output quantities, so that the simulation can continue.
+  */
+  void append_files(size_t start) {
+
+    o2scl_hdf::hdf_file hf;
+    std::string fname=this->prefix+"_"+o2scl::itos(this->mpi_rank)+"_out";
+    hf.open_or_create(fname);
+
+    write_info(hf);
+    hf.seti("n_tables",1);
+
+    if (start==0) {
+      
+      // Create the table
+      hdf_output(hf,write_buf,"markov_chain_0");
+      
+    } else {
+      
+      // Append the new rows to each column
+      hid_t top=hf.get_current_id();
+      hid_t group=hf.open_group("markov_chain_0");
+      hf.set_current_id(group);
+      hf.seti("nlines",((int)(start+write_buf.get_nlines())));
+      
+      hid_t group2=hf.open_group("data");
+      hf.set_current_id(group2);
+      if (write_buf.get_nlines()>0) {
+	for(size_t i=0;i<write_buf.get_ncolumns();i++) {
+	  std::string col=write_buf.get_column_name(i);
+	  hf.setd_arr_append(col,write_buf.get_nlines(),
+			     &(write_buf.get_column(col)[0]));
+	}
+      }
+      hf.close_group(group2);
+      
+      hf.set_current_id(group);
+      hf.close_group(group);
+      hf.set_current_id(top);
+    }
+
+    hf.close();
+    
+    return;
+  }
+
+  /** \brief Run \ref append_files() in the background thread,
+      storing any exception in \ref write_error
+  */
+  void append_files_thread(size_t start) {
+    try {
+      append_files(start);
+    } catch (...) {
+      write_error=std::current_exception();
+    }
+    return;
+  }
+
+  /** \brief Wait for the background thread to finish and rethrow
+      any exception which it stored
+  */
+  void join_write_thread() {
+    if (write_thread.joinable()) write_thread.join();
+    if (write_error) {
+      std::exception_ptr ep=write_error;
+      write_error=std::exception_ptr();
+      std::rethrow_exception(ep);
+    }
+    return;
+  }
+
+  /** \brief Copy the rows which will not change to \ref write_buf
+      and write them in a background thread
+
+      If \c final is true, then all of the remaining rows are
+      written and this function waits for the write to finish.
+  */
+  void write_async(bool final) {
+
+    // Wait for the previous write to finish before
+    // reusing the buffer
+    join_write_thread();
+
+    // Determine the rows which will not change. A row can change
+    // until its walker has accepted a later point, so only
+    // write the complete sets of rows before the earliest
+    // current row
+    size_t ntot=this->n_threads*this->n_walk;
+    size_t n_final=table->get_nlines();
+    if (!final) {
+      for(size_t i=0;i<walker_accept_rows.size();i++) {
+	if (walker_accept_rows[i]<0) {
+	  n_final=0;
+	} else if (((size_t)walker_accept_rows[i])<n_final) {
+	  n_final=walker_accept_rows[i];
+	}
+      }
+      n_final-=n_final%ntot;
+    }
+    if (n_final<rows_written) n_final=rows_written;
+
+    // Copy the new rows
+    size_t nnew=n_final-rows_written;
+    if (write_buf.get_ncolumns()!=table->get_ncolumns()) {
+      write_buf.clear();
+      for(size_t i=0;i<table->get_ncolumns();i++) {
+	std::string col=table->get_column_name(i);
+	write_buf.new_column(col);
+	write_buf.set_unit(col,table->get_unit(col));
+      }
+    }
+    write_buf.set_nlines(nnew);
+    for(size_t i=0;i<table->get_ncolumns();i++) {
+      for(size_t j=0;j<nnew;j++) {
+	write_buf.set(i,j,table->get(i,rows_written+j));
+      }
+    }
+    copy_counts();
+
+    if (this->verbose>=2) {
+      this->scr_out << "mcmc: Writing rows " << rows_written << " to "
+		    << n_final << " of " << table->get_nlines()
+		    << std::endl;
+    }
+    
+    size_t start=rows_written;
+    rows_written=n_final;
+
+    if (final) {
+      append_files(start);
+    } else {
+      write_thread=std::thread(&mcmc_para_table::append_files_thread,
+			       this,start);
+    }
+    
+    return;
+  }
   
   public:
 
+  /** \brief If true, write to the file in a background thread
+      (default false)
+  */
+  bool async_write;
+
   /** \brief Iterations between file updates (default 0 for no file updates)
    */
   size_t file_update_iters;
@@ -1518,6 +2031,11 @@ namespace o2scl {
    */
   virtual void write_files(bool sync_write=false) {
 
+    if (async_write && table_io_chunk<=1) {
+      write_async(false);
+      return;
+    }
+    
     if (this->verbose>=2) {
       this->scr_out << "mcmc: Start write_files(). mpi_rank: "
 		    << this->mpi_rank << " mpi_size: "
@@ -1564,39 +2082,8 @@ namespace o2scl {
     std::string fname=this->prefix+"_"+o2scl::itos(this->mpi_rank)+"_out";
     hf.open_or_create(fname);
 
-    if (first_write==false) {
-      hf.set_szt("max_iters",this->max_iters);
-      hf.sets("prefix",this->prefix);
-      hf.seti("aff_inv",this->aff_inv);
-      hf.setd("step_fac",this->step_fac);
-      hf.setd("ai_initial_step",this->ai_initial_step);
-      hf.set_szt("n_warm_up",this->n_warm_up);
-      hf.seti("user_seed",this->user_seed);
-      hf.seti("mpi_rank",this->mpi_rank);
-      hf.seti("mpi_size",this->mpi_size);
-      hf.seti("verbose",this->verbose);
-      hf.set_szt("max_bad_steps",this->max_bad_steps);
-      hf.set_szt("n_walk",this->n_walk);
-      hf.set_szt("n_walk_per_thread",this->n_walk_per_thread);
-      hf.set_szt("n_chains_per_rank",this->n_chains_per_rank);
-      hf.set_szt("n_threads",this->n_threads);
-      hf.set_szt("n_params",this->n_params);
-      hf.seti("always_accept",this->always_accept);
-      hf.seti("allow_estimates",allow_estimates);
-      hf.setd_vec_copy("low",this->low_copy);
-      hf.setd_vec_copy("high",this->high_copy);
-      file_header(hf);
-      first_write=true;
-    }
-    
-    hf.set_szt_vec("n_accept",this->n_accept);
-    hf.set_szt_vec("n_reject",this->n_reject);
-    hf.set_szt_arr2d_copy("ret_value_counts",this->ret_value_counts.size(),
-			  this->ret_value_counts[0].size(),
-			  this->ret_value_counts);
-    hf.setd_arr2d_copy("initial_points",this->initial_points.size(),
-		       this->initial_points[0].size(),
-		       this->initial_points);
+    copy_counts();
+    write_info(hf);
 
     hf.seti("n_tables",tab_arr.size()+1);
     if (rank_sent==false) {
@@ -1637,6 +2124,12 @@ namespace o2scl {
     file_update_iters=0;
     last_write=0;
     store_rejects=false;
+    async_write=false;
+    rows_written=0;
+  }
+
+  virtual ~mcmc_para_table() {
+    if (write_thread.joinable()) write_thread.join();
   }
   
   /// \name Basic usage
@@ -1819,6 +2312,10 @@ namespace o2scl {
 		   vec_t &low, vec_t &high, std::vector<func_t> &func,
 		   std::vector<fill_t> &fill) {
     
+    // Wait for any file output from a previous simulation
+    join_write_thread();
+    rows_written=0;
+    
     n_params=n_params_local;
     low_copy=low;
     high_copy=high;
@@ -2076,7 +2573,11 @@ namespace o2scl {
       table->set_nlines(i+2);
     }
 
-    write_files(true);
+    if (async_write && table_io_chunk<=1) {
+      write_async(true);
+    } else {
+      write_files(true);
+    }
     
     return parent_t::mcmc_cleanup();
   }
@@ -2234,6 +2735,7 @@ namespace o2scl {
   o2scl::cli::parameter_size_t p_max_iters;
   //o2scl::cli::parameter_int p_max_chain_size;
   o2scl::cli::parameter_size_t p_file_update_iters;
+  o2scl::cli::parameter_bool p_async_write;
   o2scl::cli::parameter_bool p_output_meas;
   o2scl::cli::parameter_string p_prefix;
   o2scl::cli::parameter_int p_verbose;
@@ -2295,6 +2797,11 @@ namespace o2scl {
       "between file upates (default 0 for no file updates).";
     cl.par_list.insert(std::make_pair("file_update_iters",
 				      &p_file_update_iters));
+
+    p_async_write.b=&this->async_write;
+    p_async_write.help=((std::string)"If true, append new rows to the ")+
+      "output file in a background thread (default false).";
+    cl.par_list.insert(std::make_pair("async_write",&p_async_write));
     
     /*
       p_max_chain_size.i=&this->max_chain_size;
@@ -83,6 +83,27 @@ public:
     return exp(-pars[0]*pars[0]/2.0)*pars[0]*pars[0];
   }
 
+  /// Number of points in each mode for each thread
+  std::vector<size_t> n_left, n_right;
+
+  /// Two narrow Gaussians separated by a large barrier
+  int point_bimodal(size_t nv, const ubvector &pars, double &ret,
+		    std::array<double,1> &dat) {
+    dat[0]=pars[0]*pars[0];
+    double x1=(pars[0]+3.0)/0.1, x2=(pars[0]-1.0)/0.1;
+    ret=log(exp(-x1*x1/2.0)+exp(-x2*x2/2.0));
+    if (!std::isfinite(ret)) return 1;
+    return o2scl::success;
+  }
+
+  int measure_bimodal(const ubvector &pars, double log_weight, size_t ix,
+		      bool new_meas, std::array<double,1> &dat,
+		      size_t it) {
+    if (pars[0]<-1.0) n_left[it]++;
+    else n_right[it]++;
+    return 0;
+  }
+  
   int measure(const ubvector &pars, double log_weight, size_t ix,
 	      bool new_meas, std::array<double,1> &dat) {
     /*
@@ -298,6 +319,130 @@ int main(int argc, char *argv[]) {
   hf.set_szt_vec("n_reject",mpc.mct.n_reject);
   hf.close();
 
+  // ----------------------------------------------------------------
+  // Plain MCMC with a table and asynchronous file output. The
+  // table in the file should be the same as the final table.
+
+  cout << "Plain MCMC with a table and asynchronous output: " << endl;
+
+  mpc.mct.aff_inv=false;
+  mpc.mct.n_walk=1;
+  mpc.mct.verbose=1;
+  mpc.mct.max_iters=400;
+  mpc.mct.file_update_iters=10;
+  mpc.mct.async_write=true;
+  mpc.mct.prefix="mcmct_async";
+  mpc.mct.mcmc(1,low,high,vpf,vff);
+
+  table=mpc.mct.get_table();
+  {
+    table_units<> tfile;
+    hf.open("mcmct_async_0_out");
+    hdf_input(hf,tfile,"markov_chain_0");
+    hf.close();
+    tm.test_gen(tfile.get_nlines()==table->get_nlines(),"async nlines");
+    tm.test_gen(tfile.get_ncolumns()==table->get_ncolumns(),
+		"async ncolumns");
+    size_t n_diff=0;
+    for(size_t i=0;i<table->get_ncolumns();i++) {
+      for(size_t j=0;j<table->get_nlines();j++) {
+	if (tfile.get(i,j)!=table->get(i,j)) n_diff++;
+      }
+    }
+    tm.test_gen(n_diff==0,"async data");
+  }
+
+  // An error in the background thread is passed on to the caller
+  mpc.mct.prefix="mcmct_no_such_dir/mcmct_async";
+  bool async_caught=false;
+  try {
+    mpc.mct.mcmc(1,low,high,vpf,vff);
+  } catch (std::exception &e) {
+    async_caught=true;
+  }
+  tm.test_gen(async_caught,"async error");
+  mpc.mct.async_write=false;
+  mpc.mct.file_update_iters=0;
+  
+  // ----------------------------------------------------------------
+  // Parallel tempering with a bimodal distribution. The chain at
+  // unit temperature should find both modes.
+
+#ifdef O2SCL_OPENMP
+  
+  cout << "Parallel tempering: " << endl;
+
+  {
+    size_t n_pt=4;
+    mpc.n_left.resize(n_pt);
+    mpc.n_right.resize(n_pt);
+    vector<point_funct> vpf2(n_pt);
+    vector<measure_funct> vmf2(n_pt);
+    for(size_t i=0;i<n_pt;i++) {
+      mpc.n_left[i]=0;
+      mpc.n_right[i]=0;
+      vpf2[i]=std::bind
+	(std::mem_fn<int(size_t,const ubvector &,double &,
+			 std::array<double,1> &)>
+	 (&mcmc_para_class::point_bimodal),&mpc,std::placeholders::_1,
+	 std::placeholders::_2,std::placeholders::_3,std::placeholders::_4);
+      vmf2[i]=std::bind
+	(std::mem_fn<int(const ubvector &,double,size_t,bool,
+			 std::array<double,1> &,size_t)>
+	 (&mcmc_para_class::measure_bimodal),&mpc,std::placeholders::_1,
+	 std::placeholders::_2,std::placeholders::_3,std::placeholders::_4,
+	 std::placeholders::_5,i);
+    }
+
+    mcmc_para_base<point_funct,measure_funct,std::array<double,1>,
+		   ubvector> mpt;
+    mpt.n_threads=n_pt;
+    mpt.step_fac=40.0;
+    mpt.max_iters=20000;
+    mpt.user_seed=1;
+    mpt.par_temp=true;
+    mpt.pt_max_temp=1000.0;
+    mpt.initial_points.resize(1);
+    mpt.initial_points[0].resize(1);
+    mpt.initial_points[0][0]=-3.0;
+    mpt.mcmc(1,low,high,vpf2,vmf2);
+
+    tm.test_rel(mpt.pt_beta[0],1.0,1.0e-12,"pt beta 0");
+    tm.test_rel(mpt.pt_beta[n_pt-1],1.0e-3,1.0e-12,"pt beta last");
+    size_t n_tot=mpc.n_left[0]+mpc.n_right[0];
+    cout << "Left and right modes in chain 0: " << mpc.n_left[0] << " "
+	 << mpc.n_right[0] << endl;
+    tm.test_gen(mpc.n_left[0]>n_tot/10,"pt left mode");
+    tm.test_gen(mpc.n_right[0]>n_tot/10,"pt right mode");
+    for(size_t i=0;i+1<n_pt;i++) {
+      tm.test_gen(mpt.pt_swap_accept[i]>0,"pt swaps");
+    }
+    tm.test_gen(mpt.pt_swapped[0]==mpt.pt_swap_accept[0],"pt swapped 0");
+  }
+
+  // Parallel tempering with a table. Each accepted swap adds a
+  // row to the table.
+  
+  cout << "Parallel tempering with a table: " << endl;
+
+  {
+    mpc.mct.prefix="mcmct_pt";
+    mpc.mct.max_iters=400;
+    mpc.mct.par_temp=true;
+    mpc.mct.mcmc(1,low,high,vpf,vff);
+
+    vector<size_t> chain_sizes;
+    mpc.mct.get_chain_sizes(chain_sizes);
+    tm.test_gen(mpc.mct.pt_swap_accept[0]>0,"pt table swaps");
+    for(size_t i=0;i<2;i++) {
+      tm.test_gen(chain_sizes[i]==mpc.mct.n_accept[i]+
+		  mpc.mct.pt_swapped[i]+1,"pt table size");
+    }
+    mpc.mct.par_temp=false;
+  }
+
+#endif
+
   tm.report();
   
   return 0;
@@ -47,6 +47,7 @@
     \brief File defining \ref o2scl::mmin_simp2
 */
 #include <string>
+#include <vector>
 
 #include <boost/numeric/ublas/vector.hpp>
 
@@ -115,6 +116,18 @@ namespace o2scl {
       A variable <tt>count</tt> originally defined in the GSL simplex
       state is not present here, because it was unused.
 
+      If \ref parallel is true and \c O2SCL_OPENMP is defined, then
+      each iteration evaluates the reflected, expanded, and both
+      contracted trial points simultaneously, and the points of a
+      contracted simplex (and of the initial simplex) are also
+      evaluated simultaneously. The sequence of simplices is the same
+      as in the serial version, but more function evaluations are
+      performed, so this is only useful if the function is expensive
+      and there are at least four threads. In this case the function
+      must be safe to call from several threads at once. See also
+      \ref mmin_simp2_mstart, which runs several independent
+      simplices in parallel.
+
       \future Double check that the updates in gsl-1.13 are included
       here, and also add support for the nmsimplex2rand algorithm
       in GSL.
@@ -147,6 +160,8 @@ namespace o2scl {
   vec_t ws2;
   /// Workspace vector 3
   vec_t ws3;
+  /// Workspace vector 4
+  vec_t ws4;
   /// Center of simplex
   vec_t center;
   /// Desc
@@ -197,6 +212,59 @@ namespace o2scl {
     return sqrt(ss/(double)(P));
   }
 
+  /** \brief Compute the point which moves corner \c xcorner of a
+      simplex with center \c ctr by \c coeff, storing the result
+      in \c xc
+
+      This is the same point as in \ref try_corner_move(), but
+      without evaluating the function.
+  */
+  void corner_point(const double coeff, const vec_t &xcorner,
+		    const vec_t &ctr, vec_t &xc) {
+	
+    size_t P=dim+1;
+    double alpha=(1.0-coeff)*((double)P)/((double)dim);
+    double beta=(((double)P)*coeff-1.0)/((double)dim);
+	
+    for(size_t j=0;j<dim;j++) {
+      xc[j]=ctr[j]*alpha;
+      xc[j]+=xcorner[j]*beta;
+    }
+
+    return;
+  }
+
+  /** \brief Return true if the trial points should be evaluated
+      in parallel
+
+      This is always false unless \c O2SCL_OPENMP is defined, so
+      that the serial algorithm is used in that case.
+  */
+  bool use_parallel() {
+#ifdef O2SCL_OPENMP
+    if (parallel && avoid_nonzero) {
+      O2SCL_ERR2("Parallel evaluation does not support avoid_nonzero ",
+		 "in mmin_simp2::use_parallel().",exc_eunimpl);
+    }
+    return parallel;
+#else
+    return false;
+#endif
+  }
+
+  /** \brief Evaluate the function at the \c n points in \c pts
+      in parallel, storing the results in \c vals
+  */
+  void eval_parallel(size_t n, vec_t **pts, double *vals) {
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+    for(size_t k=0;k<n;k++) {
+      vals[k]=(*func)(dim,*(pts[k]));
+    }
+    return;
+  }
+
   /** \brief Move a corner of a simplex
 
       Moves a simplex corner scaled by coeff (negative value
@@ -290,6 +358,36 @@ namespace o2scl {
     bool failed;
 
     int status=success;
+
+    if (use_parallel()) {
+
+      std::vector<vec_t *> pts;
+      std::vector<size_t> ix;
+      for (i=0;i<dim+1;i++) {
+	if (i!=best) {
+	  for (j=0;j<dim;j++) {
+	    x1[i][j]=0.5*(x1[i][j]+x1[best][j]);
+	  }
+	  pts.push_back(&x1[i]);
+	  ix.push_back(i);
+	}
+      }
+      std::vector<double> vals(pts.size());
+      eval_parallel(pts.size(),&pts[0],&vals[0]);
+      for (size_t k=0;k<pts.size();k++) {
+	y1[ix[k]]=vals[k];
+	if (!std::isfinite(vals[k])) {
+	  std::string err=((std::string)"Function not finite (returned ")+
+	    dtos(vals[k])+" in mmin_simp2::contract_by_best().";
+	  O2SCL_ERR(err.c_str(),exc_ebadfunc);
+	}
+      }
+
+      compute_center();
+      size=compute_size();
+	
+      return success;
+    }
 	
     for (i=0;i<dim+1;i++) {
 	
@@ -341,6 +439,119 @@ namespace o2scl {
     return success;
   }
 
+  /** \brief Store the lowest point of the simplex in \ref x and
+      update the simplex size at the end of an iteration
+  */
+  void finish_iteration() {
+    
+    size_t lo;
+    double val;
+
+    /* return lowest point of simplex as x */
+      
+    vector_min(dim+1,y1,lo,val);
+    for(size_t i=0;i<dim;i++) x[i]=x1[lo][i];
+    fval=y1[lo];
+      
+    /* Update simplex size */
+	
+    if (S2 > 0) {
+      size=sqrt(S2);
+    } else {
+      /* recompute if accumulated error has made size invalid */
+      size=compute_size();
+    }
+
+    return;
+  }
+
+  /** \brief Perform an iteration, evaluating the trial points
+      in parallel
+
+      The reflected point, the expanded point, the point contracted
+      towards the center, and the point obtained by contracting the
+      reflected point (after it has replaced the highest point) are
+      evaluated simultaneously. The choice between them is the same
+      as in the serial version of \ref iterate().
+  */
+  int iterate_parallel(size_t lo, size_t hi, size_t s_hi) {
+
+    // The reflected, expanded, and contracted points
+    corner_point(-1.0,x1[hi],center,ws1);
+    corner_point(-2.0,x1[hi],center,ws2);
+    corner_point(0.5,x1[hi],center,ws3);
+
+    // The contraction of the reflected point, computed with the
+    // center which results from replacing the highest point with
+    // the reflected point, as in update_point()
+    double alpha=1.0/((double)(dim+1));
+    for(size_t j=0;j<dim;j++) {
+      xmc[j]=center[j];
+      xmc[j]-=alpha*x1[hi][j];
+      xmc[j]+=alpha*ws1[j];
+    }
+    corner_point(0.5,ws1,xmc,ws4);
+
+    vec_t *pts[4]={&ws1,&ws2,&ws3,&ws4};
+    double vals[4];
+    eval_parallel(4,pts,vals);
+    double val=vals[0];
+
+    if (std::isfinite(val) && val<y1[lo]) {
+
+      /* reflected point becomes lowest point, try expansion */
+
+      if (std::isfinite(vals[1]) && vals[1]<y1[lo]) {
+	update_point(hi,ws2,vals[1]);
+      } else {
+	update_point(hi,ws1,val);
+      }
+	  
+    } else if (!std::isfinite(val) || val > y1[s_hi]) {
+	
+      /* reflection does not improve things enough */
+
+      vec_t *pc=&ws3;
+      double valc=vals[2];
+	
+      if (std::isfinite(val) && val <= y1[hi]) {
+	    
+	/* if trial point is better than highest point, replace
+	   highest point and use the contraction of the new point */
+	    
+	update_point(hi,ws1,val);
+	pc=&ws4;
+	valc=vals[3];
+      }
+      
+      if (std::isfinite(valc) && valc <= y1[hi]) {
+
+	update_point(hi,*pc,valc);
+
+      } else {
+
+	/* contract the whole simplex in respect to the best point */
+	int status=contract_by_best(lo,*func,dim);
+	if(status != 0) {
+	  O2SCL_ERR("Function contract_by_best() failed in iterate().",
+		    exc_efailed);
+	}
+	    
+      }
+
+    } else {
+
+      /* trial point is better than second highest point.
+	 Replace highest point by it */
+	  
+      update_point(hi,ws1,val);
+    }
+
+    finish_iteration();
+  
+    return success;
+  }
+
   /// Number of variables to be mind over
   size_t dim;
 
@@ -371,6 +582,7 @@ namespace o2scl {
     step_vec.resize(1);
     step_vec[0]=1.0;
     avoid_nonzero=false;
+    parallel=false;
   }
     
   virtual ~mmin_simp2() {
@@ -404,6 +616,17 @@ namespace o2scl {
   */
   int print_simplex;
 
+  /** \brief If true, evaluate the trial points in parallel
+      (default false)
+
+      This has no effect unless \c O2SCL_OPENMP is defined. The
+      parallel iteration evaluates the function directly rather than
+      through \ref try_corner_move(), so it cannot be combined with
+      \ref avoid_nonzero. See the class documentation for more
+      information.
+  */
+  bool parallel;
+
   /** \brief Calculate the minimum \c min of \c func w.r.t the
       array \c x of size \c nvar.
   */
@@ -562,6 +785,7 @@ namespace o2scl {
     ws1.resize(n);
     ws2.resize(n);
     ws3.resize(n);
+    ws4.resize(n);
     center.resize(n);
     delta.resize(n);
     xmc.resize(n);
@@ -580,22 +804,44 @@ namespace o2scl {
     // Copy initial guess to x
     for (i=0;i<dim;i++) x[i]=ax[i];
       
-    // first point is the original x0 
+    if (use_parallel()) {
+
+      for(i=0;i<dim;i++) x1[0][i]=ax[i];
+      for (i=1;i<dim+1;i++) {
+	for(size_t j=0;j<dim;j++) x1[i][j]=x[j];
+	x1[i][i-1]=x1[i][i-1]+step_size[i-1];
+      }
+      std::vector<vec_t *> pts(dim+1);
+      std::vector<double> vals(dim+1);
+      for (i=0;i<dim+1;i++) pts[i]=&x1[i];
+      eval_parallel(dim+1,&pts[0],&vals[0]);
+      for (i=0;i<dim+1;i++) y1[i]=vals[i];
+      if (!std::isfinite(y1[0])) {
+	std::string err=((std::string)"Function not finite (returned ")+
+	  dtos(y1[0])+" in mmin_simp2::set().";
+	O2SCL_ERR(err.c_str(),exc_ebadfunc);
+      }
+
+    } else {
+
+      // first point is the original x0 
       
-    y1[0]=ufunc(dim,ax);
-    if (!std::isfinite(y1[0])) {
-      std::string err=((std::string)"Function not finite (returned ")+
-	dtos(y1[0])+" in mmin_simp2::set().";
-      O2SCL_ERR(err.c_str(),exc_ebadfunc);
-    }
-    for(i=0;i<dim;i++) x1[0][i]=ax[i];
+      y1[0]=ufunc(dim,ax);
+      if (!std::isfinite(y1[0])) {
+	std::string err=((std::string)"Function not finite (returned ")+
+	  dtos(y1[0])+" in mmin_simp2::set().";
+	O2SCL_ERR(err.c_str(),exc_ebadfunc);
+      }
+      for(i=0;i<dim;i++) x1[0][i]=ax[i];
   
-    /* following points are initialized to x0+step_size */
+      /* following points are initialized to x0+step_size */
       
-    for (i=1;i<dim+1;i++) {
-      for(size_t j=0;j<dim;j++) x1[i][j]=x[j];
-      x1[i][i-1]=x1[i][i-1]+step_size[i-1];
-      y1[i]=ufunc(dim,x1[i]);
+      for (i=1;i<dim+1;i++) {
+	for(size_t j=0;j<dim;j++) x1[i][j]=x[j];
+	x1[i][i-1]=x1[i][i-1]+step_size[i-1];
+	y1[i]=ufunc(dim,x1[i]);
+      }
+
     }
  
     /* Initialize simplex size */
@@ -674,6 +920,10 @@ namespace o2scl {
       }
     }
 
+    if (use_parallel()) {
+      return iterate_parallel(lo,hi,s_hi);
+    }
+
     /* reflect the highest value */
 	
     int ret1=try_corner_move(-1.0,hi,ws1,*func,dim,val);
@@ -768,20 +1018,7 @@ namespace o2scl {
       update_point(hi,ws1,val);
     }
   
-    /* return lowest point of simplex as x */
-      
-    vector_min(dim+1,y1,lo,val);
-    for(i=0;i<dim;i++) x[i]=x1[lo][i];
-    fval=y1[lo];
-      
-    /* Update simplex size */
-	
-    if (S2 > 0) {
-      size=sqrt(S2);
-    } else {
-      /* recompute if accumulated error has made size invalid */
-      size=compute_size();
-    }
+    finish_iteration();
 
     return success;
   }
@@ -0,0 +1,394 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_MMIN_SIMP2_MSTART_H
+#define O2SCL_MMIN_SIMP2_MSTART_H
+
+/** \file mmin_simp2_mstart.h
+    \brief File defining \ref o2scl::mmin_simp2_mstart
+*/
+#include <vector>
+#include <exception>
+#include <limits>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <o2scl/mmin_simp2.h>
+#include <o2scl/rng_gsl.h>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief Multidimensional minimization with several simplices
+      started from different points
+
+      This class runs \ref n_starts independent minimizations with
+      \ref mmin_simp2 and returns the best point found by any of
+      them. If \c O2SCL_OPENMP is defined, the minimizations are
+      divided between threads, in which case the function must be
+      safe to call from several threads at once.
+
+      The best point found so far is shared between the
+      minimizations. In \ref mmin(), the first simplex begins at the
+      initial guess and each of the others begins at the best point
+      found so far (at the time that minimization starts) shifted by
+      a random amount up to the step size (see \ref set_step()) in
+      each direction. The starting points of all the simplices can
+      also be given explicitly with \ref mmin_starts().
+
+      Each individual minimization stops when the simplex size is
+      smaller than \ref tol_abs or after \ref ntrial iterations. The
+      values \ref start_fmin and \ref start_iters record the result
+      of each minimization. When \c O2SCL_OPENMP is defined and more
+      than one thread is used, the starting points generated by \ref
+      mmin() depend on the order in which the minimizations finish,
+      so the results may vary from run to run.
+
+      If one of the minimizations calls the error handler (for
+      example, because the function is not finite at a randomly
+      chosen starting point), the exception is caught, that
+      minimization is recorded as failed in \ref start_fmin and
+      \ref start_iters, and the others continue. The number of
+      failed minimizations is stored in \ref n_failed. If all of
+      them fail, the first exception is rethrown after the loop.
+  */
+  template<class func_t=multi_funct,
+    class vec_t=boost::numeric::ublas::vector<double> >
+    class mmin_simp2_mstart : public mmin_base<func_t,func_t,vec_t> {
+
+  public:
+
+  typedef boost::numeric::ublas::vector<double> ubvector;
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+  /// Vector of step sizes
+  ubvector step_vec;
+
+  /// The best point found so far
+  ubvector best_x;
+
+  /// The function value at \ref best_x
+  double best_f;
+
+  /// True if \ref best_x has been set
+  bool best_set;
+
+  /// The first exception thrown by one of the minimizations
+  std::exception_ptr first_error;
+
+  /** \brief Update the shared best point with \c x and \c f
+      if \c f is smaller
+  */
+  void update_best(size_t nn, const vec_t &x, double f) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_mmin_simp2_mstart)
+#endif
+    {
+      if (std::isfinite(f) && (!best_set || f<best_f)) {
+	for(size_t j=0;j<nn;j++) best_x[j]=x[j];
+	best_f=f;
+	best_set=true;
+      }
+    }
+    return;
+  }
+
+  /** \brief Copy the shared best point to \c x, returning false
+      if no point has been found yet
+  */
+  bool get_best(size_t nn, vec_t &x) {
+    bool ret;
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_mmin_simp2_mstart)
+#endif
+    {
+      ret=best_set;
+      if (best_set) {
+	for(size_t j=0;j<nn;j++) x[j]=best_x[j];
+      }
+    }
+    return ret;
+  }
+
+  /** \brief Run the minimization with index \c k starting at \c x0
+   */
+  void run_one(size_t k, size_t nn, vec_t &x0, func_t &ufunc) {
+
+    mmin_simp2<func_t,vec_t> ms;
+    ms.ntrial=this->ntrial;
+    ms.tol_abs=this->tol_abs;
+    ms.err_nonconv=false;
+
+    vec_t ss(nn);
+    for (size_t is=0;is<nn;is++) ss[is]=step_vec[is % step_vec.size()];
+
+    // An exception must not escape the OpenMP loop which calls
+    // this function, so it is stored and handled in finish()
+    int iter=0;
+    try {
+
+      ms.allocate(nn);
+      ms.set(ufunc,nn,x0,ss);
+
+      int status;
+      do {
+	iter++;
+	status=ms.iterate();
+	if (status) break;
+	update_best(nn,ms.x,ms.fval);
+	status=gsl_multimin_test_size(ms.size,this->tol_abs);
+      } while (status==GSL_CONTINUE && iter<this->ntrial);
+
+    } catch (...) {
+
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_mmin_simp2_mstart)
+#endif
+      {
+	if (!first_error) first_error=std::current_exception();
+      }
+      start_fmin[k]=std::numeric_limits<double>::infinity();
+      start_iters[k]=-1;
+
+      if (this->verbose>0) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_mmin_simp2_mstart_output)
+#endif
+	{
+	  (*this->outs) << "mmin_simp2_mstart: start " << k
+			<< " failed after " << iter << " iters."
+			<< std::endl;
+	}
+      }
+      return;
+    }
+
+    start_fmin[k]=ms.fval;
+    start_iters[k]=iter;
+
+    if (this->verbose>0) {
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_mmin_simp2_mstart_output)
+#endif
+      {
+	(*this->outs) << "mmin_simp2_mstart: start " << k << " iters: "
+		      << iter << " fmin: " << ms.fval << std::endl;
+      }
+    }
+
+    return;
+  }
+
+#endif
+
+  public:
+
+  mmin_simp2_mstart() {
+    n_starts=8;
+    seed=1;
+    n_failed=0;
+    step_vec.resize(1);
+    step_vec[0]=1.0;
+  }
+
+  virtual ~mmin_simp2_mstart() {
+  }
+
+  /// The number of minimizations performed by \ref mmin() (default 8)
+  size_t n_starts;
+
+  /** \brief The seed for the random number generator used to
+      choose the starting points in \ref mmin() (default 1)
+
+      Minimization \c k uses a generator with seed <tt>seed+k</tt>.
+  */
+  unsigned long int seed;
+
+  /// The function value found by each minimization
+  std::vector<double> start_fmin;
+
+  /** \brief The number of iterations used by each minimization
+
+      This is -1 for a minimization which was stopped by an
+      error, in which case the corresponding entry in \ref
+      start_fmin is infinite.
+  */
+  std::vector<int> start_iters;
+
+  /// The number of minimizations which were stopped by an error
+  size_t n_failed;
+
+  /// Set the step sizes for each independent variable
+  template<class vec2_t> int set_step(size_t nv, vec2_t &step) {
+    if (nv>0) {
+      step_vec.resize(nv);
+      for(size_t i=0;i<nv;i++) step_vec[i]=step[i];
+    }
+    return 0;
+  }
+
+  /** \brief Calculate the minimum \c fmin of \c ufunc w.r.t the
+      array \c xx of size \c nn.
+  */
+  virtual int mmin(size_t nn, vec_t &xx, double &fmin,
+		   func_t &ufunc) {
+
+    if (nn==0) {
+      O2SCL_ERR2("Tried to min over zero variables ",
+		 " in mmin_simp2_mstart::mmin().",exc_einval);
+    }
+    if (n_starts==0) {
+      O2SCL_ERR2("Number of starting points is zero ",
+		 " in mmin_simp2_mstart::mmin().",exc_einval);
+    }
+
+    best_x.resize(nn);
+    best_set=false;
+    first_error=std::exception_ptr();
+    start_fmin.resize(n_starts);
+    start_iters.resize(n_starts);
+
+    // Run the first minimization from the initial guess in
+    // parallel with the others
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+    for(size_t k=0;k<n_starts;k++) {
+      vec_t x0(nn);
+      if (k==0 || !get_best(nn,x0)) {
+	for(size_t j=0;j<nn;j++) x0[j]=xx[j];
+      }
+      if (k>0) {
+	rng_gsl gr;
+	gr.set_seed(seed+k);
+	for(size_t j=0;j<nn;j++) {
+	  x0[j]+=step_vec[j % step_vec.size()]*(2.0*gr.random()-1.0);
+	}
+      }
+      run_one(k,nn,x0,ufunc);
+    }
+
+    return finish(nn,xx,fmin,"mmin");
+  }
+
+  /** \brief Calculate the minimum \c fmin of \c ufunc w.r.t the
+      array \c xx of size \c nn, using the \c ns starting points
+      in the rows of \c starts
+
+      The number of minimizations is \c ns rather than \ref
+      n_starts.
+  */
+  template<class mat_t>
+  int mmin_starts(size_t nn, size_t ns, const mat_t &starts,
+		  vec_t &xx, double &fmin, func_t &ufunc) {
+
+    if (nn==0 || ns==0) {
+      O2SCL_ERR2("Tried to min over zero variables or zero starting ",
+		 "points in mmin_simp2_mstart::mmin_starts().",exc_einval);
+    }
+
+    best_x.resize(nn);
+    best_set=false;
+    first_error=std::exception_ptr();
+    start_fmin.resize(ns);
+    start_iters.resize(ns);
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+    for(size_t k=0;k<ns;k++) {
+      vec_t x0(nn);
+      for(size_t j=0;j<nn;j++) x0[j]=starts(k,j);
+      run_one(k,nn,x0,ufunc);
+    }
+
+    return finish(nn,xx,fmin,"mmin_starts");
+  }
+
+  /// Return string denoting type("mmin_simp2_mstart")
+  virtual const char *type() { return "mmin_simp2_mstart";}
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+  /** \brief Copy the best point to \c xx and \c fmin and
+      check for convergence
+  */
+  int finish(size_t nn, vec_t &xx, double &fmin, std::string func_name) {
+
+    n_failed=0;
+    for(size_t k=0;k<start_iters.size();k++) {
+      if (start_iters[k]<0) n_failed++;
+    }
+
+    // If every minimization failed, pass on the first error
+    if (n_failed==start_iters.size()) {
+      std::rethrow_exception(first_error);
+    }
+
+    if (!best_set) {
+      O2SCL_CONV2_RET("No finite function values found in ",
+		      ((std::string)"mmin_simp2_mstart::")+func_name+"().",
+		      exc_efailed,this->err_nonconv);
+    }
+    for(size_t j=0;j<nn;j++) xx[j]=best_x[j];
+    fmin=best_f;
+
+    // Report failure only if no minimization converged
+    int max_iters=0, min_iters=this->ntrial;
+    for(size_t k=0;k<start_iters.size();k++) {
+      if (start_iters[k]>=0) {
+	if (start_iters[k]>max_iters) max_iters=start_iters[k];
+	if (start_iters[k]<min_iters) min_iters=start_iters[k];
+      }
+    }
+    this->last_ntrial=max_iters;
+    if (min_iters>=this->ntrial) {
+      std::string str="Exceeded maximum number of iterations ("+
+	itos(this->ntrial)+") in mmin_simp2_mstart::"+func_name+"().";
+      O2SCL_CONV_RET(str.c_str(),exc_emaxiter,this->err_nonconv);
+    }
+
+    return success;
+  }
+
+  private:
+
+  mmin_simp2_mstart<func_t,vec_t>
+  (const mmin_simp2_mstart<func_t,vec_t> &);
+  mmin_simp2_mstart<func_t,vec_t>& operator=
+  (const mmin_simp2_mstart<func_t,vec_t>&);
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
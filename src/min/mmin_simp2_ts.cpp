@@ -24,6 +24,7 @@
 
 #include <o2scl/multi_funct.h>
 #include <o2scl/mmin_simp2.h>
+#include <o2scl/mmin_simp2_mstart.h>
 #include <o2scl/test_mgr.h>
 #ifdef O2SCL_EIGEN
 #include <eigen3/Eigen/Dense>
@@ -50,6 +51,21 @@ double minfun2(size_t n, const ubvector &x) {
   return ret;
 }
 
+// A function with many local minima and a global minimum at (1,1)
+double minfun_multi(size_t n, const ubvector &x) {
+  double ret=0.0;
+  for(size_t i=0;i<n;i++) {
+    ret+=(x[i]-1.0)*(x[i]-1.0)+2.0*(1.0-cos(6.0*(x[i]-1.0)));
+  }
+  return ret;
+}
+
+// The same function, but not finite when x[0] is less than -5
+double minfun_multi_nan(size_t n, const ubvector &x) {
+  if (x[0]<-5.0) return std::numeric_limits<double>::quiet_NaN();
+  return minfun_multi(n,x);
+}
+
 #ifdef O2SCL_EIGEN
 double minfun_Eigen(size_t n, const VectorXd &x) {
   double ret;
@@ -121,6 +137,73 @@ int main(void) {
   t.test_abs(simp(0,0),0.0,1.0e-4,"mmin_simp2 full simplex 1");
   t.test_rel(simp(0,1),2.0,2.0e-4,"mmin_simp2 full simplex 2");
 
+  // Parallel evaluation of trial points gives the same simplices
+
+  {
+    mmin_simp2<multi_funct> gp;
+    gp.parallel=true;
+    ubvector xs(2), xp(2);
+    double mins, minp;
+    xs[0]=1.1;
+    xs[1]=0.9;
+    xp[0]=1.1;
+    xp[1]=0.9;
+    g.mmin(2,xs,mins,mf);
+    gp.mmin(2,xp,minp,mf);
+    t.test_rel(minp,mins,1.0e-12,"mmin_simp2 parallel 1");
+    t.test_rel(xp[0],xs[0],1.0e-10,"mmin_simp2 parallel 2");
+    t.test_rel(xp[1],xs[1],1.0e-10,"mmin_simp2 parallel 3");
+    t.test_gen(gp.last_ntrial==g.last_ntrial,"mmin_simp2 parallel 4");
+  }
+
+  // Multiple starting points
+
+  {
+    multi_funct mf_multi=minfun_multi;
+    mmin_simp2<multi_funct> gs;
+    mmin_simp2_mstart<multi_funct> gm;
+    ubvector xs(2), xm(2), step(1);
+    double mins, minm;
+    xs[0]=3.0;
+    xs[1]=-2.0;
+    xm[0]=3.0;
+    xm[1]=-2.0;
+    step[0]=2.0;
+    gs.set_step(1,step);
+    gm.set_step(1,step);
+    gs.err_nonconv=false;
+    gm.n_starts=16;
+    gs.mmin(2,xs,mins,mf_multi);
+    gm.mmin(2,xm,minm,mf_multi);
+    t.test_gen(minm<=mins,"mmin_simp2_mstart 1");
+    t.test_gen(gm.start_fmin.size()==16,"mmin_simp2_mstart 2");
+    for(size_t k=0;k<16;k++) {
+      t.test_gen(gm.start_fmin[k]>=minm,"mmin_simp2_mstart 3");
+    }
+
+    // Explicit starting points, one of them near the global minimum
+    ubmatrix starts(3,2);
+    starts(0,0)=3.0;
+    starts(0,1)=-2.0;
+    starts(1,0)=-2.0;
+    starts(1,1)=3.0;
+    starts(2,0)=1.2;
+    starts(2,1)=0.9;
+    gm.mmin_starts(2,3,starts,xm,minm,mf_multi);
+    t.test_rel(xm[0],1.0,1.0e-3,"mmin_simp2_mstart 4");
+    t.test_rel(xm[1],1.0,1.0e-3,"mmin_simp2_mstart 5");
+    t.test_abs(minm,0.0,1.0e-6,"mmin_simp2_mstart 6");
+
+    // A starting point where the function is not finite is
+    // recorded as a failure and the others continue
+    multi_funct mf_nan=minfun_multi_nan;
+    starts(0,0)=-8.0;
+    gm.mmin_starts(2,3,starts,xm,minm,mf_nan);
+    t.test_gen(gm.n_failed==1,"mmin_simp2_mstart 7");
+    t.test_gen(gm.start_iters[0]==-1,"mmin_simp2_mstart 8");
+    t.test_abs(minm,0.0,1.0e-6,"mmin_simp2_mstart 9");
+  }
+
 #ifdef O2SCL_EIGEN
 
   // Test with Eigen
@@ -98,6 +98,7 @@ void o2scl_hdf::ame_load(o2scl::nucmass_ame &ame, std::string file_name,
   ame.mass=m;
   ame.reference=reference;
   ame.last=nrecords/2;
+  ame.make_index(nrecords,m);
     
   hf.close();
 
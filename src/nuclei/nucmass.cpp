@@ -280,6 +280,18 @@ double nucmass_semi_empirical::mass_excess_d(double Z, double N) {
   return ret;
 }
 
+int nucmass_semi_empirical::mass_excess_many(size_t n, const int *Z,
+					     const int *N, double *mex) {
+  int nn=((int)n);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+  for(int i=0;i<nn;i++) {
+    mex[i]=mass_excess_d(Z[i],N[i]);
+  }
+  return 0;
+}
+
 int nucmass_semi_empirical::fit_fun(size_t nv, const ubvector &x) {
   B=-x[0]; Sv=x[1]; Ss=x[2]; Ec=x[3]; Epair=x[4];
   return 0;
@@ -30,6 +30,7 @@
 #include <cmath>
 #include <string>
 #include <map>
+#include <vector>
 
 #include <boost/numeric/ublas/vector.hpp>
 
@@ -233,6 +234,34 @@ namespace o2scl {
     /// Given \c Z and \c N, return the mass excess in MeV [abstract]
     virtual double mass_excess_d(double Z, double N)=0;
 
+    /** \brief Compute the mass excesses in MeV of \c n nuclei
+	specified in the arrays \c Z and \c N, storing the results
+	in \c mex
+
+	The default version just calls \ref mass_excess() for each
+	nucleus. Descendants for which \ref mass_excess() does not
+	modify any class data may override this function to evaluate
+	the nuclei in parallel.
+    */
+    virtual int mass_excess_many(size_t n, const int *Z, const int *N,
+				 double *mex) {
+      for(size_t i=0;i<n;i++) mex[i]=mass_excess(Z[i],N[i]);
+      return 0;
+    }
+
+    /** \brief Compute the binding energies in MeV of \c n nuclei
+	specified in the arrays \c Z and \c N, storing the results
+	in \c be
+
+	The default version just calls \ref binding_energy() for
+	each nucleus.
+    */
+    virtual int binding_energy_many(size_t n, const int *Z, const int *N,
+				    double *be) {
+      for(size_t i=0;i<n;i++) be[i]=binding_energy(Z[i],N[i]);
+      return 0;
+    }
+
     /** \brief Return the approximate electron binding energy in MeV
      */
     virtual double electron_binding(double Z) {
@@ -320,14 +349,107 @@ namespace o2scl {
       Generally, descendants of this class only need to provide an
       implementation of \ref mass_excess() and possibly a version
       of \ref nucmass::is_included()
+
+      Descendants which store their data in an array of entries
+      with integer members \c Z and \c N can call \ref make_index()
+      after the data is loaded. This creates a dense array over the
+      rectangle in \f$ (Z,N) \f$ spanned by the table, so that
+      \ref find_index() and \ref index_included() take constant
+      time rather than requiring a search through the table.
+      The index is not modified by the lookup functions, so
+      they can be called from several threads at once.
       
   */
   class nucmass_table : public nucmass {
     
   public:
+
+    nucmass_table() {
+      ix_n=0;
+      ix_Zmin=0;
+      ix_Nmin=0;
+      ix_nZ=0;
+      ix_nN=0;
+    }
     
     /// Given \c Z and \c N, return the mass excess in MeV
     virtual double mass_excess_d(double Z, double N);
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// \name Dense (Z,N) index
+    //@{
+    /// The number of table entries in the index
+    int ix_n;
+    /// The smallest value of Z in the table
+    int ix_Zmin;
+    /// The smallest value of N in the table
+    int ix_Nmin;
+    /// The number of values of Z spanned by the table
+    int ix_nZ;
+    /// The number of values of N spanned by the table
+    int ix_nN;
+    /** \brief The table row for each (Z,N) or -1 if the nucleus
+	is not in the table
+    */
+    std::vector<int> ix_row;
+    /// True if the nucleus is in the table
+    std::vector<bool> ix_incl;
+    //@}
+
+    /** \brief Create the (Z,N) index for the \c n entries
+	in \c arr
+
+	If a nucleus appears more than once, the last entry is used.
+    */
+    template<class entry_t> void make_index(int n, const entry_t *arr) {
+      ix_row.clear();
+      ix_incl.clear();
+      ix_n=n;
+      ix_nZ=0;
+      ix_nN=0;
+      if (n<=0) return;
+      int Zmax=arr[0].Z, Nmax=arr[0].N;
+      ix_Zmin=arr[0].Z;
+      ix_Nmin=arr[0].N;
+      for(int i=1;i<n;i++) {
+	if (arr[i].Z<ix_Zmin) ix_Zmin=arr[i].Z;
+	if (arr[i].Z>Zmax) Zmax=arr[i].Z;
+	if (arr[i].N<ix_Nmin) ix_Nmin=arr[i].N;
+	if (arr[i].N>Nmax) Nmax=arr[i].N;
+      }
+      ix_nZ=Zmax-ix_Zmin+1;
+      ix_nN=Nmax-ix_Nmin+1;
+      ix_row.resize(ix_nZ*ix_nN,-1);
+      ix_incl.resize(ix_nZ*ix_nN,false);
+      for(int i=0;i<n;i++) {
+	int k=(arr[i].Z-ix_Zmin)*ix_nN+arr[i].N-ix_Nmin;
+	ix_row[k]=i;
+	ix_incl[k]=true;
+      }
+      return;
+    }
+
+    /** \brief Return the table row for the nucleus with the
+	specified values of \c Z and \c N, or -1 if it is not
+	present
+    */
+    int find_index(int Z, int N) const {
+      int iZ=Z-ix_Zmin, iN=N-ix_Nmin;
+      if (iZ<0 || iZ>=ix_nZ || iN<0 || iN>=ix_nN) return -1;
+      return ix_row[iZ*ix_nN+iN];
+    }
+
+    /// Return true if the nucleus is in the table
+    bool index_included(int Z, int N) const {
+      int iZ=Z-ix_Zmin, iN=N-ix_Nmin;
+      if (iZ<0 || iZ>=ix_nZ || iN<0 || iN>=ix_nN) return false;
+      return ix_incl[iZ*ix_nN+iN];
+    }
+
+#endif
     
   };
   
@@ -430,12 +552,20 @@ namespace o2scl {
       return mass_excess_d(Z,N);
     }
 
+    /** \brief Compute the mass excesses in MeV of \c n nuclei
+
+	If OpenMP support is enabled, the nuclei are evaluated
+	in parallel.
+    */
+    virtual int mass_excess_many(size_t n, const int *Z, const int *N,
+				 double *mex);
+
     /// Fix parameters from an array for fitting
     virtual int fit_fun(size_t nv, const ubvector &x);
 
     /// Fill array with guess from present values for fitting
     virtual int guess_fun(size_t nv, ubvector &x);
-    
+
   };
 
   /** \brief An approximation of shell effects in nuclei based on
@@ -55,73 +55,7 @@ bool nucmass_ame::is_included(int l_Z, int l_N) {
 		  exc_einval);
   }
 
-  if (false) {
-
-    int l_A=l_Z+l_N, mid=last, lo=0, hi=0;
-
-    // Binary search for the correct A first
-    if (mass[mid].Z+mass[mid].N!=l_A) {
-      if (mass[mid].Z+mass[mid].N>l_A) {
-	lo=0;
-	hi=mid;
-      } else {
-	lo=mid;
-	hi=n-1;
-      }
-      while (hi>lo+1) {
-	int mp=(lo+hi)/2;
-	if (mass[mid].Z+mass[mid].N<l_A) {
-	  lo=mp;
-	} else {
-	  hi=mp;
-	}
-      }
-      mid=lo;
-      if (mass[mid].Z+mass[mid].N!=l_A) {
-	mid=hi;
-      }
-      if (mass[mid].Z+mass[mid].N!=l_A) {
-	return false;
-      }
-    }
-
-    // The cached point was the right one, so we're done
-    if (mass[mid].N==l_N) {
-      if (fabs(mass[mid].mass)>1.0e-20 &&
-	  fabs(mass[mid].mass)<1.0e90) {
-	return true;
-      } else {
-	return false;
-      }
-    }
-
-    // Now look for the right N among all the A's
-    while (mass[mid].Z+mass[mid].N==l_A) {
-      if (mass[mid].N==l_N) {
-	if (fabs(mass[mid].mass)>1.0e-20 &&
-	    fabs(mass[mid].mass)<1.0e90) {
-	  return true;
-	} else {
-	  return false;
-	}
-      } else if (mass[mid].N>l_N) {
-	if (mid==0) return false;
-	mid--;
-      } else {
-	if (mid==n-1) return false;
-	mid++;
-      }
-    }
-
-    return false;
-  }
-
-  for(int i=0;i<n;i++) {
-    if (mass[i].Z==l_Z && mass[i].N==l_N) {
-      return true;
-    }
-  }
-  return false;
+  return index_included(l_Z,l_N);
 }
 
 bool nucmass_ame_exp::is_included(int l_Z, int l_N) {
@@ -129,10 +63,9 @@ bool nucmass_ame_exp::is_included(int l_Z, int l_N) {
     O2SCL_ERR("No masses loaded in nucmass_ame_exp::is_included().",
 		  exc_einval);
   }
-  for(int i=0;i<n;i++) {
-    if (mass[i].Z==l_Z && mass[i].N==l_N && mass[i].mass_acc==0) {
-      return true;
-    }
+  int i=find_index(l_Z,l_N);
+  if (i>=0 && mass[i].mass_acc==0) {
+    return true;
   }
   return false;
 }
@@ -147,11 +80,8 @@ nucmass_ame::entry nucmass_ame::get_ZN(int l_Z, int l_N) {
 	      exc_einval);
     return ret;
   }
-  for(int i=0;i<n;i++) {
-    if (mass[i].Z==l_Z && mass[i].N==l_N) {
-      ret=mass[i];
-    }
-  }
+  int i=find_index(l_Z,l_N);
+  if (i>=0) ret=mass[i];
   return ret;
 }
 
@@ -165,11 +95,8 @@ nucmass_ame::entry nucmass_ame::get_ZA(int l_Z, int l_A) {
 	      exc_einval);
     return ret;
   }
-  for(int i=0;i<n;i++) {
-    if (mass[i].Z==l_Z && mass[i].A==l_A) {
-      ret=mass[i];
-    }
-  }
+  int i=find_index(l_Z,l_A-l_Z);
+  if (i>=0) ret=mass[i];
   return ret;
 }
 
@@ -47,7 +47,7 @@ double nucmass_fit::min_fun(size_t nv, const ubvector &x) {
   
   nmf->fit_fun(nv,x);
   
-  eval(*nmf,y);
+  eval_prepared(*nmf,y);
   
   return y;
 }
@@ -59,6 +59,8 @@ void nucmass_fit::fit(nucmass_fit_base &n, double &fmin) {
 	      exc_efailed);
   }
 
+  prepare();
+
   nmf=&n;
   size_t nv=nmf->nfit;
   ubvector mx(nv);
@@ -75,91 +77,103 @@ void nucmass_fit::fit(nucmass_fit_base &n, double &fmin) {
   return;
 }
 
-void nucmass_fit::eval(nucmass &n, double &fmin) {
-
-  fmin=0.0;
+void nucmass_fit::prepare() {
 
   if (dist.size()==0) {
-    O2SCL_ERR("No experimental masses to fit to in nucmass_fit::eval().",
+    O2SCL_ERR("No experimental masses to fit to in nucmass_fit::prepare().",
 	      exc_efailed);
   }
+  if (fit_method!=rms_mass_excess && fit_method!=rms_binding_energy &&
+      fit_method!=chi_squared_me && fit_method!=chi_squared_be) {
+    O2SCL_ERR("Unknown fit method in nucmass_fit::prepare().",exc_einval);
+  }
 
-  if (fit_method==rms_mass_excess) {
-
-    size_t nn=0;
-    for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
-      int Z=ndi->Z;
-      int N=ndi->N;
-      if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
-	fmin+=pow(ndi->mex*hc_mev_fm-n.mass_excess(Z,N),2.0);
-	if (!std::isfinite(fmin)) {
-	  std::string s=((std::string)"Non-finite value for nucleus with Z=")+
-	    itos(Z)+" and N="+itos(N)+" in nucmass_fit::eval() (1).";
-	  O2SCL_ERR(s.c_str(),exc_efailed);
-	}
-	nn++;
-      }
-    }
-    fmin=sqrt(fmin/nn);
-
-  } else if (fit_method==rms_binding_energy) {
-
-    size_t nn=0;
-    for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
-      int Z=ndi->Z;
-      int N=ndi->N;
-      if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
-	fmin+=pow(ndi->be*hc_mev_fm-n.binding_energy(Z,N),2.0);
-	if (!std::isfinite(fmin)) {
-	  std::string s=((std::string)"Non-finite value for nucleus with Z=")+
-	    itos(Z)+" and N="+itos(N)+" in nucmass_fit::eval() (2).";
-	  O2SCL_ERR(s.c_str(),exc_efailed);
-	}
-	nn++;
+  bool use_be=(fit_method==rms_binding_energy ||
+	       fit_method==chi_squared_be);
+
+  fit_Z.clear();
+  fit_N.clear();
+  fit_exp.clear();
+  fit_unc.clear();
+
+  size_t unc_ix=0;
+  for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
+    int Z=ndi->Z;
+    int N=ndi->N;
+    if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
+      fit_Z.push_back(Z);
+      fit_N.push_back(N);
+      if (use_be) {
+	fit_exp.push_back(ndi->be*hc_mev_fm);
+      } else {
+	fit_exp.push_back(ndi->mex*hc_mev_fm);
       }
+      if (unc_ix>=uncs.size()) unc_ix=0;
+      fit_unc.push_back(uncs[unc_ix]);
+      unc_ix++;
     }
-    fmin=sqrt(fmin/nn);
-    
-  } else if (fit_method==chi_squared_me) {
-
-    size_t unc_ix=0;
-    for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
-      int Z=ndi->Z;
-      int N=ndi->N;
-      if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
-	if (unc_ix>=uncs.size()) unc_ix=0;
-	fmin+=pow((ndi->mex*hc_mev_fm-n.mass_excess(Z,N))/
-		  (uncs[unc_ix]),2.0);
-	if (!std::isfinite(fmin)) {
-	  std::string s=((std::string)"Non-finite value for nucleus with Z=")+
-	    itos(Z)+" and N="+itos(N)+" in nucmass_fit::eval() (3).";
-	  O2SCL_ERR(s.c_str(),exc_efailed);
-	}
-	unc_ix++;
-      }
+  }
+  fit_th.resize(fit_Z.size());
+
+  return;
+}
+
+void nucmass_fit::eval(nucmass &n, double &fmin) {
+  prepare();
+  eval_prepared(n,fmin);
+  return;
+}
+
+void nucmass_fit::eval_prepared(nucmass &n, double &fmin) {
+
+  fmin=0.0;
+  
+  size_t nn=fit_Z.size();
+  bool chi2=(fit_method==chi_squared_me || fit_method==chi_squared_be);
+
+  // Compute the theoretical values for all of the nuclei at once
+  if (nn>0) {
+    if (fit_method==rms_mass_excess || fit_method==chi_squared_me) {
+      n.mass_excess_many(nn,&fit_Z[0],&fit_N[0],&fit_th[0]);
+    } else if (fit_method==rms_binding_energy ||
+	       fit_method==chi_squared_be) {
+      n.binding_energy_many(nn,&fit_Z[0],&fit_N[0],&fit_th[0]);
+    } else {
+      O2SCL_ERR("Unknown fit method in nucmass_fit::eval_prepared().",
+		exc_einval);
     }
+  }
+  
+  // Sum the squared deviations
+  double sum=0.0;
+  int inn=((int)nn);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for reduction(+:sum)
+#endif
+  for(int i=0;i<inn;i++) {
+    double dev=fit_exp[i]-fit_th[i];
+    if (chi2) dev/=fit_unc[i];
+    sum+=dev*dev;
+  }
 
-  } else if (fit_method==chi_squared_be) {
-
-    size_t unc_ix=0;
-    for(vector<nucleus>::iterator ndi=dist.begin();ndi!=dist.end();ndi++) {
-      int Z=ndi->Z;
-      int N=ndi->N;
-      if (N>=minN && Z>=minZ && (even_even==false || (N%2==0 && Z%2==0))) {
-	if (unc_ix>=uncs.size()) unc_ix=0;
-	fmin+=pow((ndi->be*hc_mev_fm-n.binding_energy(Z,N))/
-		  (uncs[unc_ix]),2.0);
-	if (!std::isfinite(fmin)) {
-	  std::string s=((std::string)"Non-finite value for nucleus with Z=")+
-	    itos(Z)+" and N="+itos(N)+" in nucmass_fit::eval() (4).";
-	  O2SCL_ERR(s.c_str(),exc_efailed);
-	}
-	unc_ix++;
+  // If the sum is not finite, find the first nucleus responsible
+  if (!std::isfinite(sum)) {
+    for(size_t i=0;i<nn;i++) {
+      double dev=fit_exp[i]-fit_th[i];
+      if (chi2) dev/=fit_unc[i];
+      if (!std::isfinite(dev*dev)) {
+	std::string s=((std::string)"Non-finite value for nucleus with Z=")+
+	  itos(fit_Z[i])+" and N="+itos(fit_N[i])+
+	  " in nucmass_fit::eval() ("+itos(fit_method+1)+").";
+	O2SCL_ERR(s.c_str(),exc_efailed);
       }
     }
+  }
 
+  if (chi2) {
+    fmin=sum;
   } else {
-    O2SCL_ERR("Unknown fit method in nucmass_fit::eval().",exc_einval);
+    fmin=sqrt(sum/nn);
   }
     
   return;
@@ -87,9 +87,27 @@ namespace o2scl {
     virtual void fit(nucmass_fit_base &n, double &res);
     
     /** \brief Evaluate quality without fitting
+
+	This function calls \ref prepare() and then evaluates the
+	fit quality using the flat arrays.
      */
     virtual void eval(nucmass &n, double &res);
 
+    /** \brief Select the nuclei from \ref dist to be fit
+
+	This function applies \ref minZ, \ref minN and \ref
+	even_even to \ref dist and stores the proton numbers, neutron
+	numbers, experimental values and uncertainties of the
+	selected nuclei in flat arrays. It is called once at the
+	beginning of \ref fit() so that each evaluation of the
+	function to minimize only requires one call to
+	nucmass::mass_excess_many() or
+	nucmass::binding_energy_many(). If OpenMP support is
+	enabled, the sum over the selected nuclei is also performed
+	in parallel.
+    */
+    virtual void prepare();
+
     /** \brief The default minimizer
 
 	The value of def_mmin::ntrial is automatically multiplied by
@@ -161,6 +179,23 @@ namespace o2scl {
 	This pointer is set by fit() and eval().
      */
     nucmass_fit_base *nmf;
+
+    /// \name Flat arrays of selected nuclei computed in prepare()
+    //@{
+    /// Proton numbers
+    std::vector<int> fit_Z;
+    /// Neutron numbers
+    std::vector<int> fit_N;
+    /// Experimental values (mass excess or binding energy) in MeV
+    std::vector<double> fit_exp;
+    /// Uncertainties in MeV
+    std::vector<double> fit_unc;
+    /// Values from the mass formula
+    std::vector<double> fit_th;
+    //@}
+
+    /// Compute the fit quality from the flat arrays
+    virtual void eval_prepared(nucmass &n, double &res);
     
 #endif
 
@@ -95,6 +95,31 @@ int main(void) {
   cout << res << endl;
   t.test_rel(res,0.894578,1.0e-4,"Moller fit 3");
 
+  // Compare the batch evaluation with a direct sum over the
+  // distribution
+  {
+    vector<int> vZ, vN;
+    vector<double> vme;
+    for(size_t i=0;i<mf.dist.size();i++) {
+      vZ.push_back(mf.dist[i].Z);
+      vN.push_back(mf.dist[i].N);
+    }
+    vme.resize(vZ.size());
+    sem.mass_excess_many(vZ.size(),&vZ[0],&vN[0],&vme[0]);
+    double sum=0.0;
+    size_t nn=0;
+    for(size_t i=0;i<vZ.size();i++) {
+      t.test_rel(vme[i],sem.mass_excess(vZ[i],vN[i]),1.0e-14,
+		 "mass_excess_many");
+      if (vZ[i]>=mf.minZ && vN[i]>=mf.minN) {
+	sum+=pow(mf.dist[i].mex*hc_mev_fm-vme[i],2.0);
+	nn++;
+      }
+    }
+    mf.eval(sem,res);
+    t.test_rel(res,sqrt(sum/nn),1.0e-12,"eval vs. direct sum");
+  }
+
   t.report();
   return 0;
 }
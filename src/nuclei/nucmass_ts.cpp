@@ -246,6 +246,20 @@ int main(void) {
   
   t.test_gen(ame95rmd.get_nentries()==2931,"ame.n");
 
+  // Test that the (Z,N) index agrees with the table entries
+
+  for(int Z=1;Z<=120;Z++) {
+    for(int N=1;N<=200;N++) {
+      if (ame12.is_included(Z,N)) {
+	nucmass_ame::entry e=ame12.get_ZN(Z,N);
+	t.test_gen(e.Z==Z && e.N==N,"ame12 index");
+      }
+      if (sdnp1.is_included(Z,N)) {
+	t.test_gen(fabs(sdnp1.mass_excess(Z,N))<1.0e3,"sdnp index");
+      }
+    }
+  }
+
   // Test nucmass_radius
   nucmass_radius nr;
   double rho0, N, N_err;
@@ -91,121 +91,24 @@ nucmass_wlw::nucmass_wlw(std::string model, bool external) {
   }
 
   last=n/2;
+  make_index(n,mass);
 }
 
 nucmass_wlw::~nucmass_wlw() {
 }
 
 bool nucmass_wlw::is_included(int l_Z, int l_N) {
-  int lo=0, hi=0, mid=last;
-
-  // binary search for the correct Z first
-  if (mass[mid].Z!=l_Z) {
-    if (mass[mid].Z>l_Z) {
-      lo=0;
-      hi=mid;
-    } else {
-      lo=mid;
-      hi=n-1;
-    }
-    while (hi>lo+1) {
-      int mp=(lo+hi)/2;
-      if (mass[mp].Z<l_Z) {
-	lo=mp;
-      } else {
-	hi=mp;
-      }
-    }
-    mid=lo;
-    if (mass[mid].Z!=l_Z) mid=hi;
-    if (mass[mid].Z!=l_Z) {
-      return false;
-    }
-  }
-
-  // The cached point was the right one, so we're done
-  if (mass[mid].N==l_N) {
-    return true;
-  }
-
-  // Now look for the right N among all the N's
-  while (mass[mid].Z==l_Z) {
-
-    if (mass[mid].N==l_N) {
-      return true;
-    } else if (mass[mid].N>l_N) {
-      if (mid==0) return false;
-      mid--;
-    } else {
-      if (mid==n-1) return false;
-      mid++;
-    }
-  }
-  
-  return false;
+  return index_included(l_Z,l_N);
 }
 
 double nucmass_wlw::mass_excess(int l_Z, int l_N) {
-  int lo=0, hi=0, mid=last;
-  
-  // binary search for the correct Z first
-  if (mass[mid].Z!=l_Z) {
-    if (mass[mid].Z>l_Z) {
-      lo=0;
-      hi=mid;
-    } else {
-      lo=mid;
-      hi=n-1;
-    }
-    while (hi>lo+1) {
-      int mp=(lo+hi)/2;
-      if (mass[mp].Z<l_Z) {
-	lo=mp;
-      } else {
-	hi=mp;
-      }
-    }
-    mid=lo;
-    if (mass[mid].Z!=l_Z) mid=hi;
-    if (mass[mid].Z!=l_Z) {
-      O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-		 " not found in nucmass_wlw::mass_excess().").c_str(),
-		exc_enotfound);
-    }
-  }
-  
-  // The cached point was the right one, so we're done
-  if (mass[mid].N==l_N) {
-    int A=l_Z+l_N;
-    return mass[mid].Mth;
-  }
-  
-  // Now look for the right N among all the N's
-  while (mass[mid].Z==l_Z) {
-    
-    if (mass[mid].N==l_N) {
-      int A=l_Z+l_N;
-      return mass[mid].Mth;
-    } else if (mass[mid].N>l_N) {
-      if (mid==0) {
-	O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-		   " not found in nucmass_wlw::mass_excess().").c_str(),
-		  exc_enotfound);
-      }
-      mid--;
-    } else {
-      if (mid==n-1) {
-	O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-		   " not found in nucmass_wlw::mass_excess().").c_str(),
-		  exc_enotfound);
-      }
-      mid++;
-    }
+
+  int i=find_index(l_Z,l_N);
+  if (i<0) {
+    O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
+	       " not found in nucmass_wlw::mass_excess().").c_str(),
+	      exc_enotfound);
+    return 0.0;
   }
-  
-  O2SCL_ERR((((string)"Nucleus with Z=")+itos(l_Z)+" and N="+itos(l_N)+
-	     " not found in nucmass_wlw::mass_excess().").c_str(),
-	    exc_enotfound);
-  
-  return 0.0;
+  return mass[i].Mth;
 }
@@ -20,6 +20,8 @@
 
   -------------------------------------------------------------------
 */
+#include <algorithm>
+
 #include <o2scl/reaction_lib.h>
 
 using namespace std;
@@ -33,6 +35,103 @@ bool reaction_lib::matches(size_t ul, size_t ri) {
   return false;
 }
 
+size_t reaction_lib::n_reactants(size_t chap) const {
+  if (chap==1 || chap==2 || chap==3 || chap==11) return 1;
+  if (chap>=4 && chap<=7) return 2;
+  if (chap==8 || chap==9) return 3;
+  if (chap==10) return 4;
+  return 0;
+}
+
+size_t reaction_lib::n_products(size_t chap) const {
+  if (chap==1 || chap==4 || chap==8) return 1;
+  if (chap==2 || chap==5 || chap==9 || chap==10) return 2;
+  if (chap==3 || chap==6) return 3;
+  if (chap==7 || chap==11) return 4;
+  return 0;
+}
+
+std::string reaction_lib::index_key(size_t chap, const int *Z,
+				    const int *A) const {
+  
+  size_t nr=n_reactants(chap);
+  size_t np=n_products(chap);
+
+  // Sort the reactants and the products separately, since the
+  // order within each group does not matter
+  std::vector<std::pair<int,int> > in(nr), out(np);
+  for(size_t i=0;i<nr;i++) in[i]=std::make_pair(Z[i],A[i]);
+  for(size_t i=0;i<np;i++) out[i]=std::make_pair(Z[nr+i],A[nr+i]);
+  std::sort(in.begin(),in.end());
+  std::sort(out.begin(),out.end());
+
+  std::ostringstream key;
+  key << chap << ':';
+  for(size_t i=0;i<nr;i++) key << in[i].first << ',' << in[i].second << ';';
+  key << '>';
+  for(size_t i=0;i<np;i++) key << out[i].first << ',' << out[i].second << ';';
+  return key.str();
+}
+
+void reaction_lib::make_index() {
+
+  size_t n=lib.size();
+  for(size_t k=0;k<7;k++) coeff[k].resize(n);
+  rindex.clear();
+
+  int Z[6], A[6];
+  for(size_t i=0;i<n;i++) {
+    for(size_t k=0;k<7;k++) coeff[k][i]=lib[i].a[k];
+    for(size_t j=0;j<6;j++) {
+      Z[j]=((int)lib[i].Z[j]);
+      A[j]=((int)lib[i].A[j]);
+    }
+    rindex[index_key(lib[i].chap,Z,A)].push_back(i);
+  }
+  index_size=n;
+  
+  return;
+}
+
+int reaction_lib::find_indices(std::vector<size_t> &list,
+			       size_t chap, std::string nuc1, std::string nuc2, 
+			       std::string nuc3, std::string nuc4, 
+			       std::string nuc5, std::string nuc6) {
+
+  list.clear();
+  
+  size_t ntot=n_reactants(chap)+n_products(chap);
+  if (ntot==0) {
+    O2SCL_ERR2("Invalid chapter in ",
+	       "reaction_lib::find_indices().",exc_einval);
+  }
+
+  std::string nucs[6]={nuc1,nuc2,nuc3,nuc4,nuc5,nuc6};
+  int Z[6], N[6], A[6];
+  nucmass_info nmi;
+  for(size_t i=0;i<ntot;i++) {
+    if (nucs[i].length()==0 ||
+	nmi.parse_elstring(nucs[i],Z[i],N[i],A[i])!=0) {
+      O2SCL_ERR2("Missing or invalid nucleus in ",
+		 "reaction_lib::find_indices().",exc_einval);
+    }
+  }
+  for(size_t i=ntot;i<6;i++) {
+    if (nucs[i].length()>0) {
+      O2SCL_ERR2("Too many nuclei specified for chapter in ",
+		 "reaction_lib::find_indices().",exc_einval);
+    }
+  }
+  
+  if (index_size!=lib.size()) make_index();
+
+  std::unordered_map<std::string,std::vector<size_t> >::const_iterator it=
+    rindex.find(index_key(chap,Z,A));
+  if (it!=rindex.end()) list=it->second;
+
+  return 0;
+}
+
 int reaction_lib::find_in_chap(std::vector<nuclear_reaction> &nrl,
 			       size_t chap, std::string nuc1, std::string nuc2, 
 			       std::string nuc3, std::string nuc4, 
@@ -62,6 +161,19 @@ int reaction_lib::find_in_chap(std::vector<nuclear_reaction> &nrl,
     }
   }
 
+  // If all of the nuclei are specified, use the index
+  if (nspec==n_reactants(chap)+n_products(chap)) {
+    if (index_size!=lib.size()) make_index();
+    std::unordered_map<std::string,std::vector<size_t> >::const_iterator it=
+      rindex.find(index_key(chap,fZ,fA));
+    if (it!=rindex.end()) {
+      for(size_t i=0;i<it->second.size();i++) {
+	nrl.push_back(lib[it->second[i]]);
+      }
+    }
+    return 0;
+  }
+
   if (chap==1) {
     // nuc1 -> nuc2
 
@@ -1153,6 +1265,8 @@ int reaction_lib::read_file_reaclib2(std::string fname) {
     }
 
   } while (eof==false);
+
+  make_index();
     
   return 0;
 }
@@ -31,6 +31,8 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <vector>
+#include <unordered_map>
 
 #include <o2scl/err_hnd.h>
 #include <o2scl/string_conv.h>
@@ -206,11 +208,26 @@ namespace o2scl {
       FORMAT(4e13.6) 
       FORMAT(3e13.6) 
       \endverbatim
+
+      For reaction networks, \ref make_index() stores the rate
+      coefficients of all the reactions in \ref lib in
+      structure-of-arrays form and constructs a hash table which
+      maps a chapter and a full set of participating nuclei to the
+      corresponding entries in \ref lib. The function \ref rate_all()
+      then evaluates every rate at a given temperature, computing
+      the powers of \f$ T_9 \f$ only once, and \ref find_indices()
+      looks up a reaction in constant time. The index is made
+      automatically by \ref read_file_reaclib2(), but must be
+      remade by the user if \ref lib is modified.
   */
   class reaction_lib {
 
   public:
 
+    reaction_lib() {
+      index_size=0;
+    }
+
     /// The library
     std::vector<nuclear_reaction> lib;
     
@@ -232,8 +249,88 @@ namespace o2scl {
 		     size_t chap, std::string nuc1, std::string nuc2="", 
 		     std::string nuc3="", std::string nuc4="", 
 		     std::string nuc5="", std::string nuc6="");
+
+    /** \brief Make the structure-of-arrays rate coefficients and
+	the reaction index from \ref lib
+    */
+    void make_index();
+
+    /** \brief Find the indices in \ref lib of all the entries for
+	the reaction with the specified nuclei
+
+	All of the nuclei participating in the reaction must be
+	given, first the reactants and then the products, in any order
+	within each group. If the index is not current, it is 
+	remade first.
+    */
+    int find_indices(std::vector<size_t> &list,
+		     size_t chap, std::string nuc1, std::string nuc2="", 
+		     std::string nuc3="", std::string nuc4="", 
+		     std::string nuc5="", std::string nuc6="");
+
+    /** \brief Compute the rates of all reactions in \ref lib at
+	temperature \c T9 (in units of \f$ 10^9 K \f$ )
+
+	The rates are stored in the first <tt>lib.size()</tt> entries
+	of \c rates. This gives the same results as \ref
+	nuclear_reaction::rate() up to roundoff, but the factor of 
+	\f$ T_9^{a_6} \f$ is included in the exponential so that each
+	rate requires only one call to <tt>exp()</tt> and the loop 
+	can be vectorized. The index must be current, see \ref
+	make_index().
+    */
+    template<class vec_t> void rate_all(double T9, vec_t &rates) const {
+      
+      if (index_size!=lib.size()) {
+	O2SCL_ERR2("Index not current in ",
+		   "reaction_lib::rate_all().",exc_einval);
+      }
+      size_t n=index_size;
+      if (n==0) return;
+
+      // Powers of T9 which are shared by all of the rates
+      double T913=cbrt(T9);
+      double x1=1.0/T9;
+      double x2=1.0/T913;
+      double x5=T9*T913*T913;
+      double x6=log(T9);
+      
+      const double *a0=&(coeff[0][0]);
+      const double *a1=&(coeff[1][0]);
+      const double *a2=&(coeff[2][0]);
+      const double *a3=&(coeff[3][0]);
+      const double *a4=&(coeff[4][0]);
+      const double *a5=&(coeff[5][0]);
+      const double *a6=&(coeff[6][0]);
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(size_t i=0;i<n;i++) {
+	rates[i]=exp(a0[i]+a1[i]*x1+a2[i]*x2+a3[i]*T913+a4[i]*T9+
+		     a5[i]*x5+a6[i]*x6);
+      }
+      
+      return;
+    }
     
   protected:
+
+    /// \name Structure-of-arrays storage and index
+    //@{
+    /// The coefficients \f$ a_k \f$ for all of the reactions
+    std::vector<double> coeff[7];
+    /// Map from reaction key to the indices in \ref lib
+    std::unordered_map<std::string,std::vector<size_t> > rindex;
+    /// The size of \ref lib when the index was made
+    size_t index_size;
+    /// Number of reactants for chapter \c chap
+    size_t n_reactants(size_t chap) const;
+    /// Number of products for chapter \c chap
+    size_t n_products(size_t chap) const;
+    /// Construct the key for \ref rindex
+    std::string index_key(size_t chap, const int *Z, const int *A) const;
+    //@}
     
     /// \name Storage for the find function
     //@{
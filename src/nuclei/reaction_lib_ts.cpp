@@ -42,6 +42,16 @@ int main(void) {
        << endl;
   fout << "-2.014510e+01 0.000000e+00 0.000000e+00 0.000000e+00" << endl;
   fout << " 0.000000e+00 0.000000e+00 0.000000e+00" << endl;
+  fout << "5" << endl;
+  fout << "         p  li7  he4  he4                  de04n     1.73470e+01" 
+       << endl;
+  fout << " 2.044720e+01 0.000000e+00-8.472000e+00-2.917000e-01" << endl;
+  fout << " 1.100000e-01-5.130000e-02-6.666670e-01" << endl;
+  fout << "5" << endl;
+  fout << "         p  li7  he4  he4                  de04r     1.73470e+01" 
+       << endl;
+  fout << " 1.136200e+01-4.478000e+00 0.000000e+00 0.000000e+00" << endl;
+  fout << " 0.000000e+00 0.000000e+00-1.500000e+00" << endl;
   fout.close();
 
   reaction_lib r;
@@ -49,7 +59,29 @@ int main(void) {
   cout << ret << " " << r.lib.size() << endl;
   cout << endl;
   
-  t.test_gen(r.lib.size()==2,"size");
+  t.test_gen(r.lib.size()==4,"size");
+
+  // Compare the indexed and linear searches
+  vector<nuclear_reaction> nrl;
+  r.find_in_chap(nrl,5,"li7","p","he4","he4");
+  t.test_gen(nrl.size()==2,"find_in_chap index");
+  nrl.clear();
+  r.find_in_chap(nrl,5,"p");
+  t.test_gen(nrl.size()==2,"find_in_chap linear");
+  vector<size_t> list;
+  r.find_indices(list,5,"p","li7","he4","he4");
+  t.test_gen(list.size()==2 && list[0]==2 && list[1]==3,"find_indices");
+  r.find_indices(list,1,"p","n");
+  t.test_gen(list.size()==0,"find_indices 2");
+
+  // Compare the batch rates with the individual rates
+  vector<double> rates(r.lib.size());
+  for(double T9=0.1;T9<10.0;T9*=2.0) {
+    r.rate_all(T9,rates);
+    for(size_t i=0;i<r.lib.size();i++) {
+      t.test_rel(rates[i],r.lib[i].rate(T9),1.0e-12,"rate_all");
+    }
+  }
 
   t.report();
   return 0;
@@ -31,6 +31,8 @@ using namespace o2scl;
 
 contour::contour() {
   nx=0;
+  nlev=0;
+  levels_set=false;
   lev_adjust=1.0e-8;
   verbose=0;
   debug_next_point=false;
@@ -559,9 +561,7 @@ int contour::find_next_point_x_direct(int j, int k, int &jnext, int &knext,
   return enot_found;
 }
 
-void contour::find_intersections(size_t ilev, double &level,
-				 edge_crossings &xedges, 
-				 edge_crossings &yedges) {
+void contour::adjust_level(size_t ilev, double &level) {
   
   // Adjust the specified contour level to ensure none of the data
   // points is exactly on a contour
@@ -615,113 +615,55 @@ void contour::find_intersections(size_t ilev, double &level,
     }
 
   } while (level_corner==true);
-  
-  // Find all level crossings
+
+  return;
+}
+
+void contour::find_intersections(double level, edge_crossings &xedges,
+				 edge_crossings &yedges) {
+
+  // Find all level crossings and compute the crossing points by
+  // linear interpolation along the edge
   for(int k=0;k<ny;k++) {
     for(int j=0;j<nx;j++) {
+      double d0=data(j,k)-level;
       if (j<nx-1) {
-	xedges.status(j,k)=empty;
-	if ((data(j,k)-level)*(data(j+1,k)-level)<0.0) {
+	double d1=data(j+1,k)-level;
+	if (d0*d1<0.0) {
 	  xedges.status(j,k)=edge;
+	  xedges.values(j,k)=xfun[j]+d0/(d0-d1)*(xfun[j+1]-xfun[j]);
 	  if (verbose>1) {
 	    cout << "Vertical edge for level   " << level << " between (" 
 		 << k << "," << j << ") and (" << k << "," 
 		 << j+1 << ")" << endl;
+	    cout << " coords: " << xfun[j] << " "
+		 << xedges.values(j,k) << " " << xfun[j+1] << endl;
+	    cout << "   data: " << data(j,k) << " "
+		 << level << " " << data(j+1,k) << endl;
 	  }
-	} 
+	} else {
+	  xedges.status(j,k)=empty;
+	  xedges.values(j,k)=0.0;
+	}
       }
       if (k<ny-1) {
-	yedges.status(j,k)=empty;
-	if ((data(j,k)-level)*(data(j,k+1)-level)<0.0) {
+	double d1=data(j,k+1)-level;
+	if (d0*d1<0.0) {
+	  yedges.status(j,k)=edge;
+	  yedges.values(j,k)=yfun[k]+d0/(d0-d1)*(yfun[k+1]-yfun[k]);
 	  if (verbose>1) {
 	    cout << "Horizontal edge for level " << level << " between (" 
 		 << k << "," << j << ") and (" << k+1 << "," 
 		 << j << ")" << endl;
+	    cout << " coords: " << yfun[k] << " "
+		 << yedges.values(j,k) << " " << yfun[k+1] << endl;
+	    cout << "   data: " << data(j,k) << " "
+		 << level << " " << data(j,k+1) << endl;
 	  }
-	  yedges.status(j,k)=edge;
-	}
-      }
-    }
-  }
-
-  return;
-}
-
-void contour::edges_in_y_direct(double level, interp<ubvector> &si,
-				edge_crossings &yedges) {
-
-  for(int k=0;k<ny-1;k++) {
-    for(int j=0;j<nx;j++) {
-      
-      // For each iright edge
-      if (yedges.status(j,k)==edge) {
-		
-	// Find two points for linear interpolation
-	int ileft=k;
-	if (ileft==ny-1) ileft--;
-	int nint=2;
-	
-	ubvector xi(nint), yi(nint);
-	
-	xi[0]=data(j,k);
-	xi[1]=data(j,k+1);
-	yi[0]=yfun[ileft];
-	yi[1]=yfun[ileft+1];
-	
-	// Do the interpolation and set the edge appropriately
-	yedges.values(j,k)=si.eval(level,nint,xi,yi);
-	
-	if (verbose>1) {
-	  cout << "Horizontal edge: (" << k << "," << j << ") -> ("
-	       << k+1 << "," << j << ")" << endl;
-	  cout << " coords: " << yfun[ileft] << " "
-	       << yedges.values(j,k) << " " << yfun[ileft+1] << endl;
-	  cout << "   data: " << data(j,k) << " "
-	       << level << " " << data(j,k+1) << endl;
-	}
-      } else {
-	yedges.values(j,k)=0.0;
-      }
-    }
-  }
-
-  return;
-}
-
-void contour::edges_in_x_direct(double level, interp<ubvector> &si,
-				edge_crossings &xedges) {
-
-  for(int k=0;k<ny;k++) {
-    for(int j=0;j<nx-1;j++) {
-      
-      // For each bottom edge
-      if (xedges.status(j,k)==edge) {
-	
-	// Find two points for linear interpolation
-	int ileft=j;
-	if (ileft==nx-1) ileft--;
-	int nint=2;
-	
-	ubvector xi(nint), yi(nint);
-	
-	xi[0]=data(j,k);
-	xi[1]=data(j+1,k);
-	yi[0]=xfun[ileft];
-	yi[1]=xfun[ileft+1];
-
-	// Do the interpolation and set the edge appropriately
-	xedges.values(j,k)=si.eval(level,nint,xi,yi);
-	
-	if (verbose>1) {
-	  cout << "Vertical edge:   (" << k << "," << j << ") -> ("
-	       << k+1 << "," << j << ")" << endl;
-	  cout << " coords: " << xfun[ileft] << " "
-	       << xedges.values(j,k) << " " << xfun[ileft+1] << endl;
-	  cout << "   data: " << data(j,k) << " "
-	       << level << " " << data(j+1,k) << endl;
+	} else {
+	  yedges.status(j,k)=empty;
+	  yedges.values(j,k)=0.0;
 	}
-      } else {
-	xedges.values(j,k)=0.0;
       }
     }
   }
@@ -857,6 +799,97 @@ void contour::process_line(int j, int k, int dir, std::vector<double> &x,
   return;
 }
 
+void contour::calc_level(size_t i, edge_crossings &xedges,
+			 edge_crossings &yedges,
+			 std::vector<contour_line> &lines) {
+
+  // Make space for the edges
+  xedges.status.resize(nx-1,ny);
+  xedges.values.resize(nx-1,ny);
+  yedges.status.resize(nx,ny-1);
+  yedges.values.resize(nx,ny-1);
+
+  if (verbose>1) {
+    std::cout << "\nLooking for edges for level: " 
+	      << levels[i] << std::endl;
+  }
+  
+  // Examine the each of the rows for an intersection
+  find_intersections(levels[i],xedges,yedges);
+  
+  if (verbose>1) {
+    std::cout << "\nPiecing together contour lines for level: " 
+	      << levels[i] << std::endl;
+  }
+
+  // Now go through and one side of the line
+  bool foundline=true;
+  while(foundline==true) {
+    for(int j=0;j<nx;j++) {
+      for(int k=0;k<ny;k++) {
+	foundline=false;
+
+	contour_line c;
+	c.level=levels[i];
+	
+	// A line beginning with a right edge
+	if (k<ny-1 && yedges.status(j,k)==edge) {
+	  if (verbose>0) {
+	    std::cout << "Starting contour line for level "
+		      << levels[i] << ":" << std::endl;
+	    std::cout << "(" << xfun[j] << ", " << yedges.values(j,k) 
+		      << ")" << std::endl;
+	  }
+	  c.x.push_back(xfun[j]);
+	  c.y.push_back(yedges.values(j,k));
+	  yedges.status(j,k)++;
+	  
+	  // Go through both sides
+	  process_line(j,k,dydir,c.x,c.y,true,xedges,yedges);
+	  if (verbose>0) {
+	    std::cout << "Computing other side of line." << std::endl;
+	  }
+	  process_line(j,k,dydir,c.x,c.y,false,xedges,yedges);
+	  foundline=true;
+	}
+
+	// A line beginning with a bottom edge
+	if (j<nx-1 && foundline==false && xedges.status(j,k)==edge) {
+	  if (verbose>0) {
+	    std::cout << "Starting contour line for level "
+		      << levels[i] << ":" << std::endl;
+	    std::cout << "(" << xedges.values(j,k) << ", " << yfun[k] 
+		      << ")" << std::endl;
+	  }
+	  c.x.push_back(xedges.values(j,k));
+	  c.y.push_back(yfun[k]);
+	  xedges.status(j,k)++;
+	  
+	  // Go through both sides
+	  process_line(j,k,dxdir,c.x,c.y,true,xedges,yedges);
+	  if (verbose>0) {
+	    std::cout << "Computing other side of line." << std::endl;
+	  }
+	  process_line(j,k,dxdir,c.x,c.y,false,xedges,yedges);
+	  foundline=true;
+	}
+
+	// Add line to list
+	if (foundline==true) {
+	  lines.push_back(c);
+	}
+      }
+    }
+    
+  }
+
+  if (verbose>0) {
+    std::cout << "Processing next level." << std::endl;
+  }
+  
+  return;
+}
+
 void contour::calc_contours(std::vector<contour_line> &clines) {
 
   // Check that we're ready
@@ -869,116 +902,33 @@ void contour::calc_contours(std::vector<contour_line> &clines) {
     return;
   }
 
+  // Adjust the levels first, since the adjustment for each level
+  // depends on the values of the others
+  for(int i=0;i<nlev;i++) {
+    adjust_level(i,levels[i]);
+  }
+
   // Clear edge storage
   yed.clear();
   xed.clear();
+  yed.resize(nlev);
+  xed.resize(nlev);
 
-  // The interpolation object (only works with linear interpolation
-  // at the moment)
-  interp<ubvector> oi(itp_linear);
-  
-  // For each level
-  for(int i=0;i<nlev;i++) {
-
-    // Make space for the edges
-    edge_crossings xedges, yedges;
-    xedges.status.resize(nx-1,ny);
-    xedges.values.resize(nx-1,ny);
-    yedges.status.resize(nx,ny-1);
-    yedges.values.resize(nx,ny-1);
-
-    if (verbose>1) {
-      std::cout << "\nLooking for edges for level: " 
-		<< levels[i] << std::endl;
-    }
-
-    // Examine the each of the rows for an intersection
-    find_intersections(i,levels[i],xedges,yedges);
-	
-    if (verbose>1) {
-      std::cout << "\nInterpolating edge intersections for level: " 
-		<< levels[i] << std::endl;
-    }
-
-    // Process the edges in the x direction
-    edges_in_x_direct(levels[i],oi,xedges);
-
-    // Process the edges in the y direction
-    edges_in_y_direct(levels[i],oi,yedges);
-    
-    if (verbose>1) {
-      std::cout << "\nPiecing together contour lines for level: " 
-		<< levels[i] << std::endl;
-    }
-
-    // Now go through and one side of the line
-    bool foundline=true;
-    while(foundline==true) {
-      for(int j=0;j<nx;j++) {
-	for(int k=0;k<ny;k++) {
-	  foundline=false;
-
-	  contour_line c;
-	  c.level=levels[i];
-	      
-	  // A line beginning with a right edge
-	  if (k<ny-1 && yedges.status(j,k)==edge) {
-	    if (verbose>0) {
-	      std::cout << "Starting contour line for level "
-			<< levels[i] << ":" << std::endl;
-	      std::cout << "(" << xfun[j] << ", " << yedges.values(j,k) 
-			<< ")" << std::endl;
-	    }
-	    c.x.push_back(xfun[j]);
-	    c.y.push_back(yedges.values(j,k));
-	    yedges.status(j,k)++;
-	    
-	    // Go through both sides
-	    process_line(j,k,dydir,c.x,c.y,true,xedges,yedges);
-	    if (verbose>0) {
-	      std::cout << "Computing other side of line." << std::endl;
-	    }
-	    process_line(j,k,dydir,c.x,c.y,false,xedges,yedges);
-	    foundline=true;
-	  }
-
-	  // A line beginning with a bottom edge
-	  if (j<nx-1 && foundline==false && xedges.status(j,k)==edge) {
-	    if (verbose>0) {
-	      std::cout << "Starting contour line for level "
-			<< levels[i] << ":" << std::endl;
-	      std::cout << "(" << xedges.values(j,k) << ", " << yfun[k] 
-			<< ")" << std::endl;
-	    }
-	    c.x.push_back(xedges.values(j,k));
-	    c.y.push_back(yfun[k]);
-	    xedges.status(j,k)++;
-	    
-	    // Go through both sides
-	    process_line(j,k,dxdir,c.x,c.y,true,xedges,yedges);
-	    if (verbose>0) {
-	      std::cout << "Computing other side of line." << std::endl;
-	    }
-	    process_line(j,k,dxdir,c.x,c.y,false,xedges,yedges);
-	    foundline=true;
-	  }
-
-	  // Add line to list
-	  if (foundline==true) {
-	    clines.push_back(c);
-	  }
-	}
-      }
+  // The lines for each level, combined at the end so that 
+  // the order does not depend on the number of threads
+  std::vector<std::vector<contour_line> > level_lines(nlev);
 
-    }
-
-    // Store edge information from this level
-    xed.push_back(xedges);
-    yed.push_back(yedges);
+#ifdef O2SCL_OPENMP
+  bool parallel=(verbose==0 && debug_next_point==false && nlev>1);
+#pragma omp parallel for schedule(dynamic) if (parallel)
+#endif
+  for(int i=0;i<nlev;i++) {
+    calc_level(i,xed[i],yed[i],level_lines[i]);
+  }
 
-    if (verbose>0) {
-      std::cout << "Processing next level." << std::endl;
-    }
+  for(int i=0;i<nlev;i++) {
+    clines.insert(clines.end(),level_lines[i].begin(),
+		  level_lines[i].end());
   }
   
   return;
@@ -191,6 +191,17 @@ namespace o2scl {
       intersection of a line segment with a level curve into a full
       contour line.
 
+      The level crossings are found and linearly interpolated in a
+      single pass over the grid for each level. After the contour
+      levels have been adjusted (which must be done in order, since
+      each adjustment depends on the other levels), the levels are
+      independent. If OpenMP support is enabled, the levels are
+      divided among threads and the contour lines are returned in
+      the same order as for a serial calculation. The calculation
+      is always serial when \ref verbose is greater than zero or
+      \ref debug_next_point is true, so that the output is
+      readable.
+
       \future Copy constructor
 
       \future Improve the algorithm to ensure that no contour
@@ -493,17 +504,21 @@ namespace o2scl {
 				 edge_crossings &xedges,
 				 edge_crossings &yedges);
     
-    /// Find all of the intersections of the edges with the contour level
-    void find_intersections(size_t ilev, double &level,
-			    edge_crossings &xedges, edge_crossings &yedges);
-
-    /// Interpolate all right edge crossings 
-    void edges_in_y_direct(double level, interp<ubvector> &si,
-			   edge_crossings &yedges);
+    /** \brief Adjust contour level \c ilev so that it does not
+	coincide with any of the data points
+    */
+    void adjust_level(size_t ilev, double &level);
     
-    /// Interpolate all bottom edge crossings
-    void edges_in_x_direct(double level, interp<ubvector> &si,
-			   edge_crossings &xedges);
+    /** \brief Find all of the intersections of the edges with the
+	contour level and compute the crossing points
+    */
+    void find_intersections(double level, edge_crossings &xedges,
+			    edge_crossings &yedges);
+
+    /// Compute all of the contour lines for level \c ilev
+    void calc_level(size_t ilev, edge_crossings &xedges,
+		    edge_crossings &yedges,
+		    std::vector<contour_line> &lines);
 
     /// Create a contour line from a starting edge
     void process_line(int j, int k, int dir, std::vector<double> &x, 
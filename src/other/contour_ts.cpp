@@ -426,7 +426,37 @@ int main(void) {
   }
   
   // ------------------------------------------------------------
-  
+
+  cout << "Multiple levels vs. single levels:" << endl;
+
+  // Ensure that computing all the levels at once gives the same
+  // lines as computing the levels one at a time
+  {
+    vector<contour_line> call;
+    co.set_data(10,8,sqx,sqy,sqd);
+    co.set_levels(4,sqlev);
+    co.calc_contours(call);
+
+    vector<contour_line> cone;
+    for(i=0;i<4;i++) {
+      ubvector lev1(1);
+      lev1[0]=sqlev[i];
+      co.set_levels(1,lev1);
+      co.calc_contours(cone);
+    }
+    t.test_gen(call.size()==cone.size(),"multi-level count");
+    for(size_t k=0;k<call.size() && k<cone.size();k++) {
+      t.test_rel(call[k].level,cone[k].level,1.0e-12,"multi-level level");
+      t.test_gen(call[k].x.size()==cone[k].x.size(),"multi-level size");
+      for(size_t m=0;m<call[k].x.size() && m<cone[k].x.size();m++) {
+	t.test_rel(call[k].x[m],cone[k].x[m],1.0e-12,"multi-level x");
+	t.test_rel(call[k].y[m],cone[k].y[m],1.0e-12,"multi-level y");
+      }
+    }
+  }
+
+  // ------------------------------------------------------------
+
   fout.close();
   
   t.report();
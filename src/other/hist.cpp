@@ -35,6 +35,10 @@ hist::hist() {
   extend_lhs=false;
   extend_rhs=false;
   hsize=0;
+  ubin_uniform=false;
+  ubin_log=false;
+  ubin_start=0.0;
+  ubin_scale=0.0;
 #if !O2SCL_NO_RANGE_CHECK
   is_valid();
 #endif
@@ -52,6 +56,10 @@ hist::hist(const hist &h) {
   extend_lhs=h.extend_lhs;
   hsize=h.hsize;
   ubin=h.ubin;
+  ubin_uniform=h.ubin_uniform;
+  ubin_log=h.ubin_log;
+  ubin_start=h.ubin_start;
+  ubin_scale=h.ubin_scale;
   urep=h.urep;
   uwgt=h.uwgt;
   user_rep=h.user_rep;
@@ -71,6 +79,10 @@ hist &hist::operator=(const hist &h) {
     extend_lhs=h.extend_lhs;
     hsize=h.hsize;
     ubin=h.ubin;
+    ubin_uniform=h.ubin_uniform;
+    ubin_log=h.ubin_log;
+    ubin_start=h.ubin_start;
+    ubin_scale=h.ubin_scale;
     urep=h.urep;
     uwgt=h.uwgt;
     user_rep=h.user_rep;
@@ -141,6 +153,7 @@ void hist::allocate(size_t n) {
   ubin.resize(n+1);
   uwgt.resize(n);
   hsize=n;
+  ubin_uniform=false;
 
   // Set all weights to zero
   for(size_t i=0;i<n;i++) uwgt[i]=0.0;
@@ -174,6 +187,21 @@ void hist::set_bin_edges(uniform_grid<double> g) {
   }
   // Set the bins from the uniform grid
   g.vector(ubin);
+  // Store the grid parameters for computing bin indices. Logarithmic
+  // grids with negative edges use the binary search instead.
+  double start=ubin[0], end=ubin[hsize];
+  ubin_log=g.is_log();
+  if (ubin_log) {
+    ubin_uniform=(start>0.0 && end>0.0);
+    if (ubin_uniform) {
+      ubin_start=log(start);
+      ubin_scale=((double)hsize)/(log(end)-ubin_start);
+    }
+  } else {
+    ubin_uniform=true;
+    ubin_start=start;
+    ubin_scale=((double)hsize)/(end-start);
+  }
   // Reset internal reps
   if (urep.size()>0) urep.resize(0);
   return;
@@ -196,6 +224,7 @@ void hist::clear() {
   if (hsize>0) {
     ubin.resize(0);
     uwgt.resize(0);
+    ubin_uniform=false;
     if (urep.size()>0) urep.resize(0);
     if (user_rep.size()>0) user_rep.resize(0);
     hsize=0;
@@ -203,55 +232,88 @@ void hist::clear() {
   return;
 }
 
+size_t hist::find_index(double x) const {
+  // Increasing case
+  if (ubin[0]<ubin[hsize]) {
+    if (x<ubin[0]) {
+      if (extend_lhs) return 0;
+      return hsize;
+    }
+    if (x>ubin[hsize]) {
+      if (extend_rhs) return hsize-1;
+      return hsize;
+    }
+    if (ubin_uniform) {
+      double t;
+      if (ubin_log) t=(log(x)-ubin_start)*ubin_scale;
+      else t=(x-ubin_start)*ubin_scale;
+      size_t i=0;
+      if (t>0.0) i=(size_t)t;
+      if (i>=hsize) i=hsize-1;
+      // Correct for finite precision in the bin edges
+      while (i>0 && x<ubin[i]) i--;
+      while (i+1<hsize && x>=ubin[i+1]) i++;
+      return i;
+    }
+    search_vec<const ubvector> sv(ubin.size(),ubin);
+    return sv.find_inc(x);
+  }
+  // Decreasing case
+  if (x>ubin[0]) {
+    if (extend_lhs) return 0;
+    return hsize;
+  }
+  if (x<ubin[hsize]) {
+    if (extend_rhs) return hsize-1;
+    return hsize;
+  }
+  if (ubin_uniform) {
+    double t;
+    if (ubin_log) t=(log(x)-ubin_start)*ubin_scale;
+    else t=(x-ubin_start)*ubin_scale;
+    size_t i=0;
+    if (t>0.0) i=(size_t)t;
+    if (i>=hsize) i=hsize-1;
+    // Correct for finite precision in the bin edges
+    while (i>0 && x>ubin[i]) i--;
+    while (i+1<hsize && x<=ubin[i+1]) i++;
+    return i;
+  }
+  search_vec<const ubvector> sv(ubin.size(),ubin);
+  return sv.find_dec(x);
+}
+
 size_t hist::get_bin_index(double x) const {
   if (hsize==0) {
     O2SCL_ERR2("Histogram has zero size in ",
 	      "hist::get_bin_index().",exc_einval);
   }
-  search_vec<const ubvector> sv(ubin.size(),ubin);
-  // Increasing case
+  size_t i=find_index(x);
+  if (i<hsize) return i;
+  
+  // Otherwise, call the error handler
+  std::string s;
   if (ubin[0]<ubin[hsize]) {
+    // Increasing case
     if (x<ubin[0]) {
-      if (extend_lhs) {
-	return 0;
-      } else {
-	std::string s="Value '"+dtos(x)+"' smaller than smallest "+
-	  "bin '"+dtos(ubin[0])+"' (increasing) in hist::get_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    if (x>ubin[hsize]) {
-      if (extend_rhs) {
-	return hsize-1;
-      } else {
-	std::string s="Value '"+dtos(x)+"' larger than largest "+
-	  "bin '"+dtos(ubin[hsize])+"' (increasing) in hist::get_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
+      s="Value '"+dtos(x)+"' smaller than smallest "+
+	"bin '"+dtos(ubin[0])+"' (increasing) in hist::get_bin_index().";
+    } else {
+      s="Value '"+dtos(x)+"' larger than largest "+
+	"bin '"+dtos(ubin[hsize])+"' (increasing) in hist::get_bin_index().";
     }
-    return sv.find_inc(x);
   } else {
     // Decreasing case
     if (x>ubin[0]) {
-      if (extend_lhs) {
-	return 0;
-      } else {
-	std::string s="Value '"+dtos(x)+"' larger than largest "+
-	  "bin '"+dtos(ubin[0])+"' (decreasing) in hist::get_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    if (x<ubin[hsize]) {
-      if (extend_rhs) {
-	return hsize-1;
-      } else {
-	std::string s="Value '"+dtos(x)+"' smaller than smallest "+
-	  "bin '"+dtos(ubin[hsize])+"' (decreasing) in hist::get_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
+      s="Value '"+dtos(x)+"' larger than largest "+
+	"bin '"+dtos(ubin[0])+"' (decreasing) in hist::get_bin_index().";
+    } else {
+      s="Value '"+dtos(x)+"' smaller than smallest "+
+	"bin '"+dtos(ubin[hsize])+"' (decreasing) in hist::get_bin_index().";
     }
-    return sv.find_dec(x);
   }
+  O2SCL_ERR(s.c_str(),exc_einval);
+  return 0;
 }
 
 double &hist::get_bin_low_i(size_t i) {
@@ -266,6 +328,7 @@ double &hist::get_bin_low_i(size_t i) {
     return ubin[0];
   }
   if (urep.size()>0) urep.resize(0);
+  ubin_uniform=false;
   return ubin[i];
 }
 
@@ -295,6 +358,7 @@ double &hist::get_bin_high_i(size_t i) {
     return ubin[0];
   }
   if (urep.size()>0) urep.resize(0);
+  ubin_uniform=false;
   return ubin[i+1];
 }
 
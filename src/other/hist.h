@@ -139,6 +139,85 @@ namespace o2scl {
     /// Interpolation type
     size_t itype;
 
+    /// If true, the bins were set from a \ref uniform_grid object
+    bool ubin_uniform;
+
+    /// If true, the uniform bins are logarithmically spaced
+    bool ubin_log;
+
+    /// The first bin edge (or its logarithm) for uniform bins
+    double ubin_start;
+
+    /// The number of bins over the full range for uniform bins
+    double ubin_scale;
+
+    /** \brief Return the index of the bin which holds \c x, or 
+	\ref hsize if \c x is outside the histogram
+
+	For bins set from a \ref uniform_grid object, the index is
+	computed arithmetically and then corrected against the
+	stored bin edges, otherwise a binary search is used. This
+	function does not call the error handler and assumes 
+	that \ref hsize is not zero.
+    */
+    size_t find_index(double x) const;
+
+    /** \brief Increment the bins for the values in \c v, using
+	the weights in \c w if \c weighted is true
+    */
+    template<class vec_t, class vec2_t>
+      void update_many_base(size_t n, const vec_t &v, const vec2_t &w,
+			    bool weighted) {
+      
+      if (hsize==0) {
+	O2SCL_ERR2("Histogram has zero size in ",
+		   "hist::update_many().",exc_einval);
+      }
+      if (n==0) return;
+
+      // The index of the first value outside the histogram
+      size_t bad=n;
+
+      // Bin the data into thread-local weights and then add the
+      // results to the histogram
+#ifdef O2SCL_OPENMP
+#pragma omp parallel if (n>=1000)
+#endif
+      {
+	ubvector lwgt(hsize);
+	for(size_t j=0;j<hsize;j++) lwgt[j]=0.0;
+	size_t lbad=n;
+	
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+	for(size_t i=0;i<n;i++) {
+	  size_t ix=find_index(v[i]);
+	  if (ix==hsize) {
+	    if (i<lbad) lbad=i;
+	  } else if (weighted) {
+	    lwgt[ix]+=w[i];
+	  } else {
+	    lwgt[ix]+=1.0;
+	  }
+	}
+
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_hist_update_many)
+#endif
+	{
+	  for(size_t j=0;j<hsize;j++) uwgt[j]+=lwgt[j];
+	  if (lbad<bad) bad=lbad;
+	}
+      }
+
+      // Call the error handler for the first value which was 
+      // outside the histogram
+      if (bad<n) get_bin_index(v[bad]);
+      
+      return;
+    }
+
     /** \brief Set the representative array according to current 
 	rmode (if not in user rep mode)
      */
@@ -174,15 +253,14 @@ namespace o2scl {
       hsize=0;
       extend_lhs=true;
       extend_rhs=true;
+      ubin_uniform=false;
       
       double min, max;
       o2scl::vector_minmax_value(nv,v,min,max);
       uniform_grid<double> ug=uniform_grid_end<double>(min,max,n_bins);
       set_bin_edges(ug);
 
-      for(size_t i=0;i<nv;i++) {
-	update(v[i]);
-      }
+      update_many(nv,v);
       return;
     }
     
@@ -196,15 +274,14 @@ namespace o2scl {
       hsize=0;
       extend_lhs=true;
       extend_rhs=true;
+      ubin_uniform=false;
       
       double min, max;
       o2scl::vector_minmax_value(nv,v,min,max);
       uniform_grid<double> ug=uniform_grid_end<double>(min,max,n_bins);
       set_bin_edges(ug);
 
-      for(size_t i=0;i<nv;i++) {
-	update(v[i],v2[i]);
-      }
+      update_many(nv,v,v2);
       return;
     }
     
@@ -271,6 +348,10 @@ namespace o2scl {
 	representative mode is automatically set to \ref rmode_avg (or
 	\ref rmode_gmean if \ref uniform_grid::is_log() returns \c
 	true ) .
+
+	When the bins are set from a \ref uniform_grid object, the 
+	bin index for a value is computed arithmetically rather than 
+	with a binary search.
     */
     void set_bin_edges(uniform_grid<double> g);
 
@@ -291,6 +372,7 @@ namespace o2scl {
 	allocate(n-1);
       }
       for(size_t i=0;i<n;i++) ubin[i]=v[i];
+      ubin_uniform=false;
       // Reset internal reps
       if (urep.size()>0) urep.clear();
       return;
@@ -302,6 +384,30 @@ namespace o2scl {
     /// Increment bin for \c x by value \c val
     void update(double x, double val=1.0);
 
+    /** \brief Increment the bins for the first \c n values in
+	\c v by one
+
+	This is equivalent to calling \ref update() for each value,
+	except that if \c O2SCL_OPENMP is defined, the values are
+	binned in parallel into thread-local weights which are
+	added to the histogram at the end. If any of the values are
+	outside the histogram, all of the other values are added
+	before the error handler is called.
+    */
+    template<class vec_t> void update_many(size_t n, const vec_t &v) {
+      update_many_base(n,v,v,false);
+      return;
+    }
+
+    /** \brief Increment the bins for the first \c n values in
+	\c v by the corresponding weights in \c w
+    */
+    template<class vec_t, class vec2_t>
+      void update_many(size_t n, const vec_t &v, const vec2_t &w) {
+      update_many_base(n,v,w,true);
+      return;
+    }
+
     /// Increment bin with index \c i by value \c val
     void update_i(size_t i, double val=1.0) {
       uwgt[i]+=val;
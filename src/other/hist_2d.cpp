@@ -36,6 +36,14 @@ hist_2d::hist_2d() {
   extend_lhs=false;
   hsize_x=0;
   hsize_y=0;
+  x_uniform=false;
+  y_uniform=false;
+  x_log=false;
+  y_log=false;
+  x_start=0.0;
+  y_start=0.0;
+  x_scale=0.0;
+  y_scale=0.0;
 #if !O2SCL_NO_RANGE_CHECK
   is_valid();
 #endif
@@ -54,6 +62,14 @@ hist_2d::hist_2d(const hist_2d &h) {
   hsize_y=h.hsize_y;
   xa=h.xa;
   ya=h.ya;
+  x_uniform=h.x_uniform;
+  y_uniform=h.y_uniform;
+  x_log=h.x_log;
+  y_log=h.y_log;
+  x_start=h.x_start;
+  y_start=h.y_start;
+  x_scale=h.x_scale;
+  y_scale=h.y_scale;
   xrep=h.xrep;
   yrep=h.yrep;
   user_xrep=h.user_xrep;
@@ -73,6 +89,14 @@ hist_2d &hist_2d::operator=(const hist_2d &h) {
     hsize_y=h.hsize_y;
     xa=h.xa;
     ya=h.ya;
+    x_uniform=h.x_uniform;
+    y_uniform=h.y_uniform;
+    x_log=h.x_log;
+    y_log=h.y_log;
+    x_start=h.x_start;
+    y_start=h.y_start;
+    x_scale=h.x_scale;
+    y_scale=h.y_scale;
     xrep=h.xrep;
     yrep=h.yrep;
     user_xrep=h.user_xrep;
@@ -120,6 +144,33 @@ void hist_2d::set_bin_edges(uniform_grid<double> gx, uniform_grid<double> gy) {
   gx.vector(xa);
   gy.vector(ya);
 
+  // Store the grid parameters for computing bin indices. Logarithmic
+  // grids with negative edges use the binary search instead.
+  x_log=gx.is_log();
+  if (x_log) {
+    x_uniform=(xa[0]>0.0 && xa[hsize_x]>0.0);
+    if (x_uniform) {
+      x_start=log(xa[0]);
+      x_scale=((double)hsize_x)/(log(xa[hsize_x])-x_start);
+    }
+  } else {
+    x_uniform=true;
+    x_start=xa[0];
+    x_scale=((double)hsize_x)/(xa[hsize_x]-xa[0]);
+  }
+  y_log=gy.is_log();
+  if (y_log) {
+    y_uniform=(ya[0]>0.0 && ya[hsize_y]>0.0);
+    if (y_uniform) {
+      y_start=log(ya[0]);
+      y_scale=((double)hsize_y)/(log(ya[hsize_y])-y_start);
+    }
+  } else {
+    y_uniform=true;
+    y_start=ya[0];
+    y_scale=((double)hsize_y)/(ya[hsize_y]-ya[0]);
+  }
+
   // Reset internal reps
   if (xrep.size()>0) xrep.resize(0);
   if (yrep.size()>0) yrep.resize(0);
@@ -142,6 +193,8 @@ void hist_2d::allocate(size_t nx, size_t ny) {
   wgt.resize(nx,ny);
   hsize_x=nx;
   hsize_y=ny;
+  x_uniform=false;
+  y_uniform=false;
 
   // Set all weights to zero
   for(size_t i=0;i<nx;i++) {
@@ -232,6 +285,8 @@ void hist_2d::clear() {
     yrep.resize(0);
     hsize_x=0;
     hsize_y=0;
+    x_uniform=false;
+    y_uniform=false;
   }
   return;
 }
@@ -243,114 +298,109 @@ void hist_2d::get_bin_indices(double x, double y,
   return;
 }
 
+size_t hist_2d::find_index(double x, const ubvector &edges, size_t n,
+			   bool uniform, bool lg, double start,
+			   double scale) const {
+  // Increasing case
+  if (edges[0]<edges[n]) {
+    if (x<edges[0]) {
+      if (extend_lhs) return 0;
+      return n;
+    }
+    if (x>edges[n]) {
+      if (extend_rhs) return n-1;
+      return n;
+    }
+    if (uniform) {
+      double t;
+      if (lg) t=(log(x)-start)*scale;
+      else t=(x-start)*scale;
+      size_t i=0;
+      if (t>0.0) i=(size_t)t;
+      if (i>=n) i=n-1;
+      // Correct for finite precision in the bin edges
+      while (i>0 && x<edges[i]) i--;
+      while (i+1<n && x>=edges[i+1]) i++;
+      return i;
+    }
+    search_vec<const ubvector> sv(edges.size(),edges);
+    return sv.find_inc(x);
+  }
+  // Decreasing case
+  if (x>edges[0]) {
+    if (extend_lhs) return 0;
+    return n;
+  }
+  if (x<edges[n]) {
+    if (extend_rhs) return n-1;
+    return n;
+  }
+  if (uniform) {
+    double t;
+    if (lg) t=(log(x)-start)*scale;
+    else t=(x-start)*scale;
+    size_t i=0;
+    if (t>0.0) i=(size_t)t;
+    if (i>=n) i=n-1;
+    // Correct for finite precision in the bin edges
+    while (i>0 && x>edges[i]) i--;
+    while (i+1<n && x<=edges[i+1]) i++;
+    return i;
+  }
+  search_vec<const ubvector> sv(edges.size(),edges);
+  return sv.find_dec(x);
+}
+
 size_t hist_2d::get_x_bin_index(double x) const {
-  size_t i;
 
   if (hsize_x==0) {
     O2SCL_ERR2("Histogram has zero size in ",
 	      "hist::get_x_bin_index().",exc_einval);
   }
 
-  // Compute x index
-  search_vec<const ubvector> sv(xa.size(),xa);
-  if (xa[0]<xa[hsize_x]) {
-    if (x<xa[0]) {
-      if (extend_lhs) {
-	return 0;
-      } else {
-	std::string s="Value '"+dtos(x)+"' smaller than smallest "+
-	  "bin '"+dtos(xa[0])+"' in hist_2d::get_x_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    if (x>xa[hsize_x]) {
-      if (extend_rhs) {
-	return hsize_x-1;
-      } else {
-	std::string s="Value '"+dtos(x)+"' larger than largest "+
-	  "bin '"+dtos(xa[hsize_x])+"' in hist_2d::get_x_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    i=sv.find_inc(x);
+  size_t i=find_index(x,xa,hsize_x,x_uniform,x_log,x_start,x_scale);
+  if (i<hsize_x) return i;
+
+  // Otherwise, call the error handler
+  std::string s;
+  if ((xa[0]<xa[hsize_x] && x<xa[0]) ||
+      (xa[0]>xa[hsize_x] && x<xa[hsize_x])) {
+    s="Value '"+dtos(x)+"' smaller than smallest "+
+      "bin '"+dtos(std::min(xa[0],xa[hsize_x]))+
+      "' in hist_2d::get_x_bin_index().";
   } else {
-    if (x>xa[0]) {
-      if (extend_lhs) {
-	return 0;
-      } else {
-	std::string s="Value '"+dtos(x)+"' larger than largest "+
-	  "bin '"+dtos(xa[0])+"' in hist_2d::get_x_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    if (x<xa[hsize_x]) {
-      if (extend_rhs) {
-	return hsize_x-1;
-      } else {
-	std::string s="Value '"+dtos(x)+"' smaller than smallest "+
-	  "bin '"+dtos(xa[hsize_x])+"' in hist_2d::get_x_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    i=sv.find_dec(x);
+    s="Value '"+dtos(x)+"' larger than largest "+
+      "bin '"+dtos(std::max(xa[0],xa[hsize_x]))+
+      "' in hist_2d::get_x_bin_index().";
   }
-
-  return i;
+  O2SCL_ERR(s.c_str(),exc_einval);
+  return 0;
 }
 
 size_t hist_2d::get_y_bin_index(double y) const {
-  size_t j;
 
   if (hsize_y==0) {
     O2SCL_ERR2("Histogram has zero size in ",
 	      "hist::get_y_bin_index().",exc_einval);
   }
 
-  // Compute y index
-  search_vec<const ubvector> sv2(ya.size(),ya);
-  if (ya[0]<ya[hsize_y]) {
-    if (y<ya[0]) {
-      if (extend_lhs) {
-	return 0;
-      } else {
-	std::string s="Value '"+dtos(y)+"' smaller than smallest "+
-	  "bin '"+dtos(ya[0])+"' in hist_2d::get_y_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    if (y>ya[hsize_y]) {
-      if (extend_rhs) {
-	return hsize_y-1;
-      } else {
-	std::string s="Value '"+dtos(y)+"' larger than largest "+
-	  "bin '"+dtos(ya[hsize_y])+"' in hist_2d::get_y_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    j=sv2.find_inc(y);
+  size_t j=find_index(y,ya,hsize_y,y_uniform,y_log,y_start,y_scale);
+  if (j<hsize_y) return j;
+
+  // Otherwise, call the error handler
+  std::string s;
+  if ((ya[0]<ya[hsize_y] && y<ya[0]) ||
+      (ya[0]>ya[hsize_y] && y<ya[hsize_y])) {
+    s="Value '"+dtos(y)+"' smaller than smallest "+
+      "bin '"+dtos(std::min(ya[0],ya[hsize_y]))+
+      "' in hist_2d::get_y_bin_index().";
   } else {
-    if (y>ya[0]) {
-      if (extend_lhs) {
-	return 0;
-      } else {
-	std::string s="Value '"+dtos(y)+"' larger than largest "+
-	  "bin '"+dtos(ya[0])+"' in hist_2d::get_y_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    if (y<ya[hsize_y]) {
-      if (extend_rhs) {
-	return hsize_y-1;
-      } else {
-	std::string s="Value '"+dtos(y)+"' smaller than smallest "+
-	  "bin '"+dtos(ya[hsize_y])+"' in hist_2d::get_y_bin_index().";
-	O2SCL_ERR(s.c_str(),exc_einval);
-      }
-    }
-    j=sv2.find_dec(y);
+    s="Value '"+dtos(y)+"' larger than largest "+
+      "bin '"+dtos(std::max(ya[0],ya[hsize_y]))+
+      "' in hist_2d::get_y_bin_index().";
   }
-
-  return j;
+  O2SCL_ERR(s.c_str(),exc_einval);
+  return 0;
 }
 
 double &hist_2d::get_x_low_i(size_t i) {
@@ -365,6 +415,7 @@ double &hist_2d::get_x_low_i(size_t i) {
     return xa[0];
   }
   if (xrep.size()>0) xrep.resize(0);
+  x_uniform=false;
   return xa[i];
 }
 
@@ -394,6 +445,7 @@ double &hist_2d::get_x_high_i(size_t i) {
     return xa[0];
   }
   if (xrep.size()>0) xrep.resize(0);
+  x_uniform=false;
   return xa[i+1];
 }
 
@@ -423,6 +475,7 @@ double &hist_2d::get_y_low_i(size_t j) {
     return ya[0];
   }
   if (yrep.size()>0) yrep.resize(0);
+  y_uniform=false;
   return ya[j];
 }
 
@@ -452,6 +505,7 @@ double &hist_2d::get_y_high_i(size_t j) {
     return ya[0];
   }
   if (yrep.size()>0) yrep.resize(0);
+  y_uniform=false;
   return ya[j+1];
 }
 
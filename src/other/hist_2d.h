@@ -142,6 +142,113 @@ namespace o2scl {
     /// Rep mode for y
     size_t yrmode;
 
+    /// If true, the x bins were set from a \ref uniform_grid object
+    bool x_uniform;
+
+    /// If true, the y bins were set from a \ref uniform_grid object
+    bool y_uniform;
+
+    /// If true, the uniform x bins are logarithmically spaced
+    bool x_log;
+
+    /// If true, the uniform y bins are logarithmically spaced
+    bool y_log;
+
+    /// The first x bin edge (or its logarithm) for uniform bins
+    double x_start;
+
+    /// The first y bin edge (or its logarithm) for uniform bins
+    double y_start;
+
+    /// The number of x bins over the full x range for uniform bins
+    double x_scale;
+
+    /// The number of y bins over the full y range for uniform bins
+    double y_scale;
+
+    /** \brief Return the index of the bin in \c edges which holds
+	\c x, or \c n if \c x is outside the histogram
+
+	For bins set from a \ref uniform_grid object, the index is
+	computed arithmetically and then corrected against the
+	stored bin edges, otherwise a binary search is used. This
+	function does not call the error handler and assumes 
+	that \c n is not zero.
+    */
+    size_t find_index(double x, const ubvector &edges, size_t n,
+		      bool uniform, bool lg, double start,
+		      double scale) const;
+
+    /** \brief Increment the bins for the values in \c vx and
+	\c vy, using the weights in \c w if \c weighted is true
+    */
+    template<class vec_t, class vec2_t, class vec3_t>
+      void update_many_base(size_t n, const vec_t &vx, const vec2_t &vy,
+			    const vec3_t &w, bool weighted) {
+      
+      if (hsize_x==0) {
+	O2SCL_ERR2("Histogram has zero size in ",
+		   "hist_2d::update_many().",exc_einval);
+      }
+      if (n==0) return;
+
+      // The index of the first value outside the histogram
+      size_t bad=n;
+
+      // Bin the data into thread-local weights and then add the
+      // results to the histogram
+#ifdef O2SCL_OPENMP
+#pragma omp parallel if (n>=1000)
+#endif
+      {
+	ubmatrix lwgt(hsize_x,hsize_y);
+	for(size_t i=0;i<hsize_x;i++) {
+	  for(size_t j=0;j<hsize_y;j++) {
+	    lwgt(i,j)=0.0;
+	  }
+	}
+	size_t lbad=n;
+	
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+	for(size_t k=0;k<n;k++) {
+	  size_t i=find_index(vx[k],xa,hsize_x,x_uniform,x_log,
+			      x_start,x_scale);
+	  size_t j=find_index(vy[k],ya,hsize_y,y_uniform,y_log,
+			      y_start,y_scale);
+	  if (i==hsize_x || j==hsize_y) {
+	    if (k<lbad) lbad=k;
+	  } else if (weighted) {
+	    lwgt(i,j)+=w[k];
+	  } else {
+	    lwgt(i,j)+=1.0;
+	  }
+	}
+
+#ifdef O2SCL_OPENMP
+#pragma omp critical (o2scl_hist_2d_update_many)
+#endif
+	{
+	  for(size_t i=0;i<hsize_x;i++) {
+	    for(size_t j=0;j<hsize_y;j++) {
+	      wgt(i,j)+=lwgt(i,j);
+	    }
+	  }
+	  if (lbad<bad) bad=lbad;
+	}
+      }
+
+      // Call the error handler for the first value which was 
+      // outside the histogram
+      if (bad<n) {
+	size_t i, j;
+	get_bin_indices(vx[bad],vy[bad],i,j);
+      }
+      
+      return;
+    }
+
     /** \brief Allocate for a histogram of size \c nx, \c ny
 	
 	This function also sets all the weights to zero.
@@ -176,6 +283,8 @@ namespace o2scl {
       extend_lhs=false;
       hsize_x=0;
       hsize_y=0;
+      x_uniform=false;
+      y_uniform=false;
 
       double min_x, max_x, min_y, max_y;
       o2scl::vector_minmax_value(nv,v,min_x,max_x);
@@ -184,9 +293,7 @@ namespace o2scl {
       uniform_grid<double> ugy=uniform_grid_end<double>(min_y,max_y,n_bins_y);
       set_bin_edges(ugx,ugy);
       
-      for(size_t i=0;i<nv;i++) {
-	update(v[i],v2[i]);
-      }
+      update_many(nv,v,v2);
       return;
     }
     
@@ -201,6 +308,8 @@ namespace o2scl {
       extend_lhs=false;
       hsize_x=0;
       hsize_y=0;
+      x_uniform=false;
+      y_uniform=false;
     
       double min_x, max_x, min_y, max_y;
       o2scl::vector_minmax_value(nv,v,min_x,max_x);
@@ -209,9 +318,7 @@ namespace o2scl {
       uniform_grid<double> ugy=uniform_grid_end<double>(min_y,max_y,n_bins_y);
       set_bin_edges(ugx,ugy);
     
-      for(size_t i=0;i<nv;i++) {
-	update(v[i],v2[i],v3[i]);
-      }
+      update_many(nv,v,v2,v3);
       return;
     }
     
@@ -293,6 +400,8 @@ namespace o2scl {
       }
       for(size_t i=0;i<nx;i++) xa[i]=vx[i];
       for(size_t i=0;i<ny;i++) ya[i]=vy[i];
+      x_uniform=false;
+      y_uniform=false;
       // Reset internal reps
       if (xrep.size()>0) xrep.resize(0);
       if (yrep.size()>0) yrep.resize(0);
@@ -316,6 +425,32 @@ namespace o2scl {
       return;
     }
 
+    /** \brief Increment the bins for the first \c n points in
+	\c vx and \c vy by one
+
+	This is equivalent to calling \ref update() for each point,
+	except that if \c O2SCL_OPENMP is defined, the points are
+	binned in parallel into thread-local weights which are
+	added to the histogram at the end. If any of the points are
+	outside the histogram, all of the other points are added
+	before the error handler is called.
+    */
+    template<class vec_t, class vec2_t>
+      void update_many(size_t n, const vec_t &vx, const vec2_t &vy) {
+      update_many_base(n,vx,vy,vx,false);
+      return;
+    }
+
+    /** \brief Increment the bins for the first \c n points in
+	\c vx and \c vy by the corresponding weights in \c w
+    */
+    template<class vec_t, class vec2_t, class vec3_t>
+      void update_many(size_t n, const vec_t &vx, const vec2_t &vy,
+		       const vec3_t &w) {
+      update_many_base(n,vx,vy,w,true);
+      return;
+    }
+
     /// Return contents of bin at <tt>(i,j)</tt>
     const double &get_wgt_i(size_t i, size_t j) const;
 
@@ -49,6 +49,41 @@ int main(void) {
   for(size_t i=0;i<10000;i++) {
     h.update(gr.random()*gr.random()+1.0,gr.random()*gr.random()*9.0);
   }
+
+  // Compare update_many() for uniform bins with update() for
+  // the same bin edges set from vectors
+  {
+    hist_2d hu, hv;
+    uniform_grid<> ugx=uniform_grid_end<>(1.0,2.0,10);
+    uniform_grid<> ugy=uniform_grid_log_end<>(1.0e-3,10.0,8);
+    hu.set_bin_edges(ugx,ugy);
+    vector<double> ex, ey;
+    ugx.vector(ex);
+    ugy.vector(ey);
+    hv.set_bin_edges(ex.size(),ex,ey.size(),ey);
+    
+    vector<double> vx, vy;
+    for(size_t i=0;i<ex.size();i++) {
+      for(size_t j=0;j<ey.size();j++) {
+	vx.push_back(ex[i]);
+	vy.push_back(ey[j]);
+      }
+    }
+    for(size_t i=0;i<5000;i++) {
+      vx.push_back(1.0+gr.random());
+      vy.push_back(pow(10.0,4.0*gr.random()-3.0));
+    }
+    for(size_t i=0;i<vx.size();i++) {
+      hv.update(vx[i],vy[i]);
+    }
+    hu.update_many(vx.size(),vx,vy);
+    for(size_t i=0;i<10;i++) {
+      for(size_t j=0;j<8;j++) {
+	t.test_rel(hu.get_wgt_i(i,j),hv.get_wgt_i(i,j),1.0e-12,
+		   "update_many");
+      }
+    }
+  }
   
   t.report();
   return 0;
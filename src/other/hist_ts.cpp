@@ -72,6 +72,45 @@ int main(void) {
     cout << i << " " << h2.get_rep_i(i) << " " << h2[i] << endl;
   }
   cout << h2.sum_wgts() << endl;
+
+  // Compare the arithmetic bin index for uniform bins with the
+  // binary search for the same bin edges set from a vector
+  {
+    uniform_grid<> ug[3]={uniform_grid_end<>(0.0,1.0,17),
+			  uniform_grid_end<>(1.0,0.0,13),
+			  uniform_grid_log_end<>(1.0e-2,1.0e2,11)};
+    for(size_t k=0;k<3;k++) {
+      hist hu, hv;
+      hu.set_bin_edges(ug[k]);
+      vector<double> edges;
+      ug[k].vector(edges);
+      hv.set_bin_edges(edges.size(),edges);
+      // Include all of the bin edges
+      vector<double> vx=edges;
+      for(size_t i=0;i<2000;i++) {
+	double r=gr.random();
+	if (k==2) vx.push_back(pow(10.0,4.0*r-2.0));
+	else vx.push_back(r);
+      }
+      for(size_t i=0;i<vx.size();i++) {
+	t.test_gen(hu.get_bin_index(vx[i])==hv.get_bin_index(vx[i]),
+		   "uniform bin index");
+      }
+      
+      // Compare update_many() with update()
+      hist hm(hu);
+      hm.clear_wgts();
+      vector<double> vw(vx.size());
+      for(size_t i=0;i<vx.size();i++) {
+	vw[i]=gr.random();
+	hv.update(vx[i],vw[i]);
+      }
+      hm.update_many(vx.size(),vx,vw);
+      for(size_t i=0;i<hm.size();i++) {
+	t.test_rel(hm.get_wgt_i(i),hv.get_wgt_i(i),1.0e-12,"update_many");
+      }
+    }
+  }
   
   t.report();
   return 0;
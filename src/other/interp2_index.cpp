@@ -0,0 +1,494 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <limits>
+
+#include <o2scl/interp2_index.h>
+
+using namespace std;
+using namespace o2scl;
+
+interp2_grid_index::interp2_grid_index() {
+  np=0;
+  sdx=1.0;
+  sdy=1.0;
+  gx0=0.0;
+  gy0=0.0;
+  gw=1.0;
+  gh=1.0;
+  gnx=0;
+  gny=0;
+}
+
+void interp2_grid_index::build() {
+
+  cell_start.clear();
+  cell_pts.clear();
+  gnx=0;
+  gny=0;
+  if (np==0) return;
+
+  // Determine the bounding box in scaled coordinates
+  double minx=px[0]/sdx, maxx=minx;
+  double miny=py[0]/sdy, maxy=miny;
+  for(size_t i=1;i<np;i++) {
+    double sx=px[i]/sdx, sy=py[i]/sdy;
+    if (sx<minx) minx=sx;
+    if (sx>maxx) maxx=sx;
+    if (sy<miny) miny=sy;
+    if (sy>maxy) maxy=sy;
+  }
+  double wx=maxx-minx, wy=maxy-miny;
+
+  // Choose the grid so that there are about two points per cell
+  double ncell=((double)np)/2.0;
+  if (ncell<1.0) ncell=1.0;
+  if (wx>0.0 && wy>0.0) {
+    double side=sqrt(wx*wy/ncell);
+    gnx=(size_t)ceil(wx/side);
+    gny=(size_t)ceil(wy/side);
+  } else if (wx>0.0) {
+    gnx=(size_t)ceil(ncell);
+    gny=1;
+  } else if (wy>0.0) {
+    gnx=1;
+    gny=(size_t)ceil(ncell);
+  } else {
+    gnx=1;
+    gny=1;
+  }
+  if (gnx<1) gnx=1;
+  if (gny<1) gny=1;
+  if (gnx>np) gnx=np;
+  if (gny>np) gny=np;
+  gx0=minx;
+  gy0=miny;
+  gw=(wx>0.0) ? wx/((double)gnx) : 1.0;
+  gh=(wy>0.0) ? wy/((double)gny) : 1.0;
+
+  // Sort the points into the cells with a counting sort
+  std::vector<size_t> cell(np);
+  cell_start.resize(gnx*gny+1,0);
+  for(size_t i=0;i<np;i++) {
+    double fx=(px[i]/sdx-gx0)/gw, fy=(py[i]/sdy-gy0)/gh;
+    size_t ix=(fx<=0.0) ? 0 : (size_t)fx;
+    size_t iy=(fy<=0.0) ? 0 : (size_t)fy;
+    if (ix>=gnx) ix=gnx-1;
+    if (iy>=gny) iy=gny-1;
+    cell[i]=iy*gnx+ix;
+    cell_start[cell[i]+1]++;
+  }
+  for(size_t c=0;c<gnx*gny;c++) {
+    cell_start[c+1]+=cell_start[c];
+  }
+  cell_pts.resize(np);
+  std::vector<size_t> next(cell_start.begin(),cell_start.end()-1);
+  for(size_t i=0;i<np;i++) {
+    cell_pts[next[cell[i]]++]=i;
+  }
+
+  return;
+}
+
+size_t interp2_grid_index::nearest(double x, double y, size_t k,
+				   size_t *ind, double *dist2) const {
+
+  if (np==0 || k==0) return 0;
+  if (k>np) k=np;
+
+  // Find the cell containing the point, or the closest cell if the
+  // point is outside the grid
+  double qx=x/sdx, qy=y/sdy;
+  double fx=(qx-gx0)/gw, fy=(qy-gy0)/gh;
+  long cx, cy;
+  if (fx<=0.0) cx=0;
+  else if (fx>=((double)gnx)) cx=((long)gnx)-1;
+  else cx=(long)fx;
+  if (fy<=0.0) cy=0;
+  else if (fy>=((double)gny)) cy=((long)gny)-1;
+  else cy=(long)fy;
+
+  size_t found=0;
+
+  for(long r=0;;r++) {
+
+    long i0=cx-r, i1=cx+r, j0=cy-r, j1=cy+r;
+
+    // Search the cells in the ring at distance r
+    for(long j=j0;j<=j1;j++) {
+      if (j<0 || j>=((long)gny)) continue;
+      long step=(j==j0 || j==j1) ? 1 : i1-i0;
+      for(long i=i0;i<=i1;i+=step) {
+	if (i<0 || i>=((long)gnx)) continue;
+	size_t c=((size_t)j)*gnx+((size_t)i);
+	for(size_t m=cell_start[c];m<cell_start[c+1];m++) {
+	  size_t p=cell_pts[m];
+	  double ddx=(x-px[p])/sdx, ddy=(y-py[p])/sdy;
+	  double d2=ddx*ddx+ddy*ddy;
+	  if (found<k || d2<dist2[k-1] || (d2==dist2[k-1] && p<ind[k-1])) {
+	    size_t pos;
+	    if (found<k) {
+	      pos=found;
+	      found++;
+	    } else {
+	      pos=k-1;
+	    }
+	    while (pos>0 && (dist2[pos-1]>d2 ||
+			     (dist2[pos-1]==d2 && ind[pos-1]>p))) {
+	      dist2[pos]=dist2[pos-1];
+	      ind[pos]=ind[pos-1];
+	      pos--;
+	    }
+	    dist2[pos]=d2;
+	    ind[pos]=p;
+	  }
+	}
+      }
+    }
+
+    // Determine the smallest distance to a cell which has not yet
+    // been searched
+    bool more=false;
+    double bound=std::numeric_limits<double>::infinity();
+    if (i0>0) {
+      more=true;
+      bound=std::min(bound,qx-(gx0+i0*gw));
+    }
+    if (i1<((long)gnx)-1) {
+      more=true;
+      bound=std::min(bound,gx0+(i1+1)*gw-qx);
+    }
+    if (j0>0) {
+      more=true;
+      bound=std::min(bound,qy-(gy0+j0*gh));
+    }
+    if (j1<((long)gny)-1) {
+      more=true;
+      bound=std::min(bound,gy0+(j1+1)*gh-qy);
+    }
+    if (more==false) break;
+    if (found==k && bound>0.0 &&
+	bound*bound>dist2[k-1]*(1.0+1.0e-12)) break;
+  }
+
+  return found;
+}
+
+void interp2_grid_index::local_order(std::vector<size_t> &order) const {
+  order.clear();
+  order.reserve(np);
+  // Traverse the rows of cells in alternating directions
+  for(size_t j=0;j<gny;j++) {
+    for(size_t ii=0;ii<gnx;ii++) {
+      size_t i=(j%2==0) ? ii : gnx-1-ii;
+      size_t c=j*gnx+i;
+      for(size_t m=cell_start[c];m<cell_start[c+1];m++) {
+	order.push_back(cell_pts[m]);
+      }
+    }
+  }
+  return;
+}
+
+interp2_delaunay::interp2_delaunay() {
+  np=0;
+  last=-1;
+}
+
+bool interp2_delaunay::in_circle(const triangle &t, double x,
+				 double y) const {
+  double adx=vx[t.v[0]]-x, ady=vy[t.v[0]]-y;
+  double bdx=vx[t.v[1]]-x, bdy=vy[t.v[1]]-y;
+  double cdx=vx[t.v[2]]-x, cdy=vy[t.v[2]]-y;
+  double det=(adx*adx+ady*ady)*(bdx*cdy-cdx*bdy)+
+    (bdx*bdx+bdy*bdy)*(cdx*ady-adx*cdy)+
+    (cdx*cdx+cdy*cdy)*(adx*bdy-bdx*ady);
+  return det>0.0;
+}
+
+long interp2_delaunay::locate(long start, double x, double y) const {
+  long t=start;
+  size_t max_steps=tris.size()+10;
+  for(size_t step=0;t>=0 && step<max_steps;step++) {
+    const triangle &tr=tris[t];
+    bool moved=false;
+    // Rotate the first edge which is tested to avoid cycles
+    for(size_t k=0;k<3 && moved==false;k++) {
+      size_t e=(k+step)%3;
+      if (orient(tr.v[(e+1)%3],tr.v[(e+2)%3],x,y)<0.0) {
+	t=tr.nb[e];
+	moved=true;
+      }
+    }
+    if (moved==false) return t;
+  }
+  return -1;
+}
+
+size_t interp2_delaunay::new_triangle(size_t a, size_t b, size_t c) {
+  size_t t;
+  if (free_tris.size()>0) {
+    t=free_tris.back();
+    free_tris.pop_back();
+  } else {
+    t=tris.size();
+    tris.push_back(triangle());
+    cav_mark.push_back(0);
+  }
+  tris[t].v[0]=a;
+  tris[t].v[1]=b;
+  tris[t].v[2]=c;
+  tris[t].nb[0]=-1;
+  tris[t].nb[1]=-1;
+  tris[t].nb[2]=-1;
+  tris[t].alive=true;
+  return t;
+}
+
+void interp2_delaunay::insert(size_t p) {
+
+  double x=vx[p], y=vy[p];
+
+  // Locate the triangle containing the new point, falling back to
+  // an exhaustive search if the walk fails
+  long t=locate(last,x,y);
+  if (t<0) {
+    for(size_t i=0;i<tris.size() && t<0;i++) {
+      const triangle &tr=tris[i];
+      if (tr.alive && orient(tr.v[1],tr.v[2],x,y)>=0.0 &&
+	  orient(tr.v[2],tr.v[0],x,y)>=0.0 &&
+	  orient(tr.v[0],tr.v[1],x,y)>=0.0) {
+	t=i;
+      }
+    }
+    if (t<0) return;
+  }
+
+  // Ignore duplicate points
+  for(size_t i=0;i<3;i++) {
+    size_t v=tris[t].v[i];
+    if (vx[v]==x && vy[v]==y) return;
+  }
+
+  // Find the triangles whose circumcircles contain the point
+  cav.clear();
+  cav.push_back(t);
+  cav_mark[t]=1;
+  for(size_t k=0;k<cav.size();k++) {
+    size_t c=cav[k];
+    for(size_t e=0;e<3;e++) {
+      long nb=tris[c].nb[e];
+      if (nb<0 || cav_mark[nb]) continue;
+      bool add=in_circle(tris[nb],x,y);
+      // Always include the neighbor if the point is on the shared edge
+      if (add==false && c==((size_t)t) &&
+	  orient(tris[c].v[(e+1)%3],tris[c].v[(e+2)%3],x,y)==0.0) {
+	add=true;
+      }
+      if (add) {
+	cav_mark[nb]=1;
+	cav.push_back(nb);
+      }
+    }
+  }
+
+  // Ensure that every boundary edge of the cavity is visible from
+  // the new point, which can fail because of roundoff in the
+  // circumcircle test
+  bool changed=true;
+  while (changed) {
+    changed=false;
+    for(size_t k=1;k<cav.size() && changed==false;k++) {
+      size_t c=cav[k];
+      for(size_t e=0;e<3 && changed==false;e++) {
+	long nb=tris[c].nb[e];
+	if ((nb<0 || cav_mark[nb]==0) &&
+	    orient(tris[c].v[(e+1)%3],tris[c].v[(e+2)%3],x,y)<=0.0) {
+	  cav_mark[c]=0;
+	  changed=true;
+	}
+      }
+    }
+    if (changed) {
+      // Keep only the triangles still connected to the first one
+      std::vector<size_t> old_cav(cav);
+      cav.clear();
+      cav.push_back(t);
+      cav_mark[t]=2;
+      for(size_t k=0;k<cav.size();k++) {
+	size_t c=cav[k];
+	for(size_t e=0;e<3;e++) {
+	  long nb=tris[c].nb[e];
+	  if (nb>=0 && cav_mark[nb]==1) {
+	    cav_mark[nb]=2;
+	    cav.push_back(nb);
+	  }
+	}
+      }
+      for(size_t k=0;k<old_cav.size();k++) {
+	cav_mark[old_cav[k]]=(cav_mark[old_cav[k]]==2) ? 1 : 0;
+      }
+    }
+  }
+
+  // Collect the boundary edges of the cavity, as the two vertices
+  // and the triangle outside the cavity
+  std::vector<size_t> bnd_a, bnd_b;
+  std::vector<long> bnd_out;
+  for(size_t k=0;k<cav.size();k++) {
+    size_t c=cav[k];
+    for(size_t e=0;e<3;e++) {
+      long nb=tris[c].nb[e];
+      if (nb<0 || cav_mark[nb]==0) {
+	bnd_a.push_back(tris[c].v[(e+1)%3]);
+	bnd_b.push_back(tris[c].v[(e+2)%3]);
+	bnd_out.push_back(nb);
+      }
+    }
+  }
+
+  // Remove the cavity
+  for(size_t k=0;k<cav.size();k++) {
+    cav_mark[cav[k]]=0;
+    tris[cav[k]].alive=false;
+    free_tris.push_back(cav[k]);
+  }
+
+  // Connect the new point to each boundary edge
+  size_t nb_new=bnd_a.size();
+  std::vector<size_t> new_tris(nb_new);
+  for(size_t k=0;k<nb_new;k++) {
+    size_t a=bnd_a[k], b=bnd_b[k];
+    size_t nt=new_triangle(a,b,p);
+    new_tris[k]=nt;
+    long out=bnd_out[k];
+    tris[nt].nb[2]=out;
+    if (out>=0) {
+      triangle &to=tris[out];
+      for(size_t e=0;e<3;e++) {
+	if (to.v[(e+1)%3]==b && to.v[(e+2)%3]==a) to.nb[e]=nt;
+      }
+    }
+  }
+  for(size_t k=0;k<nb_new;k++) {
+    for(size_t m=0;m<nb_new;m++) {
+      if (bnd_a[m]==bnd_b[k]) tris[new_tris[k]].nb[0]=new_tris[m];
+      if (bnd_b[m]==bnd_a[k]) tris[new_tris[k]].nb[1]=new_tris[m];
+    }
+  }
+
+  if (nb_new>0) last=new_tris[0];
+
+  return;
+}
+
+void interp2_delaunay::build(const interp2_grid_index &gi) {
+
+  np=gi.size();
+  tris.clear();
+  free_tris.clear();
+  cav_mark.clear();
+  vert_tri.assign(np+3,-1);
+  last=-1;
+  if (np<3) return;
+
+  vx.resize(np+3);
+  vy.resize(np+3);
+  double minx=gi.scaled_x(0), maxx=minx;
+  double miny=gi.scaled_y(0), maxy=miny;
+  for(size_t i=0;i<np;i++) {
+    vx[i]=gi.scaled_x(i);
+    vy[i]=gi.scaled_y(i);
+    if (vx[i]<minx) minx=vx[i];
+    if (vx[i]>maxx) maxx=vx[i];
+    if (vy[i]<miny) miny=vy[i];
+    if (vy[i]>maxy) maxy=vy[i];
+  }
+
+  // Add a super-triangle which contains all of the points
+  double len=std::max(maxx-minx,maxy-miny);
+  if (len<=0.0) len=1.0;
+  double cx=(minx+maxx)/2.0, cy=(miny+maxy)/2.0;
+  vx[np]=cx-20.0*len;
+  vy[np]=cy-10.0*len;
+  vx[np+1]=cx+20.0*len;
+  vy[np+1]=cy-10.0*len;
+  vx[np+2]=cx;
+  vy[np+2]=cy+20.0*len;
+  last=new_triangle(np,np+1,np+2);
+
+  // Insert the points in an order which keeps the walks short
+  std::vector<size_t> order;
+  gi.local_order(order);
+  for(size_t i=0;i<order.size();i++) {
+    insert(order[i]);
+  }
+
+  // Record a triangle for each vertex to start the walks in
+  // find_triangle()
+  for(size_t i=0;i<tris.size();i++) {
+    if (tris[i].alive) {
+      for(size_t j=0;j<3;j++) vert_tri[tris[i].v[j]]=i;
+    }
+  }
+
+  return;
+}
+
+bool interp2_delaunay::find_triangle(double x, double y,
+				     const interp2_grid_index &gi,
+				     size_t &i1, size_t &i2,
+				     size_t &i3) const {
+  if (tris.size()==0) return false;
+
+  // Start from a triangle which contains the closest data point
+  size_t ic;
+  double d2;
+  gi.nearest(x,y,1,&ic,&d2);
+  long start=vert_tri[ic];
+  if (start<0) start=last;
+
+  long t=locate(start,x/gi.x_scale(),y/gi.y_scale());
+  if (t<0) return false;
+
+  const triangle &tr=tris[t];
+  if (tr.v[0]>=np || tr.v[1]>=np || tr.v[2]>=np) return false;
+  i1=tr.v[0];
+  i2=tr.v[1];
+  i3=tr.v[2];
+
+  return true;
+}
+
+size_t interp2_delaunay::n_triangles() const {
+  size_t cnt=0;
+  for(size_t i=0;i<tris.size();i++) {
+    if (tris[i].alive && tris[i].v[0]<np && tris[i].v[1]<np &&
+	tris[i].v[2]<np) cnt++;
+  }
+  return cnt;
+}
@@ -0,0 +1,261 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2006-2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#ifndef O2SCL_INTERP2_INDEX_H
+#define O2SCL_INTERP2_INDEX_H
+
+/** \file interp2_index.h
+    \brief File defining \ref o2scl::interp2_grid_index and
+    \ref o2scl::interp2_delaunay
+*/
+
+#include <vector>
+
+#include <o2scl/err_hnd.h>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief A uniform grid of buckets for nearest-neighbor
+      searches among scattered points in two dimensions
+
+      The points are sorted into a grid of rectangular cells with
+      about two points per cell in the coordinates \f$ x/\Delta x
+      \f$ and \f$ y/\Delta y \f$. The \ref nearest() function
+      searches rings of cells around the query point and stops as
+      soon as no unsearched cell can contain a closer point, so the
+      expected cost of a query is \f$ {\cal O}(1) \f$ for points
+      which are not strongly clustered.
+
+      Distances are computed in the same way as in \ref
+      o2scl::interp2_neigh and \ref o2scl::interp2_planar and ties
+      are broken in favor of the point with the smaller index, so
+      the results are the same as those of an exhaustive search.
+
+      This class stores a copy of the point coordinates.
+  */
+  class interp2_grid_index {
+
+  public:
+
+    interp2_grid_index();
+
+    /** \brief Set the points and scales and build the grid
+     */
+    template<class vec_t>
+      void set_points(size_t n, const vec_t &x, const vec_t &y,
+		      double dx, double dy) {
+      np=n;
+      px.resize(n);
+      py.resize(n);
+      for(size_t i=0;i<n;i++) {
+	px[i]=x[i];
+	py[i]=y[i];
+      }
+      sdx=dx;
+      sdy=dy;
+      build();
+      return;
+    }
+
+    /** \brief Find the \c k closest points to \c (x,y)
+
+	The indices of the closest points are stored in \c ind and
+	their squared scaled distances in \c dist2, both in order of
+	increasing distance. The arrays must have space for at least
+	\c k elements. The return value is the number of points found,
+	which is the smaller of \c k and the number of points.
+    */
+    size_t nearest(double x, double y, size_t k, size_t *ind,
+		   double *dist2) const;
+
+    /// The number of points
+    size_t size() const {
+      return np;
+    }
+
+    /// The scale \f$ \Delta x \f$
+    double x_scale() const {
+      return sdx;
+    }
+
+    /// The scale \f$ \Delta y \f$
+    double y_scale() const {
+      return sdy;
+    }
+
+    /// The \f$ x/\Delta x \f$ coordinate of point \c i
+    double scaled_x(size_t i) const {
+      return px[i]/sdx;
+    }
+
+    /// The \f$ y/\Delta y \f$ coordinate of point \c i
+    double scaled_y(size_t i) const {
+      return py[i]/sdy;
+    }
+
+    /** \brief Return the points in an order in which consecutive
+	points are close to each other
+    */
+    void local_order(std::vector<size_t> &order) const;
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// Sort the points into the grid
+    void build();
+
+    /// The number of points
+    size_t np;
+    /// The x coordinates
+    std::vector<double> px;
+    /// The y coordinates
+    std::vector<double> py;
+    /// The x scale
+    double sdx;
+    /// The y scale
+    double sdy;
+    /// The smallest scaled x coordinate
+    double gx0;
+    /// The smallest scaled y coordinate
+    double gy0;
+    /// The cell width in scaled x
+    double gw;
+    /// The cell height in scaled y
+    double gh;
+    /// The number of cells in the x direction
+    size_t gnx;
+    /// The number of cells in the y direction
+    size_t gny;
+    /// The index of the first point in each cell in \ref cell_pts
+    std::vector<size_t> cell_start;
+    /// The point indices sorted by cell
+    std::vector<size_t> cell_pts;
+
+#endif
+
+  };
+
+  /** \brief Delaunay triangulation of scattered points in two
+      dimensions
+
+      The triangulation is constructed in the scaled coordinates
+      provided by \ref interp2_grid_index with the Bowyer-Watson
+      algorithm. The points are inserted in the order given by \ref
+      interp2_grid_index::local_order() so that each insertion is
+      located with a short walk from the previous one. Duplicate
+      points are ignored.
+
+      Triangles are located with a visibility walk starting from
+      a triangle which contains the nearest data point, so the
+      expected cost of \ref find_triangle() is \f$ {\cal O}(1) \f$.
+  */
+  class interp2_delaunay {
+
+  public:
+
+    interp2_delaunay();
+
+    /** \brief Construct the triangulation of the points in \c gi
+     */
+    void build(const interp2_grid_index &gi);
+
+    /** \brief Find the triangle which contains \c (x,y)
+
+	The object \c gi must be the one given to \ref build(). If
+	the point is inside the convex hull of the data, this
+	function stores the indices of the vertices in \c i1, \c i2,
+	and \c i3 and returns true. Otherwise it returns false.
+    */
+    bool find_triangle(double x, double y, const interp2_grid_index &gi,
+		       size_t &i1, size_t &i2, size_t &i3) const;
+
+    /// The number of triangles in the triangulation
+    size_t n_triangles() const;
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /** \brief A triangle with vertices in counter-clockwise order
+
+	The neighbor \c nb[i] shares the edge opposite vertex \c v[i],
+	or is -1 if there is no neighbor.
+    */
+    struct triangle {
+      /// The vertices
+      size_t v[3];
+      /// The neighbors
+      long nb[3];
+      /// True if the triangle is part of the triangulation
+      bool alive;
+    };
+
+    /// The number of data points (the super-triangle follows)
+    size_t np;
+    /// The scaled x coordinates, including the super-triangle
+    std::vector<double> vx;
+    /// The scaled y coordinates, including the super-triangle
+    std::vector<double> vy;
+    /// The triangles
+    std::vector<triangle> tris;
+    /// Unused entries in \ref tris
+    std::vector<size_t> free_tris;
+    /// A triangle containing each vertex, or -1
+    std::vector<long> vert_tri;
+    /// The triangle from which the next walk starts during construction
+    long last;
+    /// The triangles in the cavity during an insertion
+    std::vector<size_t> cav;
+    /// Flags for the triangles in the cavity
+    std::vector<char> cav_mark;
+
+    /// Orientation of \c c relative to the line from \c a to \c b
+    double orient(size_t a, size_t b, double cx, double cy) const {
+      return (vx[b]-vx[a])*(cy-vy[a])-(vy[b]-vy[a])*(cx-vx[a]);
+    }
+
+    /// True if \c (x,y) is inside the circumcircle of triangle \c t
+    bool in_circle(const triangle &t, double x, double y) const;
+
+    /** \brief Walk from triangle \c start to the triangle containing
+	\c (x,y), returning -1 if the walk leaves the triangulation
+    */
+    long locate(long start, double x, double y) const;
+
+    /// Insert vertex \c p
+    void insert(size_t p);
+
+    /// Add a new triangle and return its index
+    size_t new_triangle(size_t a, size_t b, size_t c);
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
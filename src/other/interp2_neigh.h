@@ -32,6 +32,7 @@
 #include <cmath>
 
 #include <o2scl/err_hnd.h>
+#include <o2scl/interp2_index.h>
 
 #ifndef DOXYGEN_NO_O2NS
 namespace o2scl {
@@ -56,14 +57,16 @@ namespace o2scl {
 
       This class stores pointers to the data, not a copy. The data can
       be changed between interpolations without an additional call to
-      \ref set_data(), but the scales may need to be recomputed with
-      \ref compute_scale().
+      \ref set_data(), but then \ref compute_scale() must be called
+      to recompute the scales and rebuild the search index.
 
       The vector type can be any type with a suitably defined \c
       operator[].
       
-      \note This class operates by performing a \f$ {\cal O}(N) \f$
-      brute-force search to find the closest points. 
+      The closest point is found with an \ref interp2_grid_index
+      built in \ref set_data(), so each evaluation has an expected
+      cost of \f$ {\cal O}(1) \f$ and gives the same result as an
+      exhaustive search.
 
       \future Make a parent class for this and \ref o2scl::interp2_planar.
 
@@ -127,6 +130,9 @@ namespace o2scl {
 	O2SCL_ERR("No scale in interp2_planar::set_data().",exc_einval);
       }
 
+      // Build the search index
+      index.set_points(np,*ux,*uy,dx,dy);
+
       return;
     }
 
@@ -173,6 +179,24 @@ namespace o2scl {
       return eval(v[0],v[1]);
     }
 
+    /** \brief Perform the interpolation for the \c n points in \c x
+	and \c y, storing the results in \c f
+
+	If \c O2SCL_OPENMP is defined, the points are divided between
+	threads.
+    */
+    template<class vec2_t, class vec3_t>
+      void eval_many(size_t n, const vec2_t &x, const vec2_t &y,
+		     vec3_t &f) const {
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(size_t i=0;i<n;i++) {
+	f[i]=eval(x[i],y[i]);
+      }
+      return;
+    }
+
     /** \brief Interpolation returning the closest point 
 
 	This function interpolates \c x and \c y into the data
@@ -187,16 +211,9 @@ namespace o2scl {
 		  exc_einval);
       }
 
-      // Exhaustively search the data
-      i1=0;
-      double dist_min=pow((x-(*ux)[i1])/dx,2.0)+pow((y-(*uy)[i1])/dy,2.0);
-      for(size_t index=1;index<np;index++) {
-	double dist=pow((x-(*ux)[index])/dx,2.0)+pow((y-(*uy)[index])/dy,2.0);
-	if (dist<dist_min) {
-	  i1=index;
-	  dist_min=dist;
-	}
-      }
+      // Find the closest point
+      double dist_min;
+      index.nearest(x,y,1,&i1,&dist_min);
 
       // Return the function value
 
@@ -219,6 +236,8 @@ namespace o2scl {
     vec_t *uf;
     /// True if the data has been specified
     bool data_set;
+    /// The index for finding the closest point
+    interp2_grid_index index;
     
 #endif
 
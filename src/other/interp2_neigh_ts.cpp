@@ -24,6 +24,7 @@
 
 #include <o2scl/test_mgr.h>
 #include <o2scl/interp2_neigh.h>
+#include <o2scl/vector.h>
 
 using namespace std;
 using namespace o2scl;
@@ -58,6 +59,44 @@ int main(void) {
   cout << in.eval(0.4,0.5) << endl;
   cout << in.eval(0.03,1.0) << endl;
 
+  // Compare the indexed search with an exhaustive search
+  {
+    size_t n=2000;
+    ubvector x2(n), y2(n), f2(n);
+    for(size_t i=0;i<n;i++) {
+      x2[i]=sin(((double)i)*1.1)*cos(((double)i)*0.37);
+      y2[i]=2.0*cos(((double)i)*2.3);
+      f2[i]=((double)i);
+    }
+    interp2_neigh<ubvector> in2;
+    in2.set_data(n,x2,y2,f2);
+
+    size_t nq=200;
+    ubvector xq(nq), yq(nq), fq(nq);
+    for(size_t k=0;k<nq;k++) {
+      xq[k]=1.5*sin(((double)k)*0.71);
+      yq[k]=3.0*cos(((double)k)*1.3);
+    }
+    in2.eval_many(nq,xq,yq,fq);
+    
+    double dx2=vector_max_value<ubvector,double>(n,x2)-
+      vector_min_value<ubvector,double>(n,x2);
+    double dy2=vector_max_value<ubvector,double>(n,y2)-
+      vector_min_value<ubvector,double>(n,y2);
+    for(size_t k=0;k<nq;k++) {
+      size_t i1=0;
+      double dmin=pow((xq[k]-x2[0])/dx2,2.0)+pow((yq[k]-y2[0])/dy2,2.0);
+      for(size_t i=1;i<n;i++) {
+	double d=pow((xq[k]-x2[i])/dx2,2.0)+pow((yq[k]-y2[i])/dy2,2.0);
+	if (d<dmin) {
+	  dmin=d;
+	  i1=i;
+	}
+      }
+      t.test_rel(fq[k],f2[i1],1.0e-15,"index vs. exhaustive");
+    }
+  }
+
   t.report();
   return 0;
 }
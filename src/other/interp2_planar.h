@@ -35,6 +35,7 @@
 
 #include <o2scl/err_hnd.h>
 #include <o2scl/vector.h>
+#include <o2scl/interp2_index.h>
 
 #ifndef DOXYGEN_NO_O2NS
 namespace o2scl {
@@ -72,8 +73,9 @@ namespace o2scl {
 
       This class stores pointers to the data, not a copy. The
       data can be changed between interpolations without an
-      additional call to \ref set_data(), but the scales may
-      need to be recomputed with \ref compute_scale().
+      additional call to \ref set_data(), but then \ref
+      compute_scale() must be called to recompute the scales and
+      rebuild the search index.
 
       The vector type can be any type with a suitably defined \c
       operator[].
@@ -82,12 +84,22 @@ namespace o2scl {
       \ref set_data() will call the error handler if the
       first argument is less than three.
       
-      \note This class operates by performing a \f$ {\cal O}(N) \f$
-      brute-force search to find the three closest points. If the
-      three closest points are colinear, then the data are sorted
-      by distance [ \f$ {\cal O}(N \log N) \f$ ], and the closest
+      The three closest points are found with an \ref
+      interp2_grid_index built in \ref set_data(), so each
+      evaluation has an expected cost of \f$ {\cal O}(1) \f$ and
+      gives the same result as an exhaustive search. If the three
+      closest points are colinear, then the data are sorted by
+      distance [ \f$ {\cal O}(N \log N) \f$ ], and the closest
       triplets are enumerated until a non-colinear triplet is found.
 
+      If \ref use_delaunay is true when \ref set_data() is called,
+      then a Delaunay triangulation of the data (in the scaled
+      coordinates) is also constructed, and points inside the convex
+      hull of the data are interpolated with the plane through the
+      vertices of the triangle which contains them. This gives an
+      interpolation which is continuous. Points outside the convex
+      hull use the three closest points as above.
+
       \future Make a parent class for this and \ref o2scl::interp2_neigh.
   */
   template<class vec_t> class interp2_planar {
@@ -112,8 +124,16 @@ namespace o2scl {
       y_scale=-1.0;
       dx=0.0;
       dy=0.0;
+      use_delaunay=false;
     }
 
+    /** \brief If true, interpolate using a Delaunay triangulation
+	(default false)
+
+	This must be set before calling \ref set_data().
+    */
+    bool use_delaunay;
+
     /// Threshold for colinearity (default \f$ 10^{-12} \f$)
     double thresh;
 
@@ -169,6 +189,12 @@ namespace o2scl {
 	O2SCL_ERR("No scale in interp2_planar::set_data().",exc_einval);
       }
 
+      // Build the search index
+      index.set_points(np,*ux,*uy,dx,dy);
+      if (use_delaunay) {
+	tri.build(index);
+      }
+
       return;
     }
     
@@ -194,11 +220,32 @@ namespace o2scl {
       return eval(v[0],v[1]);
     }
 
+    /** \brief Perform the planar interpolation for the \c n points
+	in \c x and \c y, storing the results in \c f
+
+	If \c O2SCL_OPENMP is defined, the points are divided between
+	threads.
+    */
+    template<class vec2_t, class vec3_t>
+      void eval_many(size_t n, const vec2_t &x, const vec2_t &y,
+		     vec3_t &f) const {
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for
+#endif
+      for(size_t i=0;i<n;i++) {
+	f[i]=eval(x[i],y[i]);
+      }
+      return;
+    }
+
     /** \brief Planar interpolation returning the closest points 
 
 	This function interpolates \c x and \c y into the data
 	returning \c f. It also returns the three closest x- and
-	y-values used for computing the plane.
+	y-values used for computing the plane (or, if \ref
+	use_delaunay is true and the point is inside the
+	triangulation, the vertices of the triangle which contains
+	the point).
     */
     void eval_points(double x, double y, double &f,
 		     size_t &i1, double &x1, double &y1, 
@@ -210,54 +257,19 @@ namespace o2scl {
 		  exc_einval);
       }
 
-      // First, we just find the three closest points by
-      // exhaustively searching the data
-      
-      // Put in initial points
-      i1=0; i2=1; i3=2;
-      double c1=sqrt(pow((x-(*ux)[0])/dx,2.0)+pow((y-(*uy)[0])/dy,2.0));
-      double c2=sqrt(pow((x-(*ux)[1])/dx,2.0)+pow((y-(*uy)[1])/dy,2.0));
-      double c3=sqrt(pow((x-(*ux)[2])/dx,2.0)+pow((y-(*uy)[2])/dy,2.0));
-
-      // Sort initial points
-      if (c2<c1) {
-	if (c3<c2) {
-	  // 321
-	  swap(i1,c1,i3,c3);
-	} else if (c3<c1) {
-	  // 231
-	  swap(i1,c1,i2,c2);
-	  swap(i2,c2,i3,c3);
-	} else {
-	  // 213
-	  swap(i1,c1,i2,c2);
-	}
-      } else {
-	if (c3<c1) {
-	  // 312
-	  swap(i1,c1,i3,c3);
-	  swap(i2,c2,i3,c3);
-	} else if (c3<c2) {
-	  // 132
-	  swap(i3,c3,i2,c2);
-	}
-	// 123
+      bool found=false;
+      if (use_delaunay) {
+	found=tri.find_triangle(x,y,index,i1,i2,i3);
       }
 
-      // Go through remaining points and sort accordingly
-      for(size_t j=3;j<np;j++) {
-	size_t i4=j;
-	double c4=sqrt(pow((x-(*ux)[i4])/dx,2.0)+pow((y-(*uy)[i4])/dy,2.0));
-	if (c4<c1) {
-	  swap(i4,c4,i3,c3);
-	  swap(i3,c3,i2,c2);
-	  swap(i2,c2,i1,c1);
-	} else if (c4<c2) {
-	  swap(i4,c4,i3,c3);
-	  swap(i3,c3,i2,c2);
-	} else if (c4<c3) {
-	  swap(i4,c4,i3,c3);
-	}
+      if (found==false) {
+	// Find the three closest points
+	size_t ind[3];
+	double dist2[3];
+	index.nearest(x,y,3,ind,dist2);
+	i1=ind[0];
+	i2=ind[1];
+	i3=ind[2];
       }
 
       // Solve for denominator:
@@ -354,20 +366,10 @@ namespace o2scl {
     vec_t *uf;
     /// True if the data has been specified
     bool data_set;
-    
-    /// Swap points 1 and 2.
-    int swap(size_t &index_1, double &dist_1, size_t &index_2, 
-	     double &dist_2) const {
-
-      size_t index_temp;
-      double dist_temp;
-      
-      index_temp=index_1; dist_temp=dist_1;
-      index_1=index_2; dist_1=dist_2;
-      index_2=index_temp; dist_2=dist_temp;
-      
-      return 0;
-    }
+    /// The index for finding the closest points
+    interp2_grid_index index;
+    /// The Delaunay triangulation
+    interp2_delaunay tri;
     
   private:
     
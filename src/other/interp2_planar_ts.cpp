@@ -29,6 +29,7 @@ using namespace std;
 using namespace o2scl;
 
 typedef boost::numeric::ublas::vector<double> ubvector;
+typedef boost::numeric::ublas::vector<size_t> ubvector_size_t;
 
 int main(void) {
   test_mgr t;
@@ -58,6 +59,62 @@ int main(void) {
   cout << ip.eval(0.4,0.5) << endl;
   cout << ip.eval(0.03,1.0) << endl;
 
+  // Compare the indexed search with an exhaustive search and test
+  // the Delaunay triangulation with a linear function
+  {
+    size_t n=2000;
+    ubvector x2(n), y2(n), f2(n);
+    for(size_t i=0;i<n;i++) {
+      x2[i]=sin(((double)i)*1.1)*cos(((double)i)*0.37);
+      y2[i]=2.0*cos(((double)i)*2.3);
+      f2[i]=1.0+2.0*x2[i]-3.0*y2[i];
+    }
+    
+    interp2_planar<ubvector> ip2;
+    ip2.set_data(n,x2,y2,f2);
+    interp2_planar<ubvector> ip3;
+    ip3.use_delaunay=true;
+    ip3.set_data(n,x2,y2,f2);
+
+    size_t nq=100;
+    ubvector xq(nq), yq(nq), fq(nq);
+    for(size_t k=0;k<nq;k++) {
+      xq[k]=0.6*sin(((double)k)*0.71);
+      yq[k]=1.2*cos(((double)k)*1.3);
+    }
+    ip3.eval_many(nq,xq,yq,fq);
+    
+    for(size_t k=0;k<nq;k++) {
+      double f, x1, y1, x2p, y2p, x3, y3;
+      size_t i1, i2, i3;
+      ip2.eval_points(xq[k],yq[k],f,i1,x1,y1,i2,x2p,y2p,i3,x3,y3);
+
+      // Find the three closest points directly
+      ubvector dist(n);
+      ubvector_size_t order(n);
+      double dx2=vector_max_value<ubvector,double>(n,x2)-
+	vector_min_value<ubvector,double>(n,x2);
+      double dy2=vector_max_value<ubvector,double>(n,y2)-
+	vector_min_value<ubvector,double>(n,y2);
+      for(size_t i=0;i<n;i++) {
+	dist[i]=pow((xq[k]-x2[i])/dx2,2.0)+pow((yq[k]-y2[i])/dy2,2.0);
+      }
+      vector_sort_index(n,dist,order);
+      t.test_gen(i1==order[0] && i2==order[1] && i3==order[2],
+		 "index vs. exhaustive");
+
+      // The triangle should contain the point and reproduce the
+      // linear function
+      ip3.eval_points(xq[k],yq[k],f,i1,x1,y1,i2,x2p,y2p,i3,x3,y3);
+      double a1=(x2p-x1)*(yq[k]-y1)-(y2p-y1)*(xq[k]-x1);
+      double a2=(x3-x2p)*(yq[k]-y2p)-(y3-y2p)*(xq[k]-x2p);
+      double a3=(x1-x3)*(yq[k]-y3)-(y1-y3)*(xq[k]-x3);
+      t.test_gen((a1>=0.0 && a2>=0.0 && a3>=0.0) ||
+		 (a1<=0.0 && a2<=0.0 && a3<=0.0),"delaunay inside");
+      t.test_rel(fq[k],1.0+2.0*xq[k]-3.0*yq[k],1.0e-10,"delaunay linear");
+    }
+  }
+
   t.report();
   return 0;
 }
@@ -20,7 +20,10 @@
 
   -------------------------------------------------------------------
 */
+#include <cmath>
+
 #include <o2scl/pinside.h>
+#include <o2scl/contour.h>
 
 using namespace std;
 using namespace o2scl;
@@ -226,3 +229,163 @@ int pinside::test(test_mgr &t) {
 
   return success;
 }
+
+pinside_prepared::pinside_prepared() {
+  n_bands=0;
+  clear();
+}
+
+void pinside_prepared::clear() {
+  ex1.clear();
+  ey1.clear();
+  ex2.clear();
+  ey2.clear();
+  xlo=0.0;
+  xhi=0.0;
+  ylo=0.0;
+  yhi=0.0;
+  nb=0;
+  band_h=0.0;
+  band_start.clear();
+  b_ylo.clear();
+  b_yhi.clear();
+  b_x.clear();
+  b_slope.clear();
+  return;
+}
+
+void pinside_prepared::add_edge(double x1, double y1, double x2,
+				double y2) {
+  // Horizontal edges never cross a horizontal ray
+  if (y1==y2) return;
+  ex1.push_back(x1);
+  ey1.push_back(y1);
+  ex2.push_back(x2);
+  ey2.push_back(y2);
+  return;
+}
+
+void pinside_prepared::add_contour_lines
+(const std::vector<contour_line> &clines) {
+  for(size_t i=0;i<clines.size();i++) {
+    const contour_line &cl=clines[i];
+    size_t n=cl.x.size();
+    for(size_t j=0;j<n;j++) {
+      size_t k=(j+1)%n;
+      add_edge(cl.x[j],cl.y[j],cl.x[k],cl.y[k]);
+    }
+  }
+  build();
+  return;
+}
+
+void pinside_prepared::add_contour_lines
+(const std::vector<contour_line> &clines, double level) {
+  // Find the closest level, since contour may have adjusted the
+  // levels slightly
+  std::vector<contour_line> sel;
+  if (clines.size()==0) return;
+  double best=clines[0].level;
+  for(size_t i=1;i<clines.size();i++) {
+    if (fabs(clines[i].level-level)<fabs(best-level)) {
+      best=clines[i].level;
+    }
+  }
+  for(size_t i=0;i<clines.size();i++) {
+    if (clines[i].level==best) sel.push_back(clines[i]);
+  }
+  add_contour_lines(sel);
+  return;
+}
+
+void pinside_prepared::build() {
+
+  size_t ne=ex1.size();
+  nb=0;
+  band_start.clear();
+  b_ylo.clear();
+  b_yhi.clear();
+  b_x.clear();
+  b_slope.clear();
+  if (ne==0) return;
+
+  // The bounding box
+  xlo=ex1[0];
+  xhi=ex1[0];
+  ylo=ey1[0];
+  yhi=ey1[0];
+  for(size_t i=0;i<ne;i++) {
+    if (ex1[i]<xlo) xlo=ex1[i];
+    if (ex2[i]<xlo) xlo=ex2[i];
+    if (ex1[i]>xhi) xhi=ex1[i];
+    if (ex2[i]>xhi) xhi=ex2[i];
+    if (ey1[i]<ylo) ylo=ey1[i];
+    if (ey2[i]<ylo) ylo=ey2[i];
+    if (ey1[i]>yhi) yhi=ey1[i];
+    if (ey2[i]>yhi) yhi=ey2[i];
+  }
+
+  nb=n_bands;
+  if (nb==0) {
+    nb=ne;
+    if (nb>65536) nb=65536;
+  }
+  band_h=(yhi-ylo)/((double)nb);
+
+  // Count the edges in each band, then fill the bands
+  std::vector<size_t> count(nb+1,0);
+  for(size_t pass=0;pass<2;pass++) {
+    if (pass==1) {
+      band_start.resize(nb+1);
+      band_start[0]=0;
+      for(size_t k=0;k<nb;k++) {
+	band_start[k+1]=band_start[k]+count[k];
+	count[k]=band_start[k];
+      }
+      size_t nt=band_start[nb];
+      b_ylo.resize(nt);
+      b_yhi.resize(nt);
+      b_x.resize(nt);
+      b_slope.resize(nt);
+    }
+    for(size_t i=0;i<ne;i++) {
+      double y_lo=ey1[i], y_hi=ey2[i], x_lo=ex1[i], x_hi=ex2[i];
+      if (y_lo>y_hi) {
+	std::swap(y_lo,y_hi);
+	std::swap(x_lo,x_hi);
+      }
+      size_t k1=band(y_lo), k2=band(y_hi);
+      for(size_t k=k1;k<=k2;k++) {
+	if (pass==0) {
+	  count[k]++;
+	} else {
+	  size_t m=count[k]++;
+	  b_ylo[m]=y_lo;
+	  b_yhi[m]=y_hi;
+	  b_x[m]=x_lo;
+	  b_slope[m]=(x_hi-x_lo)/(y_hi-y_lo);
+	}
+      }
+    }
+  }
+
+  return;
+}
+
+int pinside_prepared::inside(double x, double y) const {
+
+  // Points outside the bounding box (or NaN) are never inside
+  if (nb==0 || !(y>=ylo && y<=yhi && x<=xhi)) return 0;
+
+  size_t k=band(y);
+  size_t kend=band_start[k+1];
+
+  // Count the crossings without branching
+  int c=0;
+  for(size_t m=band_start[k];m<kend;m++) {
+    c^=(y>=b_ylo[m]) & (y<b_yhi[m]) &
+      (x<b_x[m]+(y-b_ylo[m])*b_slope[m]);
+  }
+  
+  return c;
+}
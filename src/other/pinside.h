@@ -24,9 +24,12 @@
 #define O2SCL_PINSIDE_H
 
 /** \file pinside.h
-    \brief File defining \ref o2scl::pinside 
+    \brief File defining \ref o2scl::pinside and
+    \ref o2scl::pinside_prepared
 */
 
+#include <vector>
+
 #include <boost/numeric/ublas/vector.hpp>
 
 #include <o2scl/test_mgr.h>
@@ -186,6 +189,175 @@ namespace o2scl {
 
   };
 
+  class contour_line;
+
+  /** \brief Point inside a set of polygons for many points
+
+      This class stores the edges of one or more polygons and
+      determines if points are inside them. Polygons are added with
+      \ref add_polygon() or directly from the lines computed by \ref
+      o2scl::contour with \ref add_contour_lines(). Each polygon is
+      closed automatically, so the last point need not be equal to
+      the first. A point is inside if a ray from the point in the \f$
+      +x \f$ direction crosses the edges of all of the polygons an
+      odd number of times, so polygons nested inside other polygons
+      are holes, and polygons nested inside holes are again inside.
+      For a single polygon, this gives the same result as \ref
+      pinside::inside() except for points exactly on an edge, for
+      which neither is well-defined.
+
+      When the polygons are added, the bounding box is computed and
+      the edges are sorted into \ref n_bands horizontal bands of
+      equal height, so that each point is only compared to the edges
+      which overlap its band. The edges for each band are stored
+      contiguously with precomputed slopes so that the inner loop has
+      no branches and can be vectorized by the compiler. For a
+      polygon with \f$ N \f$ edges, the cost of each test is about
+      \f$ {\cal O}(1) \f$ instead of \f$ {\cal O}(N) \f$.
+
+      The function \ref inside_many() tests several points and, if
+      \c O2SCL_OPENMP is defined, divides the points between threads.
+      The function \ref inside() does not modify the object and can
+      be called from several threads at once.
+  */
+  class pinside_prepared {
+
+  public:
+
+    pinside_prepared();
+
+    /** \brief The number of horizontal bands (default 0)
+
+	If this is zero, then the number of bands is set to the
+	number of edges, up to a maximum of \f$ 2^{16} \f$. Changes
+	take effect the next time a polygon is added.
+    */
+    size_t n_bands;
+
+    /// Remove all polygons
+    void clear();
+
+    /** \brief Add the polygon with \c n vertices given in
+	\c xa and \c ya
+    */
+    template<class vec_t>
+      void add_polygon(size_t n, const vec_t &xa, const vec_t &ya) {
+      for(size_t i=0;i<n;i++) {
+	size_t j=(i+1)%n;
+	add_edge(xa[i],ya[i],xa[j],ya[j]);
+      }
+      build();
+      return;
+    }
+
+    /** \brief Remove all polygons and then add the polygon with
+	\c n vertices given in \c xa and \c ya
+    */
+    template<class vec_t>
+      void set_polygon(size_t n, const vec_t &xa, const vec_t &ya) {
+      clear();
+      add_polygon(n,xa,ya);
+      return;
+    }
+
+    /** \brief Add each of the lines in \c clines as a polygon
+
+	Typically, these are the lines at one contour level
+	obtained from \ref o2scl::contour::get_contour_lines().
+	Lines which end at the edge of the data are closed
+	with a straight line.
+    */
+    void add_contour_lines(const std::vector<contour_line> &clines);
+
+    /** \brief Add the lines in \c clines with the contour level
+	closest to \c level as polygons
+
+	The closest level is used because \ref o2scl::contour may
+	adjust the levels slightly (see \ref contour::lev_adjust).
+    */
+    void add_contour_lines(const std::vector<contour_line> &clines,
+			   double level);
+
+    /** \brief Return 1 if the point \c (x,y) is inside, and 0
+	otherwise
+    */
+    int inside(double x, double y) const;
+
+    /** \brief Determine if the \c n points given in \c x and \c y
+	are inside, storing 1 or 0 in \c res
+    */
+    template<class vec_t, class vec2_t>
+      void inside_many(size_t n, const vec_t &x, const vec_t &y,
+		       vec2_t &res) const {
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(size_t i=0;i<n;i++) {
+	res[i]=inside(x[i],y[i]);
+      }
+      return;
+    }
+
+    /// Return the number of edges
+    size_t n_edges() const {
+      return ex1.size();
+    }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+    /// Add the edge from \c (x1,y1) to \c (x2,y2)
+    void add_edge(double x1, double y1, double x2, double y2);
+
+    /// Sort the edges into bands
+    void build();
+
+    /// Return the band containing \c y
+    size_t band(double y) const {
+      if (!(band_h>0.0)) return 0;
+      double r=(y-ylo)/band_h;
+      if (!(r>0.0)) return 0;
+      if (r>=((double)nb)) return nb-1;
+      return (size_t)r;
+    }
+
+    /// \name The edges (horizontal edges are not stored)
+    //@{
+    std::vector<double> ex1;
+    std::vector<double> ey1;
+    std::vector<double> ex2;
+    std::vector<double> ey2;
+    //@}
+
+    /// \name Bounding box
+    //@{
+    double xlo, xhi, ylo, yhi;
+    //@}
+
+    /// The number of bands in use
+    size_t nb;
+    /// The height of each band
+    double band_h;
+    /// The index of the first edge of each band in the arrays below
+    std::vector<size_t> band_start;
+
+    /// \name The edges sorted by band
+    //@{
+    /// The smaller y coordinate
+    std::vector<double> b_ylo;
+    /// The larger y coordinate
+    std::vector<double> b_yhi;
+    /// The x coordinate at \ref b_ylo
+    std::vector<double> b_x;
+    /// The inverse slope \f$ dx/dy \f$
+    std::vector<double> b_slope;
+    //@}
+
+#endif
+
+  };
+
 #ifndef DOXYGEN_NO_O2NS
 }
 #endif
@@ -23,11 +23,14 @@
 
 #include <iostream>
 #include <o2scl/pinside.h>
+#include <o2scl/contour.h>
+#include <o2scl/rng_gsl.h>
 
 using namespace std;
 using namespace o2scl;
 
 typedef boost::numeric::ublas::vector<double> ubvector;
+typedef boost::numeric::ublas::matrix<double> ubmatrix;
 
 int main(void) {
   test_mgr t;
@@ -63,6 +66,84 @@ int main(void) {
   }
   fout.close();
 
+  // Compare pinside_prepared with pinside for random points, 
+  // avoiding points which are too close to an edge
+
+  pinside_prepared pp;
+  pp.set_polygon(12,x,y);
+  t.test_gen(pp.n_edges()==6,"n_edges");
+
+  rng_gsl gr;
+  size_t nr=10000;
+  ubvector rx(nr), ry(nr);
+  std::vector<int> res(nr);
+  for(size_t i=0;i<nr;i++) {
+    rx[i]=4.0*gr.random()-0.5;
+    ry[i]=4.0*gr.random()-0.5;
+  }
+  pp.inside_many(nr,rx,ry,res);
+  size_t n_match=0, n_in=0;
+  for(size_t i=0;i<nr;i++) {
+    if (res[i]==pi.inside(rx[i],ry[i],x,y)) n_match++;
+    if (res[i]==pp.inside(rx[i],ry[i])) n_in++;
+  }
+  t.test_gen(n_match==nr,"prepared vs. pinside");
+  t.test_gen(n_in==nr,"inside_many vs. inside");
+
+  // A hole in the center of the plus sign
+  ubvector hx(4), hy(4);
+  hx[0]=1.25; hy[0]=1.25;
+  hx[1]=1.75; hy[1]=1.25;
+  hx[2]=1.75; hy[2]=1.75;
+  hx[3]=1.25; hy[3]=1.75;
+  pp.add_polygon(4,hx,hy);
+  t.test_gen(pp.inside(1.5,1.5)==0,"hole 1");
+  t.test_gen(pp.inside(1.1,1.5)==1,"hole 2");
+  t.test_gen(pp.inside(2.5,1.5)==1,"hole 3");
+  t.test_gen(pp.inside(0.5,0.5)==0,"hole 4");
+
+  // An annulus from the contour lines of (r-1)^2 at the level 1/4,
+  // which gives circles with radius 1/2 and 3/2
+  {
+    size_t ng=41;
+    ubvector gx(ng), gy(ng);
+    ubmatrix gd(ng,ng);
+    for(size_t i=0;i<ng;i++) {
+      gx[i]=-2.0+4.0*((double)i)/((double)(ng-1));
+      gy[i]=gx[i];
+    }
+    for(size_t i=0;i<ng;i++) {
+      for(size_t j=0;j<ng;j++) {
+	double r=sqrt(gx[i]*gx[i]+gy[j]*gy[j]);
+	gd(i,j)=(r-1.0)*(r-1.0);
+      }
+    }
+    contour co;
+    co.set_data(ng,ng,gx,gy,gd);
+    ubvector lev(1);
+    lev[0]=0.25;
+    co.set_levels(1,lev);
+    vector<contour_line> conts;
+    co.calc_contours(conts);
+    t.test_gen(conts.size()==2,"two contour lines");
+
+    pinside_prepared pc;
+    pc.add_contour_lines(conts,0.25);
+    size_t n_ok=0;
+    for(size_t i=0;i<nr;i++) {
+      double th=2.0*acos(-1.0)*gr.random();
+      double r=1.9*gr.random();
+      // Skip points near the circles
+      if (fabs(r-0.5)<0.05 || fabs(r-1.5)<0.05) {
+	n_ok++;
+      } else {
+	int exact=(r>0.5 && r<1.5);
+	if (pc.inside(r*cos(th),r*sin(th))==exact) n_ok++;
+      }
+    }
+    t.test_gen(n_ok==nr,"annulus");
+  }
+
   t.report();
   return 0;
 }
@@ -776,8 +776,16 @@ namespace o2scl {
 
   /// Standard normal
   o2scl::prob_dens_gaussian pdg;
+
+  /// Generator for the seeds used in \ref sample_many()
+  mutable o2scl::rng_gsl rs;
     
   public:
+
+  /** \brief The number of samples generated from each random
+      number stream in \ref sample_many() (default 256)
+  */
+  size_t block_size;
   
   /// The dimensionality
   virtual size_t dim() const {
@@ -787,14 +795,23 @@ namespace o2scl {
   /// Create an empty distribution
   prob_dens_mdim_gaussian() {
     ndim=0;
+    block_size=256;
   }
 
   /** \brief Create a distribution from the covariance matrix
    */
   prob_dens_mdim_gaussian(size_t p_ndim, vec_t &p_peak, mat_t &covar) {
+    block_size=256;
     set(p_ndim,p_peak,covar);
   }
 
+  /// Set the random number seed
+  void set_seed(unsigned long int s) {
+    pdg.set_seed(s);
+    rs.set_seed(s);
+    return;
+  }
+
   /** \brief Set the peak and covariance matrix for the distribution
    */
   void set(size_t p_ndim, vec_t &p_peak, mat_t &covar) {
@@ -951,6 +968,97 @@ namespace o2scl {
     return;
   }
 
+  /** \brief Sample the distribution \c n times, storing the 
+      results in the rows of \c x
+
+      The matrix \c x must have at least \c n rows and \ref dim()
+      columns. The samples are computed from the stored Cholesky
+      decomposition of the covariance matrix. Each block of
+      \ref block_size samples uses a separate random number
+      stream, seeded from an internal generator, so that the 
+      blocks can be computed in parallel with OpenMP and the 
+      result does not depend on the number of threads.
+  */
+  template<class mat2_t> void sample_many(size_t n, mat2_t &x) const {
+    if (ndim==0) {
+      O2SCL_ERR2("Distribution not set in prob_dens_mdim_gaussian::",
+		 "sample_many().",o2scl::exc_einval);
+    }
+    if (n==0) return;
+    size_t bs=block_size;
+    if (bs==0) bs=1;
+    size_t nblocks=(n+bs-1)/bs;
+
+    // Seeds for each block
+    std::vector<unsigned long int> seeds(nblocks);
+    for(size_t ib=0;ib<nblocks;ib++) {
+      seeds[ib]=rs.random_int(rs.max()-rs.min());
+    }
+    
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic) if (nblocks>1)
+#endif
+    for(size_t ib=0;ib<nblocks;ib++) {
+      o2scl::prob_dens_gaussian pdgb;
+      pdgb.set_seed(seeds[ib]);
+      std::vector<double> z(ndim);
+      size_t kmax=(ib+1)*bs;
+      if (kmax>n) kmax=n;
+      for(size_t k=ib*bs;k<kmax;k++) {
+	for(size_t i=0;i<ndim;i++) z[i]=pdgb();
+	// Compute the peak plus the lower triangular 
+	// matrix times the standard normals
+	for(size_t i=0;i<ndim;i++) {
+	  double sum=peak[i];
+	  for(size_t j=0;j<=i;j++) sum+=chol(i,j)*z[j];
+	  x(k,i)=sum;
+	}
+      }
+    }
+    
+    return;
+  }
+
+  /** \brief Compute the log of the normalized density for the
+      \c n points in the rows of \c x, storing the results in 
+      \c logp
+
+      This uses a forward substitution with the stored Cholesky 
+      decomposition rather than the inverse of the covariance 
+      matrix. The vector \c logp must have at least \c n 
+      elements.
+  */
+  template<class mat2_t, class vec2_t>
+  void log_pdf_many(size_t n, const mat2_t &x, vec2_t &logp) const {
+    if (ndim==0) {
+      O2SCL_ERR2("Distribution not set in prob_dens_mdim_gaussian::",
+		 "log_pdf_many().",o2scl::exc_einval);
+    }
+    double lnorm=log(norm);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel if (n>=100)
+#endif
+    {
+      std::vector<double> y(ndim);
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+      for(size_t k=0;k<n;k++) {
+	// Solve L y = x - peak
+	double sum2=0.0;
+	for(size_t i=0;i<ndim;i++) {
+	  double yi=x(k,i)-peak[i];
+	  for(size_t j=0;j<i;j++) yi-=chol(i,j)*y[j];
+	  yi/=chol(i,i);
+	  y[i]=yi;
+	  sum2+=yi*yi;
+	}
+	logp[k]=lnorm-0.5*sum2;
+      }
+    }
+    return;
+  }
+
     };
 
   /** \brief A multi-dimensional conditional probability density function
@@ -1222,20 +1330,37 @@ namespace o2scl {
 
   /// Standard normal
   o2scl::prob_dens_gaussian pdg;
+
+  /// Generator for the seeds used in \ref sample_many()
+  mutable o2scl::rng_gsl rs;
     
   public:
 
+  /** \brief The number of samples generated from each random
+      number stream in \ref sample_many() (default 256)
+  */
+  size_t block_size;
+
   /** \brief Create an empty distribution 
    */
   prob_cond_mdim_gaussian() {
     ndim=0;
+    block_size=256;
   }
   
   /** \brief Create a distribution from the covariance matrix
    */
   prob_cond_mdim_gaussian(size_t p_ndim, mat_t &covar) {
+    block_size=256;
     set(p_ndim,covar);
   }
+
+  /// Set the random number seed
+  void set_seed(unsigned long int s) {
+    pdg.set_seed(s);
+    rs.set_seed(s);
+    return;
+  }
   
   /// The dimensionality
   virtual size_t dim() const {
@@ -1314,6 +1439,96 @@ namespace o2scl {
     return;
   }
 
+  /** \brief For each of the \c n points in the rows of \c x,
+      sample the distribution and store the result in the 
+      corresponding row of \c x2
+
+      The matrices \c x and \c x2 must have at least \c n rows 
+      and \ref dim() columns. As in \ref
+      prob_dens_mdim_gaussian::sample_many(), each block of \ref
+      block_size samples uses a separate random number stream so
+      that the blocks can be computed in parallel with OpenMP.
+  */
+  template<class mat2_t, class mat3_t>
+  void sample_many(size_t n, const mat2_t &x, mat3_t &x2) const {
+    if (ndim==0) {
+      O2SCL_ERR2("Distribution not set in prob_cond_mdim_gaussian::",
+		 "sample_many().",o2scl::exc_einval);
+    }
+    if (n==0) return;
+    size_t bs=block_size;
+    if (bs==0) bs=1;
+    size_t nblocks=(n+bs-1)/bs;
+
+    // Seeds for each block
+    std::vector<unsigned long int> seeds(nblocks);
+    for(size_t ib=0;ib<nblocks;ib++) {
+      seeds[ib]=rs.random_int(rs.max()-rs.min());
+    }
+    
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for schedule(dynamic) if (nblocks>1)
+#endif
+    for(size_t ib=0;ib<nblocks;ib++) {
+      o2scl::prob_dens_gaussian pdgb;
+      pdgb.set_seed(seeds[ib]);
+      std::vector<double> z(ndim);
+      size_t kmax=(ib+1)*bs;
+      if (kmax>n) kmax=n;
+      for(size_t k=ib*bs;k<kmax;k++) {
+	for(size_t i=0;i<ndim;i++) z[i]=pdgb();
+	for(size_t i=0;i<ndim;i++) {
+	  double sum=x(k,i);
+	  for(size_t j=0;j<=i;j++) sum+=chol(i,j)*z[j];
+	  x2(k,i)=sum;
+	}
+      }
+    }
+    
+    return;
+  }
+
+  /** \brief Compute the log of the conditional probability for
+      each of the \c n pairs of points in the rows of \c x and 
+      \c x2, storing the results in \c logp
+
+      This uses a forward substitution with the stored Cholesky 
+      decomposition rather than the inverse of the covariance 
+      matrix. The vector \c logp must have at least \c n 
+      elements.
+  */
+  template<class mat2_t, class mat3_t, class vec2_t>
+  void log_pdf_many(size_t n, const mat2_t &x, const mat3_t &x2,
+		    vec2_t &logp) const {
+    if (ndim==0) {
+      O2SCL_ERR2("Distribution not set in prob_cond_mdim_gaussian::",
+		 "log_pdf_many().",o2scl::exc_einval);
+    }
+    double lnorm=log(norm);
+#ifdef O2SCL_OPENMP
+#pragma omp parallel if (n>=100)
+#endif
+    {
+      std::vector<double> y(ndim);
+#ifdef O2SCL_OPENMP
+#pragma omp for
+#endif
+      for(size_t k=0;k<n;k++) {
+	// Solve L y = x2 - x
+	double sum2=0.0;
+	for(size_t i=0;i<ndim;i++) {
+	  double yi=x2(k,i)-x(k,i);
+	  for(size_t j=0;j<i;j++) yi-=chol(i,j)*y[j];
+	  yi/=chol(i,i);
+	  y[i]=yi;
+	  sum2+=yi*yi;
+	}
+	logp[k]=lnorm-0.5*sum2;
+      }
+    }
+    return;
+  }
+
     };
 
 #ifdef O2SCL_NEVER_DEFINED  
@@ -186,6 +186,67 @@ int main(void) {
     t.test_rel(res,1.0,err,"normalization");
   }
 
+  // Test the batched sampling and density functions
+  {
+    size_t n=20000;
+    ubmatrix samp(n,2);
+    pdmg.sample_many(n,samp);
+
+    // Compare the sample mean and covariance with the exact values
+    double m0=0.0, m1=0.0;
+    for(size_t k=0;k<n;k++) {
+      m0+=samp(k,0);
+      m1+=samp(k,1);
+    }
+    m0/=n;
+    m1/=n;
+    double c00=0.0, c01=0.0, c11=0.0;
+    for(size_t k=0;k<n;k++) {
+      c00+=(samp(k,0)-m0)*(samp(k,0)-m0);
+      c01+=(samp(k,0)-m0)*(samp(k,1)-m1);
+      c11+=(samp(k,1)-m1)*(samp(k,1)-m1);
+    }
+    c00/=n-1;
+    c01/=n-1;
+    c11/=n-1;
+    t.test_abs(m0,2.0,0.05,"sample_many mean 0");
+    t.test_abs(m1,3.0,0.1,"sample_many mean 1");
+    t.test_rel(c00,1.0,0.05,"sample_many covar 00");
+    t.test_rel(c01,-1.0,0.05,"sample_many covar 01");
+    t.test_rel(c11,4.0,0.05,"sample_many covar 11");
+
+    // Compare log_pdf_many() with log_pdf()
+    ubvector lp(n), x(2);
+    pdmg.log_pdf_many(n,samp,lp);
+    for(size_t k=0;k<n;k+=1000) {
+      x[0]=samp(k,0);
+      x[1]=samp(k,1);
+      t.test_rel(lp[k],pdmg.log_pdf(x),1.0e-12,"log_pdf_many");
+    }
+
+    // Test the conditional distribution
+    prob_cond_mdim_gaussian<> pcmg(2,covar);
+    ubmatrix samp2(n,2);
+    pcmg.sample_many(n,samp,samp2);
+    double d0=0.0, d1=0.0;
+    for(size_t k=0;k<n;k++) {
+      d0+=samp2(k,0)-samp(k,0);
+      d1+=samp2(k,1)-samp(k,1);
+    }
+    t.test_abs(d0/n,0.0,0.05,"cond sample_many mean 0");
+    t.test_abs(d1/n,0.0,0.1,"cond sample_many mean 1");
+
+    ubvector x2(2);
+    pcmg.log_pdf_many(n,samp,samp2,lp);
+    for(size_t k=0;k<n;k+=1000) {
+      x[0]=samp(k,0);
+      x[1]=samp(k,1);
+      x2[0]=samp2(k,0);
+      x2[1]=samp2(k,1);
+      t.test_rel(lp[k],pcmg.log_pdf(x,x2),1.0e-12,"cond log_pdf_many");
+    }
+  }
+
   t.report();
 
   return 0;
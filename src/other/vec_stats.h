@@ -1857,6 +1857,363 @@ namespace o2scl {
   }
   //@}
 
+  /** \brief One-pass, mergeable accumulator for the first four
+      moments of (optionally weighted) data
+
+      This class computes the mean, variance, skewness, and kurtosis
+      of a data set in a single pass using the numerically stable
+      updates of Welford and Pebay. Two accumulators which have
+      processed disjoint parts of a data set can be combined with
+      \ref merge() and the result is the same (up to roundoff) as if
+      a single accumulator had processed all of the data. 
+
+      The functions \ref add_vector() process the data in blocks of
+      \ref block_size elements. The central sums for each block are
+      computed in a tight loop which the compiler can vectorize and
+      the blocks are then merged into the accumulator. If OpenMP
+      support is enabled and there are at least \ref min_par_blocks
+      blocks, the blocks are divided among threads and the
+      thread-local accumulators are merged at the end.
+
+      The results are normalized in the same way as \ref
+      vector_variance(), \ref vector_skew() and \ref vector_kurtosis()
+      (for unweighted data) and \ref wvector_variance(), \ref
+      wvector_skew() and \ref wvector_kurtosis() (for weighted data).
+      Weights which are not positive are ignored, as in the
+      corresponding GSL functions. The variance requires at least two
+      data points (or two points with positive weight), otherwise the
+      error handler is called.
+  */
+  class moment_accum {
+
+  protected:
+
+    /// Number of points with positive weight
+    size_t count;
+    /// Sum of weights
+    double sw;
+    /// Sum of squared weights
+    double sw2;
+    /// The weighted mean
+    double mu;
+    /// Central moment sums \f$ \sum_i w_i (x_i-\mu)^k \f$ for k=2,3,4
+    double m2, m3, m4;
+
+    /** \brief Merge the moments of a block with weight \c wb, 
+	mean \c mb and central sums \c b2, \c b3, and \c b4
+    */
+    void merge_block(size_t nb, double wb, double wb2, double mb,
+		     double b2, double b3, double b4) {
+      if (nb==0 || wb<=0.0) return;
+      if (count==0) {
+	count=nb;
+	sw=wb;
+	sw2=wb2;
+	mu=mb;
+	m2=b2;
+	m3=b3;
+	m4=b4;
+	return;
+      }
+      double wa=sw;
+      double w=wa+wb;
+      double d=mb-mu;
+      double d_w=d/w;
+      double d2=d*d;
+      double wab=wa*wb;
+      
+      double n4=m4+b4+d2*d2*wab*(wa*wa-wab+wb*wb)/(w*w*w)+
+	6.0*d2*(wa*wa*b2+wb*wb*m2)/(w*w)+4.0*d_w*(wa*b3-wb*m3);
+      double n3=m3+b3+d2*d*wab*(wa-wb)/(w*w)+3.0*d_w*(wa*b2-wb*m2);
+      double n2=m2+b2+d2*wab/w;
+
+      mu+=d_w*wb;
+      m2=n2;
+      m3=n3;
+      m4=n4;
+      sw=w;
+      sw2+=wb2;
+      count+=nb;
+      return;
+    }
+
+    /** \brief Compute the central sums of a block of unweighted data
+	and merge it
+    */
+    template<class vec_t>
+    void add_block(size_t istart, size_t iend, const vec_t &data) {
+      size_t nb=iend-istart;
+      if (nb==0) return;
+      // First pass for a provisional mean
+      double s0=0.0;
+      for(size_t i=istart;i<iend;i++) s0+=data[i];
+      double c=s0/nb;
+      // Second pass for the sums around the provisional mean
+      double s1=0.0, s2=0.0, s3=0.0, s4=0.0;
+      for(size_t i=istart;i<iend;i++) {
+	double y=data[i]-c;
+	double y2=y*y;
+	s1+=y;
+	s2+=y2;
+	s3+=y2*y;
+	s4+=y2*y2;
+      }
+      shift_merge(nb,nb,nb,c,s1,s2,s3,s4);
+      return;
+    }
+
+    /** \brief Compute the central sums of a block of weighted data
+	and merge it
+    */
+    template<class vec_t, class vec2_t>
+    void add_block(size_t istart, size_t iend, const vec_t &data,
+		   const vec2_t &weights) {
+      double wb=0.0, wb2=0.0, s0=0.0;
+      size_t nb=0;
+      for(size_t i=istart;i<iend;i++) {
+	double wi=weights[i];
+	if (wi>0.0) {
+	  wb+=wi;
+	  wb2+=wi*wi;
+	  s0+=wi*data[i];
+	  nb++;
+	}
+      }
+      if (nb==0 || wb<=0.0) return;
+      double c=s0/wb;
+      double s1=0.0, s2=0.0, s3=0.0, s4=0.0;
+      for(size_t i=istart;i<iend;i++) {
+	double wi=weights[i];
+	if (wi>0.0) {
+	  double y=data[i]-c;
+	  double wy=wi*y;
+	  s1+=wy;
+	  s2+=wy*y;
+	  s3+=wy*y*y;
+	  s4+=wy*y*y*y;
+	}
+      }
+      shift_merge(nb,wb,wb2,c,s1,s2,s3,s4);
+      return;
+    }
+
+    /** \brief Convert sums around the provisional mean \c c into
+	central sums and merge them
+    */
+    void shift_merge(size_t nb, double wb, double wb2, double c,
+		     double s1, double s2, double s3, double s4) {
+      double e=s1/wb;
+      double e2=e*e;
+      double b2=s2-e*s1;
+      double b3=s3-3.0*e*s2+3.0*e2*s1-wb*e2*e;
+      double b4=s4-4.0*e*s3+6.0*e2*s2-4.0*e2*e*s1+wb*e2*e2;
+      merge_block(nb,wb,wb2,c+e,b2,b3,b4);
+      return;
+    }
+
+  public:
+
+    moment_accum() {
+      block_size=256;
+      min_par_blocks=16;
+      clear();
+    }
+
+    /// Number of elements in each block (default 256)
+    size_t block_size;
+
+    /** \brief Minimum number of blocks before OpenMP is used 
+	(default 16)
+    */
+    size_t min_par_blocks;
+
+    /// Clear all of the accumulated data
+    void clear() {
+      count=0;
+      sw=0.0;
+      sw2=0.0;
+      mu=0.0;
+      m2=0.0;
+      m3=0.0;
+      m4=0.0;
+      return;
+    }
+
+    /// Add a single point
+    void add(double x) {
+      merge_block(1,1.0,1.0,x,0.0,0.0,0.0);
+      return;
+    }
+
+    /// Add a single point with weight \c w
+    void add(double x, double w) {
+      merge_block(1,w,w*w,x,0.0,0.0,0.0);
+      return;
+    }
+
+    /** \brief Combine the moments from \c ma with this accumulator
+     */
+    void merge(const moment_accum &ma) {
+      merge_block(ma.count,ma.sw,ma.sw2,ma.mu,ma.m2,ma.m3,ma.m4);
+      return;
+    }
+
+    /// Add the first \c n elements of \c data
+    template<class vec_t> void add_vector(size_t n, const vec_t &data) {
+      if (block_size==0) {
+	O2SCL_ERR("Block size zero in moment_accum::add_vector().",
+		  exc_einval);
+      }
+      size_t nblocks=(n+block_size-1)/block_size;
+#ifdef O2SCL_OPENMP
+      if (nblocks>=min_par_blocks) {
+#pragma omp parallel
+	{
+	  moment_accum loc;
+#pragma omp for schedule(static)
+	  for(size_t ib=0;ib<nblocks;ib++) {
+	    size_t iend=(ib+1)*block_size;
+	    if (iend>n) iend=n;
+	    loc.add_block(ib*block_size,iend,data);
+	  }
+#pragma omp critical (o2scl_moment_accum)
+	  {
+	    merge(loc);
+	  }
+	}
+	return;
+      }
+#endif
+      for(size_t ib=0;ib<nblocks;ib++) {
+	size_t iend=(ib+1)*block_size;
+	if (iend>n) iend=n;
+	add_block(ib*block_size,iend,data);
+      }
+      return;
+    }
+
+    /** \brief Add the first \c n elements of \c data with 
+	weights \c weights
+    */
+    template<class vec_t, class vec2_t>
+    void add_vector(size_t n, const vec_t &data, const vec2_t &weights) {
+      if (block_size==0) {
+	O2SCL_ERR("Block size zero in moment_accum::add_vector().",
+		  exc_einval);
+      }
+      size_t nblocks=(n+block_size-1)/block_size;
+#ifdef O2SCL_OPENMP
+      if (nblocks>=min_par_blocks) {
+#pragma omp parallel
+	{
+	  moment_accum loc;
+#pragma omp for schedule(static)
+	  for(size_t ib=0;ib<nblocks;ib++) {
+	    size_t iend=(ib+1)*block_size;
+	    if (iend>n) iend=n;
+	    loc.add_block(ib*block_size,iend,data,weights);
+	  }
+#pragma omp critical (o2scl_moment_accum)
+	  {
+	    merge(loc);
+	  }
+	}
+	return;
+      }
+#endif
+      for(size_t ib=0;ib<nblocks;ib++) {
+	size_t iend=(ib+1)*block_size;
+	if (iend>n) iend=n;
+	add_block(ib*block_size,iend,data,weights);
+      }
+      return;
+    }
+
+    /// Return the number of points with positive weight
+    size_t get_count() const {
+      return count;
+    }
+
+    /// Return the sum of the weights
+    double get_weight() const {
+      return sw;
+    }
+
+    /// Return the mean
+    double mean() const {
+      return mu;
+    }
+
+    /** \brief Return the variance, normalized as in \ref
+	vector_variance() or \ref wvector_variance()
+    */
+    double variance() const {
+      if (count<2) {
+	O2SCL_ERR2("Fewer than two points in ",
+		   "moment_accum::variance().",exc_einval);
+      }
+      return m2/(sw-sw2/sw);
+    }
+
+    /// Return the standard deviation
+    double stddev() const {
+      return sqrt(variance());
+    }
+
+    /// Return the skewness
+    double skew() const {
+      double sd=stddev();
+      return m3/sw/(sd*sd*sd);
+    }
+
+    /// Return the kurtosis
+    double kurtosis() const {
+      double var=variance();
+      return m4/sw/(var*var)-3.0;
+    }
+
+  };
+
+  /** \brief Compute the mean, standard deviation, skewness and
+      kurtosis of the first \c n elements of \c data in one pass
+
+      This gives the same results as \ref vector_mean(), \ref
+      vector_stddev(), \ref vector_skew() and \ref vector_kurtosis()
+      up to roundoff. It uses \ref moment_accum and thus runs in
+      parallel for large vectors if OpenMP support is enabled.
+  */
+  template<class vec_t>
+  void vector_moments(size_t n, const vec_t &data, double &mean,
+		      double &sd, double &skew, double &kurt) {
+    moment_accum ma;
+    ma.add_vector(n,data);
+    mean=ma.mean();
+    sd=ma.stddev();
+    skew=ma.skew();
+    kurt=ma.kurtosis();
+    return;
+  }
+
+  /** \brief Compute the weighted mean, standard deviation,
+      skewness and kurtosis of the first \c n elements of \c data in
+      one pass
+
+      This gives the same results as \ref wvector_mean(), \ref
+      wvector_stddev(), \ref wvector_skew() and \ref
+      wvector_kurtosis() up to roundoff.
+  */
+  template<class vec_t, class vec2_t>
+  void wvector_moments(size_t n, const vec_t &data, const vec2_t &weights,
+		       double &mean, double &sd, double &skew, double &kurt) {
+    moment_accum ma;
+    ma.add_vector(n,data,weights);
+    mean=ma.mean();
+    sd=ma.stddev();
+    skew=ma.skew();
+    kurt=ma.kurtosis();
+    return;
+  }
+
 #ifndef DOXYGEN_NO_O2NS
 }
 #endif
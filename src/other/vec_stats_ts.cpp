@@ -166,6 +166,45 @@ int main(void) {
   cout << vector_max_value<vector<double>,double>(btest) << endl;
   cout << vector_bin_size_scott(btest) << endl;
   cout << vector_bin_size_freedman(btest) << endl;
+
+  // Compare the one-pass moment accumulator with the two-pass
+  // functions, including the parallel and merged paths
+  {
+    std::vector<double> mx(5000), mw(5000);
+    for(size_t i=0;i<mx.size();i++) {
+      mx[i]=1.0e3+sin(i*0.37)+0.1*pdg();
+      mw[i]=1.0+cos(i*0.11);
+    }
+    size_t nm=mx.size();
+    double mean, sd, skew, kurt;
+    vector_moments(nm,mx,mean,sd,skew,kurt);
+    t.test_rel(mean,vector_mean(nm,mx),1.0e-12,"moments mean");
+    t.test_rel(sd,vector_stddev(nm,mx),1.0e-10,"moments sd");
+    t.test_rel(skew,vector_skew(nm,mx),1.0e-8,"moments skew");
+    t.test_rel(kurt,vector_kurtosis(nm,mx),1.0e-8,"moments kurt");
+
+    wvector_moments(nm,mx,mw,mean,sd,skew,kurt);
+    t.test_rel(mean,wvector_mean(nm,mx,mw),1.0e-12,"wmoments mean");
+    t.test_rel(sd,wvector_stddev(nm,mx,mw),1.0e-10,"wmoments sd");
+    t.test_rel(skew,wvector_skew(nm,mx,mw),1.0e-8,"wmoments skew");
+    t.test_rel(kurt,wvector_kurtosis(nm,mx,mw),1.0e-8,"wmoments kurt");
+
+    // Point-by-point accumulation and merging two halves
+    moment_accum ma, mb, mc;
+    for(size_t i=0;i<nm;i++) ma.add(mx[i],mw[i]);
+    mb.add_vector(1234,mx,mw);
+    std::vector<double> mx2(mx.begin()+1234,mx.end());
+    std::vector<double> mw2(mw.begin()+1234,mw.end());
+    mc.add_vector(nm-1234,mx2,mw2);
+    mb.merge(mc);
+    t.test_rel(ma.mean(),mb.mean(),1.0e-12,"accum merge mean");
+    t.test_rel(ma.variance(),mb.variance(),1.0e-10,"accum merge var");
+    t.test_rel(ma.skew(),mb.skew(),1.0e-8,"accum merge skew");
+    t.test_rel(ma.kurtosis(),mb.kurtosis(),1.0e-8,"accum merge kurt");
+    t.test_rel(ma.kurtosis(),wvector_kurtosis(nm,mx,mw),1.0e-8,
+	       "accum add kurt");
+    t.test_gen(ma.get_count()==nm,"accum count");
+  }
   
   t.report();
   
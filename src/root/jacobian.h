@@ -28,6 +28,12 @@
 */
 
 #include <string>
+#include <vector>
+
+#ifdef O2SCL_OPENMP
+#include <omp.h>
+#endif
+
 #include <o2scl/mm_funct.h>
 #include <o2scl/deriv_gsl.h>
 #include <o2scl/columnify.h>
@@ -133,6 +139,27 @@ namespace o2scl {
       This class does not separately check the vector and matrix sizes
       to ensure they are commensurate. 
 
+      <b>Parallel and sparse Jacobians</b>
+
+      If several copies of the function are specified with \ref
+      set_function_threads() and OpenMP support is enabled, then the
+      columns of the Jacobian are computed in parallel, one
+      thread for each function object. The function objects
+      must all compute the same function as the one specified in
+      \ref set_function() (which is what \ref mroot_hybrids uses
+      for the solver itself) and must be safe to call
+      simultaneously.
+
+      If the sparsity pattern of the Jacobian is given with \ref
+      set_sparsity(), then columns which do not share any nonzero
+      rows are given the same color and perturbed in the same
+      function call. The elements of the Jacobian outside the
+      sparsity pattern are set to zero. A coloring can be specified
+      directly, or computed with a greedy algorithm. Both modes can
+      be used together, in which case each thread computes one
+      color at a time. Both modes can be used with \ref mroot_hybrids
+      by calling these functions on \ref mroot_hybrids::def_jac .
+
       Default template arguments
       - \c func_t - \ref mm_funct
       - \c vec_t - boost::numeric::ublas::vector<double>
@@ -172,6 +199,172 @@ namespace o2scl {
   /// Factor to shrink stepsize by
   double shrink_fact;
 
+  /// Function copies for each thread
+  std::vector<func_t> func_vec;
+
+  /// Function arguments for each thread
+  std::vector<vec_t> xx_vec;
+
+  /// Function values for each thread
+  std::vector<vec_t> f_vec;
+
+  /// For each column, the rows which may be nonzero
+  std::vector<std::vector<size_t> > col_rows;
+
+  /// The columns in each color
+  std::vector<std::vector<size_t> > groups;
+
+  /// The return value for each group
+  std::vector<int> group_ret;
+
+  /// A flag for a zero column in each group
+  std::vector<int> group_zero;
+
+  /// The step sizes for each thread
+  std::vector<std::vector<double> > h_vec;
+
+  /** \brief Compute the Jacobian by groups of columns, possibly
+      in parallel
+  */
+  int jac_groups(size_t nx, vec_t &x, size_t ny, vec_t &y, mat_t &jac) {
+
+    size_t n_groups;
+    if (groups.size()>0) {
+      n_groups=groups.size();
+      size_t ncol=0;
+      for(size_t g=0;g<n_groups;g++) ncol+=groups[g].size();
+      if (ncol!=nx || col_rows.size()!=nx) {
+	O2SCL_ERR2("Sparsity pattern does not match number of ",
+		   "variables in jacobian_gsl::jac_groups().",
+		   exc_einval);
+      }
+    } else {
+      n_groups=nx;
+    }
+
+    size_t nt=func_vec.size();
+    if (nt==0) nt=1;
+#ifndef O2SCL_OPENMP
+    nt=1;
+#endif
+
+    // The workspaces are only reallocated if the sizes change
+    if (xx_vec.size()!=nt) {
+      xx_vec.resize(nt);
+      f_vec.resize(nt);
+      h_vec.resize(nt);
+    }
+    for(size_t it=0;it<nt;it++) {
+      if (xx_vec[it].size()!=nx) xx_vec[it].resize(nx);
+      if (f_vec[it].size()!=ny) f_vec[it].resize(ny);
+      vector_copy(nx,x,xx_vec[it]);
+    }
+
+    // Return values and a flag for zero columns for each group
+    std::vector<int> &rets=group_ret;
+    std::vector<int> &zero_col=group_zero;
+    rets.assign(n_groups,0);
+    zero_col.assign(n_groups,0);
+
+#ifdef O2SCL_OPENMP
+#pragma omp parallel for num_threads(nt) schedule(dynamic)
+#endif
+    for(int ig=0;ig<((int)n_groups);ig++) {
+      
+      size_t it=0;
+#ifdef O2SCL_OPENMP
+      it=omp_get_thread_num();
+#endif
+      vec_t &xt=xx_vec[it];
+      vec_t &ft=f_vec[it];
+      func_t &fn=(func_vec.size()>0) ? func_vec[it] : this->func;
+
+      // The columns in this group
+      size_t single_col=ig;
+      const size_t *cols=&single_col;
+      size_t nc=1;
+      if (groups.size()>0) {
+	nc=groups[ig].size();
+	if (nc>0) cols=&(groups[ig][0]);
+      }
+
+      std::vector<double> &h=h_vec[it];
+      if (h.size()<nc) h.resize(nc);
+      for(size_t k=0;k<nc;k++) {
+	size_t jc=cols[k];
+	h[k]=epsrel*fabs(x[jc]);
+	if (h[k]<epsmin) h[k]=epsmin;
+	if (h[k]==0.0) h[k]=epsrel;
+	xt[jc]=x[jc]+h[k];
+      }
+      int ret=fn(nx,xt,ft);
+      for(size_t k=0;k<nc;k++) xt[cols[k]]=x[cols[k]];
+
+      // The function returned a non-zero value, so try a different
+      // step for all the columns in the group
+      size_t iter=0;
+      while (ret!=0 && h[0]>=epsmin && iter<max_shrink_iters) {
+	for(size_t k=0;k<nc;k++) {
+	  h[k]=-h[k];
+	  xt[cols[k]]=x[cols[k]]+h[k];
+	}
+	ret=fn(nx,xt,ft);
+	for(size_t k=0;k<nc;k++) xt[cols[k]]=x[cols[k]];
+	if (ret!=0) {
+	  for(size_t k=0;k<nc;k++) h[k]/=-shrink_fact;
+	  if (h[0]>=epsmin) {
+	    for(size_t k=0;k<nc;k++) xt[cols[k]]=x[cols[k]]+h[k];
+	    ret=fn(nx,xt,ft);
+	    for(size_t k=0;k<nc;k++) xt[cols[k]]=x[cols[k]];
+	  }
+	}
+	iter++;
+      }
+      rets[ig]=ret;
+
+      if (ret==0) {
+	for(size_t k=0;k<nc;k++) {
+	  size_t jc=cols[k];
+	  bool nonzero=false;
+	  if (col_rows.size()>0) {
+	    for(size_t i=0;i<ny;i++) jac(i,jc)=0.0;
+	    for(size_t ir=0;ir<col_rows[jc].size();ir++) {
+	      size_t i=col_rows[jc][ir];
+	      double temp=(ft[i]-y[i])/h[k];
+	      if (temp!=0.0) nonzero=true;
+	      jac(i,jc)=temp;
+	    }
+	  } else {
+	    for(size_t i=0;i<ny;i++) {
+	      double temp=(ft[i]-y[i])/h[k];
+	      if (temp!=0.0) nonzero=true;
+	      jac(i,jc)=temp;
+	    }
+	  }
+	  if (nonzero==false) zero_col[ig]=1;
+	}
+      }
+    }
+    // End of parallel region
+
+    bool success=true;
+    for(size_t g=0;g<n_groups;g++) {
+      if (rets[g]!=0) {
+	O2SCL_CONV2_RET("Jacobian failed to find valid step in ",
+			"jacobian_gsl::jac_groups().",exc_ebadfunc,
+			this->err_nonconv);
+      }
+      if (zero_col[g]==1) success=false;
+    }
+    
+    if (success==false) {
+      O2SCL_CONV2_RET("At least one row of the Jacobian is zero ",
+		      "in jacobian_gsl::jac_groups().",exc_esing,
+		      this->err_nonconv);
+    }
+    return 0;
+  }
+
 #endif
 
   public:
@@ -235,11 +428,109 @@ namespace o2scl {
     max_shrink_iters=it;
     return;
   }
+
+  /** \brief Set one copy of the function for each thread
+
+      If the vector has more than one element and OpenMP support is
+      enabled, then the Jacobian columns are computed in parallel
+      using one thread per function object. An empty vector
+      returns to the serial computation.
+  */
+  void set_function_threads(std::vector<func_t> &fv) {
+    func_vec=fv;
+    return;
+  }
+
+  /** \brief Specify the sparsity pattern of the Jacobian
+
+      The vector \c rows should have one entry for each column of
+      the Jacobian, listing the rows in which that column may be
+      nonzero. If \c colors is non-empty, it should give a color for
+      each column such that no two columns with the same color share
+      a nonzero row. Otherwise, a coloring is computed with a greedy
+      algorithm. The number of function evaluations for the
+      Jacobian is reduced from the number of columns to the number
+      of colors.
+  */
+  void set_sparsity(const std::vector<std::vector<size_t> > &rows,
+		    const std::vector<size_t> &colors=
+		    std::vector<size_t>()) {
+
+    size_t nx=rows.size();
+    col_rows=rows;
+    groups.clear();
+
+    if (colors.size()>0) {
+
+      if (colors.size()!=nx) {
+	O2SCL_ERR2("Number of colors does not match number of ",
+		   "columns in jacobian_gsl::set_sparsity().",exc_einval);
+      }
+      for(size_t j=0;j<nx;j++) {
+	if (colors[j]>=groups.size()) groups.resize(colors[j]+1);
+	groups[colors[j]].push_back(j);
+      }
+      // Remove unused colors
+      for(size_t g=groups.size();g>0;g--) {
+	if (groups[g-1].size()==0) groups.erase(groups.begin()+g-1);
+      }
+
+    } else {
+
+      // Greedy coloring: place each column in the first group which
+      // has no rows in common with it
+      std::vector<std::vector<bool> > used;
+      for(size_t j=0;j<nx;j++) {
+	size_t g=0;
+	bool found=false;
+	for(g=0;g<groups.size() && found==false;g++) {
+	  bool conflict=false;
+	  for(size_t k=0;k<rows[j].size() && conflict==false;k++) {
+	    size_t ir=rows[j][k];
+	    if (ir<used[g].size() && used[g][ir]) conflict=true;
+	  }
+	  if (conflict==false) found=true;
+	}
+	if (found) {
+	  g--;
+	} else {
+	  groups.resize(groups.size()+1);
+	  used.resize(used.size()+1);
+	  g=groups.size()-1;
+	}
+	groups[g].push_back(j);
+	for(size_t k=0;k<rows[j].size();k++) {
+	  size_t ir=rows[j][k];
+	  if (ir>=used[g].size()) used[g].resize(ir+1,false);
+	  used[g][ir]=true;
+	}
+      }
+      
+    }
+    
+    return;
+  }
+
+  /// Remove the sparsity pattern and coloring
+  void clear_sparsity() {
+    col_rows.clear();
+    groups.clear();
+    return;
+  }
+
+  /// Return the number of colors (zero if no sparsity is specified)
+  size_t get_n_colors() {
+    return groups.size();
+  }
   
   /** \brief The operator()
    */
   virtual int operator()(size_t nx, vec_t &x, size_t ny, vec_t &y, 
 			 mat_t &jac) {
+
+    if (func_vec.size()>1 || groups.size()>0) {
+      return jac_groups(nx,x,ny,y,jac);
+    }
       
     size_t i,j;
     double h,temp;
@@ -38,6 +38,23 @@ int tfun(size_t nv, const ubvector &x, ubvector &y) {
   return 0;
 }
 
+// Number of calls to tridiag()
+static size_t n_tridiag=0;
+
+// A function with a tridiagonal Jacobian
+int tridiag(size_t nv, const ubvector &x, ubvector &y) {
+#ifdef O2SCL_OPENMP
+#pragma omp atomic
+#endif
+  n_tridiag++;
+  for(size_t i=0;i<nv;i++) {
+    y[i]=3.0*x[i]*x[i]-1.0;
+    if (i>0) y[i]+=sin(x[i-1]);
+    if (i+1<nv) y[i]-=x[i+1]*x[i];
+  }
+  return 0;
+}
+
 int main(void) {
 
   jacobian_exact<mm_funct> ej;
@@ -98,6 +115,70 @@ int main(void) {
        << 3.0*x[1]*x[1] << endl;
   cout << endl;
 
+  // Test the sparse and threaded Jacobians with a tridiagonal
+  // function
+  {
+    size_t n=7;
+    mm_funct mtri=tridiag;
+    ubvector xt(n), yt(n);
+    ubmatrix jd(n,n), js(n,n);
+    for(size_t i=0;i<n;i++) xt[i]=0.1*((double)i)+0.2;
+    tridiag(n,xt,yt);
+
+    jacobian_gsl<mm_funct> jd_obj, js_obj;
+    jd_obj.set_function(mtri);
+    js_obj.set_function(mtri);
+
+    n_tridiag=0;
+    jd_obj(n,xt,n,yt,jd);
+    t.test_gen(n_tridiag==n,"dense count");
+
+    // Sparsity pattern with greedy coloring
+    vector<vector<size_t> > rows(n);
+    for(size_t j=0;j<n;j++) {
+      if (j>0) rows[j].push_back(j-1);
+      rows[j].push_back(j);
+      if (j+1<n) rows[j].push_back(j+1);
+    }
+    js_obj.set_sparsity(rows);
+    t.test_gen(js_obj.get_n_colors()==3,"n_colors");
+
+    n_tridiag=0;
+    js_obj(n,xt,n,yt,js);
+    t.test_gen(n_tridiag==3,"sparse count");
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	t.test_gen(jd(i,j)==js(i,j),"sparse vs. dense");
+      }
+    }
+
+    // Explicit coloring and thread copies
+    vector<size_t> colors(n);
+    for(size_t j=0;j<n;j++) colors[j]=j%4;
+    js_obj.set_sparsity(rows,colors);
+    vector<mm_funct> fv(3,mtri);
+    js_obj.set_function_threads(fv);
+    n_tridiag=0;
+    js_obj(n,xt,n,yt,js);
+    t.test_gen(n_tridiag==4,"colored count");
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	t.test_gen(jd(i,j)==js(i,j),"threaded sparse vs. dense");
+      }
+    }
+
+    // Thread copies without sparsity
+    js_obj.clear_sparsity();
+    n_tridiag=0;
+    js_obj(n,xt,n,yt,js);
+    t.test_gen(n_tridiag==n,"threaded count");
+    for(size_t i=0;i<n;i++) {
+      for(size_t j=0;j<n;j++) {
+	t.test_gen(jd(i,j)==js(i,j),"threaded vs. dense");
+      }
+    }
+  }
+
   t.report();
   return 0;
 }
@@ -483,7 +483,20 @@ namespace o2scl {
       from \ref jacobian_gsl. This default is identical to the GSL
       approach, except that the default value of \ref
       jacobian_gsl::epsmin is non-zero. See \ref jacobian_gsl
-      for more details.
+      for more details. The Jacobian columns can be computed in
+      parallel by giving thread-safe copies of the function to
+      \ref jacobian_gsl::set_function_threads() and, if the
+      sparsity pattern is known, several columns can be computed in
+      one function evaluation using \ref
+      jacobian_gsl::set_sparsity(). Both functions can be called on
+      \ref def_jac before calling \ref msolve().
+
+      For small systems where the number of variables is known at
+      compile time, the types \ref o2scl::fixed_vector and \ref
+      o2scl::fixed_matrix from \ref vector_fixed.h can be used for
+      \c vec_t and \c mat_t (along with function types which use
+      them) to avoid heap allocation for the function arguments,
+      the Jacobian, and the QR decomposition.
 
       By default convergence failures result in calling the exception
       handler, but this can be turned off by setting \ref
@@ -591,16 +604,37 @@ namespace o2scl {
   /// True if "set" has been called
   bool set_called;
 
+  /** \brief True if \ref q and \ref r hold the factorization from
+      a successful solve which can be reused
+  */
+  bool jac_valid;
+
   /// Finish the solution after set() or set_de() has been called
   virtual int solve_set(size_t nn, vec_t &xx, func_t &ufunc) {
 
     int status;
     iter=0;
 
+    // If the initial guess already satisfies the tolerance, return
+    // without iterating, since the dogleg step would vanish
+    double resid0=0.0;
+    for(size_t i=0;i<nn;i++) {
+      resid0+=fabs(f[i]);
+    }
+    if (resid0<this->tol_rel) {
+      for(size_t i=0;i<nn;i++) {
+	xx[i]=x[i];
+      }
+      this->last_ntrial=0;
+      jac_valid=true;
+      return success;
+    }
+
     do {
       iter++;
 	
       if (iterate()!=0) {
+	jac_valid=false;
 	O2SCL_CONV2_RET("Function iterate() failed in mroot_hybrids::",
 			"solve_set().",exc_efailed,this->err_nonconv);
       }
@@ -633,10 +667,13 @@ namespace o2scl {
     this->last_ntrial=iter;
     
     if (((int)iter)>=this->ntrial) {
+      jac_valid=false;
       O2SCL_CONV2_RET("Function mroot_hybrids::msolve() ",
 		      "exceeded max. number of iterations.",
 		      exc_emaxiter,this->err_nonconv);
     }
+
+    jac_valid=true;
     
     return success;
   }
@@ -654,6 +691,9 @@ namespace o2scl {
     jac_given=false;
     set_called=false;
     extra_finite_check=true;
+    reuse_jac=false;
+    jac_valid=false;
+    n_jac_reused=0;
   }
   
   virtual ~mroot_hybrids() {
@@ -675,6 +715,25 @@ namespace o2scl {
   /// If true, use the internal scaling method (default true)
   bool int_scaling;
 
+  /** \brief If true, reuse the Jacobian approximation from the
+      previous successful solve (default false)
+
+      When this is true and the previous call to msolve() or
+      msolve_de() succeeded with the same number of variables, then
+      set() does not compute a new Jacobian. Instead, it begins with
+      the QR factorization of the final Broyden approximation and
+      the scaling from the previous solve. This saves one
+      Jacobian evaluation (i.e. \c n function evaluations for the
+      default finite-difference Jacobian) when a sequence of
+      closely-related problems is solved. If the stale
+      approximation fails to make progress, iterate() recomputes
+      the Jacobian as usual.
+  */
+  bool reuse_jac;
+
+  /// The number of times set() has reused the previous Jacobian
+  size_t n_jac_reused;
+
   /// Default automatic Jacobian object
   jacobian_gsl<func_t,vec_t,mat_t> def_jac;
 
@@ -969,6 +1028,7 @@ namespace o2scl {
     }
       
     dim=n;
+    jac_valid=false;
 
     return;
   }
@@ -1035,12 +1095,21 @@ namespace o2scl {
 		      "mroot_hybrids::set().",exc_ebadfunc,this->err_nonconv);
     }
     
-    if (jac_given) status=(*jac)(dim,ax,dim,f,J);
-    else status=(*ajac)(dim,ax,dim,f,J);
+    // Use the previous Jacobian approximation if requested
+    bool reuse=(reuse_jac && jac_valid);
+    jac_valid=false;
 
-    if (status!=0) {
-      O2SCL_CONV2_RET("Jacobian failed in ",
-		      "mroot_hybrids::set().",exc_efailed,this->err_nonconv);
+    if (reuse) {
+      n_jac_reused++;
+    } else {
+      if (jac_given) status=(*jac)(dim,ax,dim,f,J);
+      else status=(*ajac)(dim,ax,dim,f,J);
+      
+      if (status!=0) {
+	O2SCL_CONV2_RET("Jacobian failed in ",
+			"mroot_hybrids::set().",exc_efailed,
+			this->err_nonconv);
+      }
     }
 
     iter=1;
@@ -1052,12 +1121,15 @@ namespace o2scl {
       
     for(size_t i=0;i<dim;i++) dx[i]=0.0;
       
-    /* Store column norms in diag */
+    /* Store column norms in diag (when reusing the Jacobian, the
+       previous scaling is kept) */
   
-    if (int_scaling) {
-      compute_diag(dim,J,diag);
-    } else {
-      for(size_t ii=0;ii<diag.size();ii++) diag[ii]=0.0;
+    if (!reuse) {
+      if (int_scaling) {
+	compute_diag(dim,J,diag);
+      } else {
+	for(size_t ii=0;ii<diag.size();ii++) diag[ii]=0.0;
+      }
     }
 	
     /* Set delta to factor |D x| or to factor if |D x| is zero */
@@ -1065,7 +1137,9 @@ namespace o2scl {
     delta=compute_delta(dim,diag,x);
   
     /* Factorize J into QR decomposition */
-    o2scl_linalg::QR_decomp_unpack(dim,dim,this->J,this->q,this->r);
+    if (!reuse) {
+      o2scl_linalg::QR_decomp_unpack(dim,dim,this->J,this->q,this->r);
+    }
     set_called=true;
     jac_given=false;
 
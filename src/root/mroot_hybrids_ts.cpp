@@ -25,6 +25,9 @@
 #include <o2scl/test_mgr.h>
 #include <o2scl/mm_funct.h>
 #include <o2scl/mroot_hybrids.h>
+#include <o2scl/vector_fixed.h>
+#include <o2scl/lu.h>
+#include <o2scl/hh.h>
 
 using namespace std;
 using namespace o2scl;
@@ -45,6 +48,15 @@ int gfn(size_t nv, const ubvector &x,
   return 0;
 }
 
+typedef fixed_vector<2> fvector;
+typedef fixed_matrix<2> fmatrix;
+
+int gfn_fixed(size_t nv, const fvector &x, fvector &y) {
+  y[0]=sin(x[1]-0.2);
+  y[1]=sin(x[0]-0.25);
+  return 0;
+}
+
 class cl {
 
 public:
@@ -235,6 +247,51 @@ int main(void) {
   t.test_rel_vec(resid_test.size(),resid_test,resid_test2,1.0e-2,
 		 "GSL vs. O2scl");
 
+  // 10 - Using vector and matrix types with a fixed size
+  {
+    typedef std::function<int(size_t,const fvector &,fvector &)> ffunct;
+    typedef std::function<int(size_t,fvector &,size_t,fvector &,
+			      fmatrix &)> fjac_funct;
+    ffunct ffn=gfn_fixed;
+    mroot_hybrids<ffunct,fvector,fmatrix,fjac_funct> cr8;
+    
+    fvector fx;
+    fx[0]=0.5;
+    fx[1]=0.5;
+    cr8.msolve(2,fx,ffn);
+    t.test_rel(fx[0],0.25,1.0e-6,"fixed a");
+    t.test_rel(fx[1],0.2,1.0e-6,"fixed b");
+
+    // Compare the fixed-size LU and Householder solvers with
+    // the generic versions
+    fmatrix fm, fm2;
+    ubmatrix um(2,2);
+    fvector fb, fx2;
+    ubvector ub(2), ux(2);
+    fm(0,0)=2.0;
+    fm(0,1)=1.0;
+    fm(1,0)=-1.0;
+    fm(1,1)=3.0;
+    fm2=fm;
+    fb[0]=1.0;
+    fb[1]=2.0;
+    for(size_t i=0;i<2;i++) {
+      ub[i]=fb[i];
+      for(size_t j=0;j<2;j++) um(i,j)=fm(i,j);
+    }
+    permutation fp(2), up(2);
+    int sig;
+    o2scl_linalg::LU_decomp(2,fm,fp,sig);
+    o2scl_linalg::LU_solve(2,fm,fp,fb,fx2);
+    o2scl_linalg::LU_decomp(2,um,up,sig);
+    o2scl_linalg::LU_solve(2,um,up,ub,ux);
+    t.test_rel(fx2[0],ux[0],1.0e-14,"fixed LU 0");
+    t.test_rel(fx2[1],ux[1],1.0e-14,"fixed LU 1");
+    o2scl_linalg::HH_solve(2,fm2,fb,fx2);
+    t.test_rel(fx2[0],ux[0],1.0e-14,"fixed HH 0");
+    t.test_rel(fx2[1],ux[1],1.0e-14,"fixed HH 1");
+  }
+
 #ifdef O2SCL_EIGEN
 
   // 8 - Using Eigen
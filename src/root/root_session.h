@@ -0,0 +1,502 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+/** \file root_session.h
+    \brief File defining \ref o2scl::root_session and
+    \ref o2scl::mroot_session
+*/
+#ifndef O2SCL_ROOT_SESSION_H
+#define O2SCL_ROOT_SESSION_H
+
+#include <cmath>
+#include <vector>
+
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <o2scl/err_hnd.h>
+#include <o2scl/funct.h>
+#include <o2scl/root.h>
+#include <o2scl/root_brent_gsl.h>
+#include <o2scl/mroot.h>
+#include <o2scl/mroot_hybrids.h>
+
+#ifndef DOXYGEN_NO_O2NS
+namespace o2scl {
+#endif
+
+  /** \brief Polynomial extrapolation used by the solver sessions
+
+      Given the \c n points in \c p and \c y (ordered from oldest to
+      newest), this returns the value of the Lagrange interpolating
+      polynomial through the last <tt>order+1</tt> points evaluated
+      at \c p0. Points with duplicate values of \c p are skipped.
+      The estimate of the extrapolation error, the difference from
+      the extrapolation of one lower order, is placed in \c err.
+  */
+  template<class vec_t, class vec2_t>
+    double session_extrap(size_t n, const vec_t &p, const vec2_t &y,
+			  size_t order, double p0, double &err) {
+
+    // Select the last order+1 points with distinct values of p
+    size_t ix[4];
+    size_t m=0;
+    if (order>3) order=3;
+    for(size_t k=n;k>0 && m<order+1;k--) {
+      bool dup=false;
+      for(size_t j=0;j<m;j++) {
+	if (p[k-1]==p[ix[j]]) dup=true;
+      }
+      if (!dup) ix[m++]=k-1;
+    }
+    if (m==0) {
+      err=0.0;
+      return 0.0;
+    }
+
+    // Evaluate Lagrange polynomials of each order up to m-1
+    double res=0.0, res_low=y[ix[0]];
+    for(size_t q=0;q<m;q++) {
+      double sum=0.0;
+      for(size_t i=0;i<=q;i++) {
+	double li=1.0;
+	for(size_t j=0;j<=q;j++) {
+	  if (j!=i) li*=(p0-p[ix[j]])/(p[ix[i]]-p[ix[j]]);
+	}
+	sum+=li*y[ix[i]];
+      }
+      if (q+1<m) res_low=sum;
+      res=sum;
+    }
+    err=fabs(res-res_low);
+    return res;
+  }
+
+  /** \brief A one-dimensional solver session for sequences of
+      closely-related problems
+
+      This class is designed for the case where the same equation is
+      solved many times as a function of a slowly-varying parameter,
+      \f$ p \f$ (e.g. the density). It keeps the solver object and a
+      short history of previous parameters and solutions, and uses
+      them to construct the initial guess for the next solve.
+
+      For each call to \ref solve(), the initial guess is obtained
+      by polynomial extrapolation (of order up to \ref order) of the
+      previous solutions as a function of \f$ p \f$. If the solver
+      is a bracketing solver, the function is then evaluated on both
+      sides of this guess with a width given by the estimated
+      extrapolation error. If a root is bracketed, then
+      \ref root::solve_bkt() is called directly, skipping the
+      automatic bracketing procedure in \ref root_bkt::solve().
+      The function values at the ends of the bracket are kept, so
+      the solver does not evaluate the function there again.
+      Otherwise (or for non-bracketing solvers), the solver is
+      called with the extrapolated guess.
+
+      The number of function evaluations is counted, and the number
+      saved is estimated by comparing the evaluations used in each
+      warm-started solve with the average number used by the
+      solves which did not have a history.
+
+      The default solver is \ref root_brent_gsl, and a different
+      solver can be specified with \ref set_root().
+  */
+  template<class func_t=funct> class root_session {
+
+  public:
+
+  root_session() {
+    rp=&def_root;
+    order=2;
+    n_hist=4;
+    bracket_fac=2.0;
+    n_expand=3;
+    n_cache=0;
+    clear();
+  }
+
+  virtual ~root_session() {}
+
+  /// \name Settings
+  //@{
+  /** \brief Maximum order of polynomial extrapolation (default 2,
+      maximum 3)
+  */
+  size_t order;
+
+  /// Number of previous solutions to store (default 4)
+  size_t n_hist;
+
+  /** \brief Factor multiplying the extrapolation error estimate
+      to obtain the bracket width (default 2.0)
+  */
+  double bracket_fac;
+
+  /// Number of times the bracket is expanded (default 3)
+  size_t n_expand;
+  //@}
+
+  /// \name Counters
+  //@{
+  /// The number of calls to \ref solve()
+  size_t n_solves;
+
+  /// The total number of function evaluations
+  size_t n_evals;
+
+  /// The number of solves which used a warm-start bracket
+  size_t n_warm;
+
+  /** \brief The estimated number of function evaluations saved
+      by the session
+  */
+  double n_saved;
+  //@}
+
+  /// The default solver
+  root_brent_gsl<funct> def_root;
+
+  /// Set the solver to use
+  void set_root(root<funct> &r) {
+    rp=&r;
+    return;
+  }
+
+  /// Forget the previous solutions and reset the counters
+  void clear() {
+    hp.clear();
+    hx.clear();
+    n_solves=0;
+    n_evals=0;
+    n_warm=0;
+    n_saved=0.0;
+    n_cold=0;
+    n_evals_cold=0;
+    return;
+  }
+
+  /** \brief Solve \c func for the parameter value \c p
+
+      If there are no previous solutions, \c x is used as the initial
+      guess. Upon return \c x contains the solution.
+  */
+  virtual int solve(double p, double &x, func_t &func) {
+
+    funct fc=std::bind
+      (std::mem_fn<double(double,func_t &)>
+       (&root_session<func_t>::count_func),this,std::placeholders::_1,
+       std::ref(func));
+
+    size_t evals_start=n_evals;
+    n_solves++;
+    bool warm=(hp.size()>0);
+    int ret;
+
+    if (!warm) {
+
+      ret=rp->solve(x,fc);
+
+    } else {
+
+      double err;
+      x=session_extrap(hp.size(),hp,hx,order,p,err);
+
+      root_bkt<funct> *rbp=dynamic_cast<root_bkt<funct> *>(rp);
+      bool bracketed=false;
+      double x1=x, x2=x;
+
+      if (rbp!=0) {
+	// The initial bracket width
+	double width=bracket_fac*err;
+	double wmin=fabs(x)*sqrt(rp->tol_rel);
+	if (wmin<rp->tol_abs) wmin=rp->tol_abs;
+	if (width<wmin) width=wmin;
+
+	for(size_t i=0;i<=n_expand && !bracketed;i++) {
+	  x1=x-width;
+	  x2=x+width;
+	  double f1=fc(x1);
+	  double f2=fc(x2);
+	  if (std::isfinite(f1) && std::isfinite(f2) && f1*f2<=0.0) {
+	    bracketed=true;
+	    // Keep the endpoint values so that the solver does not
+	    // evaluate the function there again
+	    cache_x[0]=x1;
+	    cache_y[0]=f1;
+	    cache_x[1]=x2;
+	    cache_y[1]=f2;
+	  }
+	  width*=4.0;
+	}
+      }
+
+      if (bracketed) {
+	n_warm++;
+	n_cache=2;
+	ret=rp->solve_bkt(x1,x2,fc);
+	n_cache=0;
+	x=x1;
+      } else {
+	ret=rp->solve(x,fc);
+      }
+    }
+
+    size_t evals=n_evals-evals_start;
+
+    if (ret==0) {
+      if (warm) {
+	if (n_cold>0) {
+	  n_saved+=((double)n_evals_cold)/((double)n_cold)-
+	    ((double)evals);
+	}
+      } else {
+	n_cold++;
+	n_evals_cold+=evals;
+      }
+
+      // Store the solution
+      if (hp.size()>=n_hist && hp.size()>0) {
+	hp.erase(hp.begin());
+	hx.erase(hx.begin());
+      }
+      hp.push_back(p);
+      hx.push_back(x);
+    }
+
+    return ret;
+  }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+  /// The solver
+  root<funct> *rp;
+
+  /// The previous parameter values
+  std::vector<double> hp;
+
+  /// The previous solutions
+  std::vector<double> hx;
+
+  /// The number of solves without a history
+  size_t n_cold;
+
+  /// The number of function evaluations in solves without a history
+  size_t n_evals_cold;
+
+  /// \name Function values at the endpoints of the bracket
+  //@{
+  double cache_x[2];
+  double cache_y[2];
+  size_t n_cache;
+  //@}
+
+  /** \brief Function wrapper which counts evaluations
+
+      If \c x is one of the first \ref n_cache points in \ref
+      cache_x, the stored value is returned instead.
+  */
+  double count_func(double x, func_t &func) {
+    for(size_t k=0;k<n_cache;k++) {
+      if (x==cache_x[k]) return cache_y[k];
+    }
+    n_evals++;
+    return func(x);
+  }
+
+#endif
+
+  };
+
+  /** \brief A multi-dimensional solver session for sequences of
+      closely-related problems
+
+      This class is the multi-dimensional analog of \ref
+      root_session. For each call to \ref msolve(), the initial guess
+      for each variable is obtained by polynomial extrapolation of
+      the previous solutions as a function of the parameter \f$ p
+      \f$. The default solver is \ref mroot_hybrids with \ref
+      mroot_hybrids::reuse_jac set to true, so the final Broyden
+      approximation to the Jacobian from one solve is used to begin
+      the next one. The counters are computed as in \ref
+      root_session.
+  */
+  template<class vec_t=boost::numeric::ublas::vector<double> >
+    class mroot_session {
+
+  public:
+
+  /// The function type
+  typedef std::function<int(size_t,const vec_t &,vec_t &)> func_t;
+
+  mroot_session() {
+    def_mroot.reuse_jac=true;
+    mrp=&def_mroot;
+    order=2;
+    n_hist=4;
+    clear();
+  }
+
+  virtual ~mroot_session() {}
+
+  /// \name Settings
+  //@{
+  /** \brief Maximum order of polynomial extrapolation (default 2,
+      maximum 3)
+  */
+  size_t order;
+
+  /// Number of previous solutions to store (default 4)
+  size_t n_hist;
+  //@}
+
+  /// \name Counters
+  //@{
+  /// The number of calls to \ref msolve()
+  size_t n_solves;
+
+  /// The total number of function evaluations
+  size_t n_evals;
+
+  /** \brief The estimated number of function evaluations saved
+      by the session
+  */
+  double n_saved;
+  //@}
+
+  /// The default solver
+  mroot_hybrids<func_t,vec_t> def_mroot;
+
+  /// Set the solver to use
+  void set_mroot(mroot<func_t,vec_t> &mr) {
+    mrp=&mr;
+    return;
+  }
+
+  /// Forget the previous solutions and reset the counters
+  void clear() {
+    hp.clear();
+    hx.clear();
+    n_solves=0;
+    n_evals=0;
+    n_saved=0.0;
+    n_cold=0;
+    n_evals_cold=0;
+    return;
+  }
+
+  /** \brief Solve \c func in \c n variables for the parameter value
+      \c p
+
+      If there are no previous solutions (or the number of variables
+      has changed), \c x is used as the initial guess. Upon return
+      \c x contains the solution.
+  */
+  virtual int msolve(double p, size_t n, vec_t &x, func_t &func) {
+
+    func_t fc=std::bind
+      (std::mem_fn<int(size_t,const vec_t &,vec_t &,func_t &)>
+       (&mroot_session<vec_t>::count_func),this,std::placeholders::_1,
+       std::placeholders::_2,std::placeholders::_3,std::ref(func));
+
+    if (hx.size()>0 && hx[0].size()!=n) {
+      hp.clear();
+      hx.clear();
+    }
+
+    size_t evals_start=n_evals;
+    n_solves++;
+    bool warm=(hp.size()>0);
+
+    if (warm) {
+      std::vector<double> yk(hp.size());
+      for(size_t i=0;i<n;i++) {
+	for(size_t k=0;k<hp.size();k++) yk[k]=hx[k][i];
+	double err;
+	x[i]=session_extrap(hp.size(),hp,yk,order,p,err);
+      }
+    }
+
+    int ret=mrp->msolve(n,x,fc);
+
+    size_t evals=n_evals-evals_start;
+
+    if (ret==0) {
+      if (warm) {
+	if (n_cold>0) {
+	  n_saved+=((double)n_evals_cold)/((double)n_cold)-
+	    ((double)evals);
+	}
+      } else {
+	n_cold++;
+	n_evals_cold+=evals;
+      }
+
+      // Store the solution
+      if (hp.size()>=n_hist && hp.size()>0) {
+	hp.erase(hp.begin());
+	hx.erase(hx.begin());
+      }
+      hp.push_back(p);
+      std::vector<double> xs(n);
+      for(size_t i=0;i<n;i++) xs[i]=x[i];
+      hx.push_back(xs);
+    }
+
+    return ret;
+  }
+
+#ifndef DOXYGEN_INTERNAL
+
+  protected:
+
+  /// The solver
+  mroot<func_t,vec_t> *mrp;
+
+  /// The previous parameter values
+  std::vector<double> hp;
+
+  /// The previous solutions
+  std::vector<std::vector<double> > hx;
+
+  /// The number of solves without a history
+  size_t n_cold;
+
+  /// The number of function evaluations in solves without a history
+  size_t n_evals_cold;
+
+  /// Function wrapper which counts evaluations
+  int count_func(size_t n, const vec_t &x, vec_t &y, func_t &func) {
+    n_evals++;
+    return func(n,x,y);
+  }
+
+#endif
+
+  };
+
+#ifndef DOXYGEN_NO_O2NS
+}
+#endif
+
+#endif
@@ -0,0 +1,125 @@
+/*
+  -------------------------------------------------------------------
+
+  Copyright (C) 2017, Andrew W. Steiner
+
+  This file is part of O2scl.
+
+  O2scl is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 3 of the License, or
+  (at your option) any later version.
+
+  O2scl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with O2scl. If not, see <http://www.gnu.org/licenses/>.
+
+  -------------------------------------------------------------------
+*/
+#include <cmath>
+
+#include <o2scl/test_mgr.h>
+#include <o2scl/root_session.h>
+#include <o2scl/root_cern.h>
+
+using namespace std;
+using namespace o2scl;
+
+typedef boost::numeric::ublas::vector<double> ubvector;
+
+// The number of calls to cube()
+size_t n_cube=0;
+
+double cube(double x, double p) {
+  n_cube++;
+  return x*x*x-p;
+}
+
+int mfn(size_t nv, const ubvector &x, ubvector &y, double p) {
+  y[0]=sin(x[1]-0.2*p);
+  y[1]=sin(x[0]-0.25*p)+x[1]*x[1]-0.04*p*p;
+  return 0;
+}
+
+int main(void) {
+  test_mgr t;
+  t.set_output_level(1);
+
+  cout.setf(ios::scientific);
+
+  // One-dimensional session with the default bracketing solver
+  {
+    root_session<> rs;
+    double x=2.0;
+    n_cube=0;
+    for(double p=1.0;p<3.0+1.0e-8;p+=0.02) {
+      funct f=std::bind(cube,std::placeholders::_1,p);
+      rs.solve(p,x,f);
+      t.test_rel(x,cbrt(p),1.0e-8,"root_session brent");
+    }
+    cout << rs.n_solves << " " << rs.n_evals << " " << rs.n_warm << " "
+	 << rs.n_saved << endl;
+    t.test_gen(rs.n_evals==n_cube,"evaluations counted");
+    t.test_gen(rs.n_warm+2>=rs.n_solves,"warm starts");
+    t.test_gen(rs.n_saved>0.0,"evaluations saved");
+  }
+
+  // One-dimensional session with a non-bracketing solver
+  {
+    root_session<> rs;
+    root_cern<> rc;
+    rs.set_root(rc);
+    double x=2.0;
+    for(double p=1.0;p<3.0+1.0e-8;p+=0.02) {
+      funct f=std::bind(cube,std::placeholders::_1,p);
+      rs.solve(p,x,f);
+      t.test_rel(x,cbrt(p),1.0e-6,"root_session cern");
+    }
+    cout << rs.n_solves << " " << rs.n_evals << " " << rs.n_warm << " "
+	 << rs.n_saved << endl;
+    t.test_gen(rs.n_warm==0,"no warm brackets");
+  }
+
+  // Multi-dimensional session compared with cold solves
+  {
+    mroot_session<> ms;
+    mroot_hybrids<> mh;
+    ubvector x(2), x2(2);
+    x[0]=0.5;
+    x[1]=0.5;
+    size_t cold_evals=0;
+    for(double p=1.0;p<2.0+1.0e-8;p+=0.01) {
+      mm_funct f=std::bind(mfn,std::placeholders::_1,
+			   std::placeholders::_2,std::placeholders::_3,p);
+      ms.msolve(p,2,x,f);
+
+      // Count the evaluations for a cold start from the same point
+      size_t cnt=0;
+      mm_funct fc=std::bind(mfn,std::placeholders::_1,
+			    std::placeholders::_2,std::placeholders::_3,p);
+      mm_funct fcnt=[&cnt,&fc](size_t nv, const ubvector &xx,
+			       ubvector &yy) {
+	cnt++;
+	return fc(nv,xx,yy);
+      };
+      x2[0]=0.5;
+      x2[1]=0.5;
+      mh.msolve(2,x2,fcnt);
+      cold_evals+=cnt;
+
+      t.test_rel(x[0],x2[0],1.0e-6,"mroot_session x0");
+      t.test_rel(x[1],x2[1],1.0e-6,"mroot_session x1");
+    }
+    cout << ms.n_solves << " " << ms.n_evals << " " << cold_evals << " "
+	 << ms.n_saved << " " << ms.def_mroot.n_jac_reused << endl;
+    t.test_gen(ms.n_evals<cold_evals,"fewer evaluations");
+    t.test_gen(ms.def_mroot.n_jac_reused+1==ms.n_solves,"jacobian reuse");
+  }
+
+  t.report();
+  return 0;
+}